@@ -490,7 +490,8 @@ Matrix::scale(const V3d *scale, CombineOp op)
 	scl.right.x = scale->x;
 	scl.up.y = scale->y;
 	scl.at.z = scale->z;
-	scl.flags &= ~IDENTITY;
+	// no longer normal, invert must not just transpose
+	scl.flags &= ~(IDENTITY | TYPENORMAL);
 	switch(op){
 	case COMBINEREPLACE:
 		*this = scl;
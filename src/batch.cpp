@@ -0,0 +1,392 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+
+#define PLUGIN_ID ID_STATICBATCH
+
+/*
+ * Static batching.
+ *
+ * The triangles of many atomics are transformed into world space
+ * and regrouped into pieces, one per source atomic and material.
+ * Pieces that are compatible (same pipeline and vertex layout) are
+ * sorted by material and packed into as few geometries as the vertex
+ * limit allows, so every merged geometry has one mesh per material.
+ * Equivalent materials from different atomics are shared.
+ * A remap per merged triangle leads back to the source atomic's
+ * triangle for picking.
+ */
+
+namespace rw {
+
+// Same pointer or same properties and plugin data
+static bool32
+sameMaterial(Material *a, Material *b)
+{
+	if(a == b)
+		return 1;
+	if(a->texture != b->texture || a->pipeline != b->pipeline ||
+	   !equal(a->color, b->color) ||
+	   a->surfaceProps.ambient != b->surfaceProps.ambient ||
+	   a->surfaceProps.specular != b->surfaceProps.specular ||
+	   a->surfaceProps.diffuse != b->surfaceProps.diffuse)
+		return 0;
+	int32 plgSize = Material::s_plglist.size - sizeof(Material);
+	return memcmp(a+1, b+1, plgSize) == 0;
+}
+
+enum {
+	// geometry flags that have to match to merge
+	LAYOUTFLAGS = Geometry::TEXTURED | Geometry::TEXTURED2 | Geometry::PRELIT |
+	              Geometry::NORMALS | Geometry::LIGHT | Geometry::MODULATE
+};
+
+struct BatchPiece
+{
+	int32 source;
+	int32 matIndex;	// into the unique materials
+	ObjPipeline *pipeline;
+	uint32 layout;	// LAYOUTFLAGS and number of tex coord sets
+	int32 numVertices;
+	int32 numTriangles;
+};
+
+static int
+comparePieces(const void *a, const void *b)
+{
+	const BatchPiece *pa = (const BatchPiece*)a;
+	const BatchPiece *pb = (const BatchPiece*)b;
+	if(pa->pipeline != pb->pipeline)
+		return pa->pipeline < pb->pipeline ? -1 : 1;
+	if(pa->layout != pb->layout)
+		return pa->layout < pb->layout ? -1 : 1;
+	if(pa->matIndex != pb->matIndex)
+		return pa->matIndex - pb->matIndex;
+	return pa->source - pb->source;
+}
+
+static bool32
+samePieceGroup(BatchPiece *a, BatchPiece *b)
+{
+	return a->pipeline == b->pipeline && a->layout == b->layout;
+}
+
+// Transform all vertex data of a piece into dst starting at vertex v
+static void
+appendPiece(Geometry *dst, int32 v, int32 t, int32 matId, Atomic *atomic,
+	int32 localMat, int32 *vertMap, StaticBatch::Remap *remap, int32 source)
+{
+	Geometry *src = atomic->geometry;
+	Matrix *ltm = atomic->getFrame()->getLTM();
+	Matrix inv;
+	Matrix::invert(&inv, ltm);
+	float32 det = dot(cross(ltm->right, ltm->up), ltm->at);
+	MorphTarget *smt = &src->morphTargets[0];
+	MorphTarget *dmt = &dst->morphTargets[0];
+	int32 i, j;
+
+	for(i = 0; i < src->numVertices; i++)
+		vertMap[i] = -1;
+	for(i = 0; i < src->numTriangles; i++){
+		if(src->getTriMatId(i) != localMat)
+			continue;
+		uint32 idx[3];
+		for(j = 0; j < 3; j++){
+			uint32 sv = src->getTriVertex(i, j);
+			if(vertMap[sv] < 0){
+				vertMap[sv] = v;
+				V3d::transformPoints(&dmt->vertices[v], &smt->vertices[sv], 1, ltm);
+				if(dst->flags & Geometry::NORMALS){
+					// inverse transpose for non-uniform scale
+					V3d n = smt->normals[sv];
+					V3d tn = makeV3d(dot(inv.right, n), dot(inv.up, n), dot(inv.at, n));
+					float32 len = length(tn);
+					dmt->normals[v] = len > 0.0f ? scale(tn, 1.0f/len) : tn;
+				}
+				if(dst->flags & Geometry::PRELIT)
+					dst->colors[v] = src->colors[sv];
+				for(int32 k = 0; k < dst->numTexCoordSets; k++)
+					dst->texCoords[k][v] = src->texCoords[k][sv];
+				v++;
+			}
+			idx[j] = vertMap[sv];
+		}
+		// mirroring transform flips the winding
+		if(det < 0.0f)
+			dst->setTriangle(t, idx[0], idx[2], idx[1], matId);
+		else
+			dst->setTriangle(t, idx[0], idx[1], idx[2], matId);
+		remap[t].source = source;
+		remap[t].triangle = i;
+		t++;
+	}
+}
+
+StaticBatch*
+StaticBatch::create(Atomic **atomics, int32 numAtomics, int32 maxVertices)
+{
+	int32 i, j;
+
+	// unique materials and the map from every atomic's materials
+	int32 *matMapStart = rwNewT(int32, numAtomics+1, MEMDUR_FUNCTION | ID_STATICBATCH);
+	int32 totalMats = 0;
+	int32 maxVerts = 0;
+	for(i = 0; i < numAtomics; i++){
+		Geometry *geo = atomics[i]->geometry;
+		assert(!(geo->flags & Geometry::NATIVE));
+		matMapStart[i] = totalMats;
+		totalMats += geo->matList.numMaterials;
+		if(geo->numVertices > maxVerts)
+			maxVerts = geo->numVertices;
+	}
+	matMapStart[numAtomics] = totalMats;
+	int32 *matMap = rwNewT(int32, totalMats, MEMDUR_FUNCTION | ID_STATICBATCH);
+	Material **mats = rwNewT(Material*, totalMats, MEMDUR_FUNCTION | ID_STATICBATCH);
+	int32 numMats = 0;
+	for(i = 0; i < numAtomics; i++){
+		MaterialList *ml = &atomics[i]->geometry->matList;
+		for(j = 0; j < ml->numMaterials; j++){
+			int32 k;
+			for(k = 0; k < numMats; k++)
+				if(sameMaterial(mats[k], ml->materials[j]))
+					break;
+			if(k == numMats)
+				mats[numMats++] = ml->materials[j];
+			matMap[matMapStart[i]+j] = k;
+		}
+	}
+
+	// one piece per used material of every atomic
+	BatchPiece *pieces = rwNewT(BatchPiece, totalMats, MEMDUR_FUNCTION | ID_STATICBATCH);
+	int32 *vertMap = rwNewT(int32, maxVerts, MEMDUR_FUNCTION | ID_STATICBATCH);
+	int32 numPieces = 0;
+	for(i = 0; i < numAtomics; i++){
+		Geometry *geo = atomics[i]->geometry;
+		for(j = 0; j < geo->matList.numMaterials; j++){
+			BatchPiece *p = &pieces[numPieces];
+			p->source = i;
+			p->matIndex = matMap[matMapStart[i]+j];
+			p->pipeline = atomics[i]->pipeline;
+			p->layout = (geo->flags & LAYOUTFLAGS) | geo->numTexCoordSets<<16;
+			p->numVertices = 0;
+			p->numTriangles = 0;
+			int32 k;
+			for(k = 0; k < geo->numVertices; k++)
+				vertMap[k] = 0;
+			for(k = 0; k < geo->numTriangles; k++){
+				if(geo->getTriMatId(k) != j)
+					continue;
+				p->numTriangles++;
+				for(int32 l = 0; l < 3; l++){
+					uint32 v = geo->getTriVertex(k, l);
+					p->numVertices += !vertMap[v];
+					vertMap[v] = 1;
+				}
+			}
+			if(p->numTriangles)
+				numPieces++;
+		}
+	}
+	qsort(pieces, numPieces, sizeof(BatchPiece), comparePieces);
+
+	// pack pieces into geometries
+	StaticBatch *batch = rwNewT(StaticBatch, 1, MEMDUR_EVENT | ID_STATICBATCH);
+	batch->numSources = numAtomics;
+	batch->clump = Clump::create();
+	batch->clump->setFrame(Frame::create());
+	int32 numGeos = 0;
+	for(i = 0; i < numPieces; i = j){
+		int32 nv = pieces[i].numVertices;
+		for(j = i+1; j < numPieces; j++){
+			if(!samePieceGroup(&pieces[i], &pieces[j]) ||
+			   nv + pieces[j].numVertices > maxVertices)
+				break;
+			nv += pieces[j].numVertices;
+		}
+		numGeos++;
+	}
+	batch->numAtomics = numGeos;
+	batch->atomics = rwNewT(Atomic*, numGeos, MEMDUR_EVENT | ID_STATICBATCH);
+	batch->remaps = rwNewT(Remap*, numGeos, MEMDUR_EVENT | ID_STATICBATCH);
+
+	int32 *localMatIds = rwNewT(int32, numMats, MEMDUR_FUNCTION | ID_STATICBATCH);
+	int32 g = 0;
+	for(i = 0; i < numPieces; i = j){
+		int32 nv = pieces[i].numVertices;
+		int32 nt = pieces[i].numTriangles;
+		for(j = i+1; j < numPieces; j++){
+			if(!samePieceGroup(&pieces[i], &pieces[j]) ||
+			   nv + pieces[j].numVertices > maxVertices)
+				break;
+			nv += pieces[j].numVertices;
+			nt += pieces[j].numTriangles;
+		}
+
+		uint32 layout = pieces[i].layout;
+		Geometry *geo = Geometry::create(nv, nt,
+			Geometry::POSITIONS | (layout & LAYOUTFLAGS) | (layout & 0xFF0000));
+		Remap *remap = rwNewT(Remap, nt, MEMDUR_EVENT | ID_STATICBATCH);
+		int32 k;
+		for(k = 0; k < numMats; k++)
+			localMatIds[k] = -1;
+		int32 v = 0, t = 0;
+		for(k = i; k < j; k++){
+			BatchPiece *p = &pieces[k];
+			if(localMatIds[p->matIndex] < 0)
+				localMatIds[p->matIndex] = geo->matList.appendMaterial(mats[p->matIndex]);
+			Atomic *src = atomics[p->source];
+			int32 localMat;
+			for(localMat = 0; localMat < src->geometry->matList.numMaterials; localMat++)
+				if(matMap[matMapStart[p->source]+localMat] == p->matIndex)
+					break;
+			appendPiece(geo, v, t, localMatIds[p->matIndex], src, localMat,
+			            vertMap, remap, p->source);
+			v += p->numVertices;
+			t += p->numTriangles;
+		}
+		geo->calculateBoundingSphere();
+		geo->buildMeshes();
+
+		Atomic *a = Atomic::create();
+		a->setFrame(batch->clump->getFrame());
+		a->setGeometry(geo, 0);
+		a->pipeline = pieces[i].pipeline;
+		geo->destroy();
+		batch->clump->addAtomic(a);
+		batch->atomics[g] = a;
+		batch->remaps[g] = remap;
+		g++;
+	}
+
+	rwFree(localMatIds);
+	rwFree(vertMap);
+	rwFree(pieces);
+	rwFree(mats);
+	rwFree(matMap);
+	rwFree(matMapStart);
+	return batch;
+}
+
+void
+StaticBatch::destroy(void)
+{
+	for(int32 i = 0; i < this->numAtomics; i++)
+		rwFree(this->remaps[i]);
+	rwFree(this->remaps);
+	rwFree(this->atomics);
+	this->clump->destroy();
+	rwFree(this);
+}
+
+bool32
+StaticBatch::getSource(Atomic *atomic, int32 triangle, int32 *source, int32 *sourceTriangle)
+{
+	for(int32 i = 0; i < this->numAtomics; i++)
+		if(this->atomics[i] == atomic){
+			if(triangle < 0 || triangle >= atomic->geometry->numTriangles)
+				return 0;
+			*source = this->remaps[i][triangle].source;
+			*sourceTriangle = this->remaps[i][triangle].triangle;
+			return 1;
+		}
+	return 0;
+}
+
+StaticBatch*
+StaticBatch::streamRead(Stream *stream)
+{
+	if(!findChunk(stream, ID_STRUCT, nil, nil)){
+		RWERROR((ERR_CHUNK, "STRUCT"));
+		return nil;
+	}
+	int32 numSources = stream->readI32();
+	int32 numAtomics = stream->readI32();
+	if(numAtomics < 0){
+		RWERROR((ERR_CHUNK, "STRUCT"));
+		return nil;
+	}
+	Remap **remaps = rwNewT(Remap*, numAtomics, MEMDUR_EVENT | ID_STATICBATCH);
+	int32 *numTris = rwNewT(int32, numAtomics, MEMDUR_FUNCTION | ID_STATICBATCH);
+	memset(remaps, 0, numAtomics*sizeof(Remap*));
+	bool32 ok = 1;
+	int32 i;
+	for(i = 0; i < numAtomics; i++){
+		int32 nt = stream->readI32();
+		if(nt < 0){
+			ok = 0;
+			break;
+		}
+		numTris[i] = nt;
+		remaps[i] = rwNewT(Remap, nt, MEMDUR_EVENT | ID_STATICBATCH);
+		stream->read32(remaps[i], nt*sizeof(Remap));
+	}
+	Clump *clump = nil;
+	if(ok && findChunk(stream, ID_CLUMP, nil, nil))
+		clump = Clump::streamRead(stream);
+	if(clump && clump->countAtomics() == numAtomics){
+		// every remap has to cover its geometry's triangles exactly
+		i = 0;
+		FORLIST(lnk, clump->atomics)
+			if(Atomic::fromClump(lnk)->geometry->numTriangles != numTris[i++])
+				ok = 0;
+	}else
+		ok = 0;
+	rwFree(numTris);
+	if(!ok){
+		RWERROR((ERR_CHUNK, "CLUMP"));
+		if(clump)
+			clump->destroy();
+		for(i = 0; i < numAtomics; i++)
+			rwFree(remaps[i]);
+		rwFree(remaps);
+		return nil;
+	}
+	StaticBatch *batch = rwNewT(StaticBatch, 1, MEMDUR_EVENT | ID_STATICBATCH);
+	batch->clump = clump;
+	batch->numSources = numSources;
+	batch->numAtomics = numAtomics;
+	batch->remaps = remaps;
+	batch->atomics = rwNewT(Atomic*, numAtomics, MEMDUR_EVENT | ID_STATICBATCH);
+	i = 0;
+	FORLIST(lnk, clump->atomics)
+		batch->atomics[i++] = Atomic::fromClump(lnk);
+	return batch;
+}
+
+bool
+StaticBatch::streamWrite(Stream *stream)
+{
+	int32 i;
+	writeChunkHeader(stream, ID_STATICBATCH, this->streamGetSize());
+	uint32 size = 8;
+	for(i = 0; i < this->numAtomics; i++)
+		size += 4 + this->atomics[i]->geometry->numTriangles*sizeof(Remap);
+	writeChunkHeader(stream, ID_STRUCT, size);
+	stream->writeI32(this->numSources);
+	stream->writeI32(this->numAtomics);
+	for(i = 0; i < this->numAtomics; i++){
+		int32 nt = this->atomics[i]->geometry->numTriangles;
+		stream->writeI32(nt);
+		stream->write32(this->remaps[i], nt*sizeof(Remap));
+	}
+	return this->clump->streamWrite(stream);
+}
+
+uint32
+StaticBatch::streamGetSize(void)
+{
+	uint32 size = 12 + 8;
+	for(int32 i = 0; i < this->numAtomics; i++)
+		size += 4 + this->atomics[i]->geometry->numTriangles*sizeof(Remap);
+	return size + 12 + this->clump->streamGetSize();
+}
+
+}
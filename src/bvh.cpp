@@ -0,0 +1,722 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <float.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+
+#define PLUGIN_ID ID_WORLD
+
+/*
+ * Dynamic bounding volume hierarchy.
+ *
+ * Leaves store fattened boxes so objects can move a little
+ * without touching the tree. When a box leaves its fat box
+ * the leaf is reinserted next to the sibling that increases
+ * the surface area the least and the ancestors are refitted
+ * and rotated to keep the SAH cost low (like Box2D's tree).
+ * build() rebuilds all internal nodes with a binned SAH split,
+ * which gives a better tree after many objects were added at once.
+ */
+
+namespace rw {
+
+enum { NULLNODE = -1 };
+
+static float32
+halfArea(const BBox *b)
+{
+	V3d d = sub(b->sup, b->inf);
+	return d.x*d.y + d.y*d.z + d.z*d.x;
+}
+
+static void
+merge(BBox *dst, const BBox *a, const BBox *b)
+{
+	dst->inf.x = a->inf.x < b->inf.x ? a->inf.x : b->inf.x;
+	dst->inf.y = a->inf.y < b->inf.y ? a->inf.y : b->inf.y;
+	dst->inf.z = a->inf.z < b->inf.z ? a->inf.z : b->inf.z;
+	dst->sup.x = a->sup.x > b->sup.x ? a->sup.x : b->sup.x;
+	dst->sup.y = a->sup.y > b->sup.y ? a->sup.y : b->sup.y;
+	dst->sup.z = a->sup.z > b->sup.z ? a->sup.z : b->sup.z;
+}
+
+static float32
+mergedArea(const BBox *a, const BBox *b)
+{
+	BBox m;
+	merge(&m, a, b);
+	return halfArea(&m);
+}
+
+static bool32
+contains(const BBox *outer, const BBox *inner)
+{
+	return inner->inf.x >= outer->inf.x && inner->inf.y >= outer->inf.y && inner->inf.z >= outer->inf.z &&
+	       inner->sup.x <= outer->sup.x && inner->sup.y <= outer->sup.y && inner->sup.z <= outer->sup.z;
+}
+
+void
+DynamicBVH::init(void)
+{
+	this->nodes = nil;
+	this->numNodes = 0;
+	this->maxNodes = 0;
+	this->root = NULLNODE;
+	this->freeList = NULLNODE;
+	this->numLeaves = 0;
+}
+
+void
+DynamicBVH::deinit(void)
+{
+	rwFree(this->nodes);
+	this->init();
+}
+
+int32
+DynamicBVH::allocNode(void)
+{
+	if(this->freeList == NULLNODE){
+		int32 n = this->maxNodes ? this->maxNodes*2 : 64;
+		this->nodes = rwResizeT(BVHNode, this->nodes, n, MEMDUR_EVENT | ID_WORLD);
+		for(int32 i = this->maxNodes; i < n; i++){
+			this->nodes[i].parent = i+1 < n ? i+1 : NULLNODE;
+			this->nodes[i].height = -1;
+		}
+		this->freeList = this->maxNodes;
+		this->maxNodes = n;
+	}
+	int32 i = this->freeList;
+	BVHNode *node = &this->nodes[i];
+	this->freeList = node->parent;
+	node->parent = NULLNODE;
+	node->child[0] = node->child[1] = NULLNODE;
+	node->height = 0;
+	node->object = nil;
+	this->numNodes++;
+	return i;
+}
+
+void
+DynamicBVH::freeNode(int32 i)
+{
+	this->nodes[i].parent = this->freeList;
+	this->nodes[i].height = -1;
+	this->freeList = i;
+	this->numNodes--;
+}
+
+// Swap a child of A with a grandchild on the other side
+// if that makes the other child's box smaller
+void
+DynamicBVH::rotate(int32 a)
+{
+	BVHNode *na = &this->nodes[a];
+	int32 b = na->child[0];
+	int32 c = na->child[1];
+	BVHNode *nb = &this->nodes[b];
+	BVHNode *nc = &this->nodes[c];
+	if(nb->height < 1 && nc->height < 1)
+		return;
+
+	// candidates: swap B with C's children or C with B's children
+	float32 bestDiff = 0.0f;
+	int32 swapOut = NULLNODE, swapIn = NULLNODE, inner = NULLNODE;
+	float32 areaB = halfArea(&nb->box);
+	float32 areaC = halfArea(&nc->box);
+	for(int32 i = 0; i < 2; i++){
+		if(nc->height > 0){
+			int32 f = nc->child[i];
+			int32 g = nc->child[1-i];
+			float32 diff = mergedArea(&nb->box, &this->nodes[g].box) - areaC;
+			if(diff < bestDiff){
+				bestDiff = diff;
+				swapOut = b; swapIn = f; inner = c;
+			}
+		}
+		if(nb->height > 0){
+			int32 d = nb->child[i];
+			int32 e = nb->child[1-i];
+			float32 diff = mergedArea(&nc->box, &this->nodes[e].box) - areaB;
+			if(diff < bestDiff){
+				bestDiff = diff;
+				swapOut = c; swapIn = d; inner = b;
+			}
+		}
+	}
+	if(swapOut == NULLNODE)
+		return;
+
+	// swapOut is a child of a, swapIn a child of inner
+	BVHNode *ni = &this->nodes[inner];
+	int32 ai = na->child[0] == swapOut ? 0 : 1;
+	int32 ii = ni->child[0] == swapIn ? 0 : 1;
+	na->child[ai] = swapIn;
+	ni->child[ii] = swapOut;
+	this->nodes[swapIn].parent = a;
+	this->nodes[swapOut].parent = inner;
+	BVHNode *n0 = &this->nodes[ni->child[0]];
+	BVHNode *n1 = &this->nodes[ni->child[1]];
+	merge(&ni->box, &n0->box, &n1->box);
+	ni->height = 1 + (n0->height > n1->height ? n0->height : n1->height);
+}
+
+// Refit and rotate all ancestors starting at i
+void
+DynamicBVH::refit(int32 i)
+{
+	while(i != NULLNODE){
+		BVHNode *node = &this->nodes[i];
+		this->rotate(i);
+		BVHNode *n0 = &this->nodes[node->child[0]];
+		BVHNode *n1 = &this->nodes[node->child[1]];
+		merge(&node->box, &n0->box, &n1->box);
+		node->height = 1 + (n0->height > n1->height ? n0->height : n1->height);
+		i = node->parent;
+	}
+}
+
+void
+DynamicBVH::insertLeaf(int32 leaf)
+{
+	if(this->root == NULLNODE){
+		this->root = leaf;
+		this->nodes[leaf].parent = NULLNODE;
+		return;
+	}
+
+	// descend to the sibling with the lowest cost,
+	// copy the box because allocNode may move the nodes
+	BBox leafBox = this->nodes[leaf].box;
+	BBox *box = &leafBox;
+	int32 i = this->root;
+	while(this->nodes[i].height > 0){
+		BVHNode *node = &this->nodes[i];
+		float32 area = halfArea(&node->box);
+		float32 combined = mergedArea(&node->box, box);
+		// new parent here
+		float32 cost = 2.0f*combined;
+		// pushing the leaf down enlarges this node
+		float32 inherited = 2.0f*(combined - area);
+		float32 childCost[2];
+		for(int32 j = 0; j < 2; j++){
+			BVHNode *c = &this->nodes[node->child[j]];
+			childCost[j] = mergedArea(&c->box, box) + inherited;
+			if(c->height > 0)
+				childCost[j] -= halfArea(&c->box);
+		}
+		if(cost < childCost[0] && cost < childCost[1])
+			break;
+		i = node->child[childCost[0] < childCost[1] ? 0 : 1];
+	}
+
+	int32 sibling = i;
+	int32 oldParent = this->nodes[sibling].parent;
+	int32 parent = this->allocNode();
+	BVHNode *np = &this->nodes[parent];
+	np->parent = oldParent;
+	merge(&np->box, box, &this->nodes[sibling].box);
+	np->height = this->nodes[sibling].height + 1;
+	np->child[0] = sibling;
+	np->child[1] = leaf;
+	this->nodes[sibling].parent = parent;
+	this->nodes[leaf].parent = parent;
+	if(oldParent == NULLNODE)
+		this->root = parent;
+	else{
+		BVHNode *op = &this->nodes[oldParent];
+		op->child[op->child[0] == sibling ? 0 : 1] = parent;
+	}
+	this->refit(oldParent);
+}
+
+void
+DynamicBVH::removeLeaf(int32 leaf)
+{
+	if(leaf == this->root){
+		this->root = NULLNODE;
+		return;
+	}
+	int32 parent = this->nodes[leaf].parent;
+	BVHNode *np = &this->nodes[parent];
+	int32 sibling = np->child[np->child[0] == leaf ? 1 : 0];
+	int32 grandParent = np->parent;
+	if(grandParent == NULLNODE){
+		this->root = sibling;
+		this->nodes[sibling].parent = NULLNODE;
+	}else{
+		BVHNode *ng = &this->nodes[grandParent];
+		ng->child[ng->child[0] == parent ? 0 : 1] = sibling;
+		this->nodes[sibling].parent = grandParent;
+	}
+	this->freeNode(parent);
+	this->refit(grandParent);
+}
+
+static void
+fatten(BBox *dst, const BBox *box)
+{
+	V3d margin = scale(sub(box->sup, box->inf), 0.1f);
+	margin = add(margin, makeV3d(0.01f, 0.01f, 0.01f));
+	dst->inf = sub(box->inf, margin);
+	dst->sup = add(box->sup, margin);
+}
+
+int32
+DynamicBVH::insert(const BBox *box, void *object)
+{
+	int32 leaf = this->allocNode();
+	fatten(&this->nodes[leaf].box, box);
+	this->nodes[leaf].object = object;
+	this->insertLeaf(leaf);
+	this->numLeaves++;
+	return leaf;
+}
+
+void
+DynamicBVH::remove(int32 leaf)
+{
+	this->removeLeaf(leaf);
+	this->freeNode(leaf);
+	this->numLeaves--;
+}
+
+bool32
+DynamicBVH::move(int32 leaf, const BBox *box)
+{
+	BVHNode *node = &this->nodes[leaf];
+	if(contains(&node->box, box)){
+		// shrink the fat box again if the object got much smaller
+		BBox fat;
+		fatten(&fat, box);
+		if(halfArea(&node->box) <= 4.0f*halfArea(&fat))
+			return 0;
+	}
+	this->removeLeaf(leaf);
+	fatten(&node->box, box);
+	this->insertLeaf(leaf);
+	return 1;
+}
+
+//
+// SAH build
+//
+
+enum { NUMBINS = 12 };
+
+static float32
+centroid(const BBox *b, int32 axis)
+{
+	return ((&b->inf.x)[axis] + (&b->sup.x)[axis])*0.5f;
+}
+
+// Build a subtree over leaves[0..n) and return its root
+int32
+DynamicBVH::buildRecursive(int32 *leaves, int32 n)
+{
+	int32 i;
+	if(n == 1)
+		return leaves[0];
+
+	// split the longest axis of the centroid bounds
+	BBox cb;
+	for(i = 0; i < n; i++){
+		BBox *b = &this->nodes[leaves[i]].box;
+		V3d c = scale(add(b->inf, b->sup), 0.5f);
+		if(i == 0)
+			cb.initialize(&c);
+		else
+			cb.addPoint(&c);
+	}
+	V3d ext = sub(cb.sup, cb.inf);
+	int32 axis = ext.x > ext.y ? (ext.x > ext.z ? 0 : 2) : (ext.y > ext.z ? 1 : 2);
+	float32 lo = (&cb.inf.x)[axis];
+	float32 width = (&ext.x)[axis];
+
+	int32 mid = n/2;
+	if(width > 0.0f){
+		BBox binBox[NUMBINS];
+		int32 binCount[NUMBINS];
+		for(i = 0; i < NUMBINS; i++)
+			binCount[i] = 0;
+		float32 k = NUMBINS*0.9999f/width;
+		for(i = 0; i < n; i++){
+			BBox *b = &this->nodes[leaves[i]].box;
+			int32 bin = (int32)((centroid(b, axis) - lo)*k);
+			if(binCount[bin]++ == 0)
+				binBox[bin] = *b;
+			else
+				merge(&binBox[bin], &binBox[bin], b);
+		}
+		// sweep from the right, then find the cheapest plane from the left
+		float32 rightArea[NUMBINS];
+		int32 rightCount[NUMBINS];
+		BBox acc;
+		int32 count = 0;
+		for(i = NUMBINS-1; i > 0; i--){
+			if(binCount[i]){
+				if(count == 0)
+					acc = binBox[i];
+				else
+					merge(&acc, &acc, &binBox[i]);
+				count += binCount[i];
+			}
+			rightArea[i] = count ? halfArea(&acc) : 0.0f;
+			rightCount[i] = count;
+		}
+		float32 bestCost = FLT_MAX;
+		int32 bestSplit = -1;
+		count = 0;
+		for(i = 0; i < NUMBINS-1; i++){
+			if(binCount[i]){
+				if(count == 0)
+					acc = binBox[i];
+				else
+					merge(&acc, &acc, &binBox[i]);
+				count += binCount[i];
+			}
+			if(count == 0 || rightCount[i+1] == 0)
+				continue;
+			float32 cost = count*halfArea(&acc) + rightCount[i+1]*rightArea[i+1];
+			if(cost < bestCost){
+				bestCost = cost;
+				bestSplit = i;
+			}
+		}
+		if(bestSplit >= 0){
+			// partition by bin
+			int32 l = 0, r = n-1;
+			while(l <= r){
+				int32 bin = (int32)((centroid(&this->nodes[leaves[l]].box, axis) - lo)*k);
+				if(bin <= bestSplit)
+					l++;
+				else{
+					int32 tmp = leaves[l];
+					leaves[l] = leaves[r];
+					leaves[r--] = tmp;
+				}
+			}
+			if(l > 0 && l < n)
+				mid = l;
+		}
+	}
+
+	int32 node = this->allocNode();
+	int32 c0 = this->buildRecursive(leaves, mid);
+	int32 c1 = this->buildRecursive(leaves+mid, n-mid);
+	BVHNode *nn = &this->nodes[node];
+	BVHNode *n0 = &this->nodes[c0];
+	BVHNode *n1 = &this->nodes[c1];
+	nn->child[0] = c0;
+	nn->child[1] = c1;
+	n0->parent = node;
+	n1->parent = node;
+	merge(&nn->box, &n0->box, &n1->box);
+	nn->height = 1 + (n0->height > n1->height ? n0->height : n1->height);
+	return node;
+}
+
+void
+DynamicBVH::build(void)
+{
+	int32 i;
+	if(this->numLeaves < 2)
+		return;
+	// collect leaves and free all internal nodes
+	int32 *leaves = rwNewT(int32, this->numLeaves, MEMDUR_FUNCTION | ID_WORLD);
+	int32 n = 0;
+	for(i = 0; i < this->maxNodes; i++){
+		BVHNode *node = &this->nodes[i];
+		if(node->height < 0)
+			continue;
+		if(node->height == 0)
+			leaves[n++] = i;
+		else
+			this->freeNode(i);
+	}
+	assert(n == this->numLeaves);
+	this->root = this->buildRecursive(leaves, n);
+	this->nodes[this->root].parent = NULLNODE;
+	rwFree(leaves);
+}
+
+float32
+DynamicBVH::getCost(void)
+{
+	if(this->root == NULLNODE)
+		return 0.0f;
+	float32 cost = 0.0f;
+	for(int32 i = 0; i < this->maxNodes; i++)
+		if(this->nodes[i].height > 0)
+			cost += halfArea(&this->nodes[i].box);
+	return cost / halfArea(&this->nodes[this->root].box);
+}
+
+//
+// World queries
+//
+
+enum { STACKSIZE = 64 };
+
+static bool32
+boxesOverlap(const BBox *a, const BBox *b)
+{
+	return a->inf.x <= b->sup.x && a->sup.x >= b->inf.x &&
+	       a->inf.y <= b->sup.y && a->sup.y >= b->inf.y &&
+	       a->inf.z <= b->sup.z && a->sup.z >= b->inf.z;
+}
+
+static float32
+boxSphereDistSq(const BBox *b, const V3d *p)
+{
+	float32 d, dist = 0.0f;
+	const float32 *inf = &b->inf.x;
+	const float32 *sup = &b->sup.x;
+	const float32 *c = &p->x;
+	for(int32 i = 0; i < 3; i++){
+		if(c[i] < inf[i]){ d = inf[i] - c[i]; dist += d*d; }
+		else if(c[i] > sup[i]){ d = c[i] - sup[i]; dist += d*d; }
+	}
+	return dist;
+}
+
+// Calls cb for all leaves below node, returns 0 if cb stopped
+static bool32
+forAllLeaves(DynamicBVH *bvh, int32 node, Atomic::Callback cb, void *data)
+{
+	int32 stack[STACKSIZE];
+	int32 sp = 0;
+	stack[sp++] = node;
+	while(sp > 0){
+		BVHNode *n = &bvh->nodes[stack[--sp]];
+		if(n->height == 0){
+			if(cb((Atomic*)n->object, data) == nil)
+				return 0;
+		}else if(sp+2 <= STACKSIZE){
+			stack[sp++] = n->child[0];
+			stack[sp++] = n->child[1];
+		}else if(!forAllLeaves(bvh, n->child[0], cb, data) ||
+		         !forAllLeaves(bvh, n->child[1], cb, data))
+			return 0;
+	}
+	return 1;
+}
+
+// Atomics whose world sphere is not outside the frustum
+static bool32
+frustumRecurse(DynamicBVH *bvh, int32 node, Camera *cam, Atomic::Callback cb, void *data)
+{
+	int32 stack[STACKSIZE];
+	int32 sp = 0;
+	stack[sp++] = node;
+	while(sp > 0){
+		int32 i = stack[--sp];
+		BVHNode *n = &bvh->nodes[i];
+		int32 res = cam->frustumTestBox(&n->box);
+		if(res == Camera::BOXOUTSIDE)
+			continue;
+		if(n->height == 0){
+			Atomic *a = (Atomic*)n->object;
+			if(cam->frustumTestSphere(a->getWorldBoundingSphere()) != Camera::SPHEREOUTSIDE &&
+			   cb(a, data) == nil)
+				return 0;
+		}else if(res == Camera::BOXINSIDE){
+			// whole subtree is inside, so are the atomics in it
+			if(!forAllLeaves(bvh, i, cb, data))
+				return 0;
+		}else if(sp+2 <= STACKSIZE){
+			stack[sp++] = n->child[0];
+			stack[sp++] = n->child[1];
+		}else if(!frustumRecurse(bvh, n->child[0], cam, cb, data) ||
+		         !frustumRecurse(bvh, n->child[1], cam, cb, data))
+			return 0;
+	}
+	return 1;
+}
+
+struct ViewQuery
+{
+	Camera **cams;
+	int32 numCams;
+	BBox bound;	// of all frustums
+	World::ViewCallback cb;
+	void *data;
+};
+
+struct ViewEntry
+{
+	int32 node;
+	uint32 views;	// cameras that may see the node
+	uint32 inside;	// cameras the node is known to be inside of
+};
+
+// Like frustumRecurse but with a mask of cameras still interested in a subtree
+static bool32
+viewsRecurse(DynamicBVH *bvh, ViewEntry *e, ViewQuery *q)
+{
+	int32 i;
+	ViewEntry stack[STACKSIZE];
+	int32 sp = 0;
+	stack[sp++] = *e;
+	while(sp > 0){
+		ViewEntry cur = stack[--sp];
+		BVHNode *n = &bvh->nodes[cur.node];
+		if(!boxesOverlap(&n->box, &q->bound))
+			continue;
+		uint32 views = cur.views;
+		uint32 inside = cur.inside;
+		for(i = 0; i < q->numCams; i++){
+			uint32 bit = 1u<<i;
+			if((views & bit) == 0 || (inside & bit))
+				continue;
+			int32 res = Camera::BOXOUTSIDE;
+			if(boxesOverlap(&n->box, &q->cams[i]->frustumBoundBox))
+				res = q->cams[i]->frustumTestBox(&n->box);
+			if(res == Camera::BOXOUTSIDE)
+				views &= ~bit;
+			else if(res == Camera::BOXINSIDE)
+				inside |= bit;
+		}
+		if(views == 0)
+			continue;
+		if(n->height == 0){
+			// spheres are tested where frustumRecurse would test them
+			Atomic *a = (Atomic*)n->object;
+			Sphere *s = a->getWorldBoundingSphere();
+			for(i = 0; i < q->numCams; i++){
+				uint32 bit = 1u<<i;
+				if((views & bit) && (cur.inside & bit) == 0 &&
+				   q->cams[i]->frustumTestSphere(s) == Camera::SPHEREOUTSIDE)
+					views &= ~bit;
+			}
+			if(views && q->cb(a, views, q->data) == nil)
+				return 0;
+			continue;
+		}
+		ViewEntry children[2];
+		for(i = 0; i < 2; i++){
+			children[i].node = n->child[i];
+			children[i].views = views;
+			children[i].inside = inside;
+		}
+		if(sp+2 <= STACKSIZE){
+			stack[sp++] = children[0];
+			stack[sp++] = children[1];
+		}else if(!viewsRecurse(bvh, &children[0], q) ||
+		         !viewsRecurse(bvh, &children[1], q))
+			return 0;
+	}
+	return 1;
+}
+
+static bool32
+sphereRecurse(DynamicBVH *bvh, int32 node, Sphere *s, Atomic::Callback cb, void *data)
+{
+	int32 stack[STACKSIZE];
+	int32 sp = 0;
+	float32 r2 = s->radius*s->radius;
+	stack[sp++] = node;
+	while(sp > 0){
+		BVHNode *n = &bvh->nodes[stack[--sp]];
+		if(boxSphereDistSq(&n->box, &s->center) > r2)
+			continue;
+		if(n->height == 0){
+			Atomic *a = (Atomic*)n->object;
+			if(boxSphereDistSq(a->getWorldBoundingBox(), &s->center) <= r2 &&
+			   cb(a, data) == nil)
+				return 0;
+		}else if(sp+2 <= STACKSIZE){
+			stack[sp++] = n->child[0];
+			stack[sp++] = n->child[1];
+		}else if(!sphereRecurse(bvh, n->child[0], s, cb, data) ||
+		         !sphereRecurse(bvh, n->child[1], s, cb, data))
+			return 0;
+	}
+	return 1;
+}
+
+static bool32
+boxRecurse(DynamicBVH *bvh, int32 node, BBox *box, Atomic::Callback cb, void *data)
+{
+	int32 stack[STACKSIZE];
+	int32 sp = 0;
+	stack[sp++] = node;
+	while(sp > 0){
+		BVHNode *n = &bvh->nodes[stack[--sp]];
+		if(!boxesOverlap(&n->box, box))
+			continue;
+		if(n->height == 0){
+			Atomic *a = (Atomic*)n->object;
+			if(boxesOverlap(a->getWorldBoundingBox(), box) &&
+			   cb(a, data) == nil)
+				return 0;
+		}else if(sp+2 <= STACKSIZE){
+			stack[sp++] = n->child[0];
+			stack[sp++] = n->child[1];
+		}else if(!boxRecurse(bvh, n->child[0], box, cb, data) ||
+		         !boxRecurse(bvh, n->child[1], box, cb, data))
+			return 0;
+	}
+	return 1;
+}
+
+void
+World::forAllAtomicsInFrustum(Camera *cam, Atomic::Callback cb, void *data)
+{
+	if(this->bvh.root != NULLNODE)
+		frustumRecurse(&this->bvh, this->bvh.root, cam, cb, data);
+}
+
+void
+World::forAllAtomicsInFrustums(Camera **cams, int32 numCams, ViewCallback cb, void *data)
+{
+	int32 i;
+	assert(numCams <= MultiView::MAXVIEWS);
+	if(this->bvh.root == NULLNODE || numCams <= 0)
+		return;
+	ViewQuery q;
+	q.cams = cams;
+	q.numCams = numCams;
+	q.bound = cams[0]->frustumBoundBox;
+	for(i = 1; i < numCams; i++){
+		q.bound.addPoint(&cams[i]->frustumBoundBox.inf);
+		q.bound.addPoint(&cams[i]->frustumBoundBox.sup);
+	}
+	q.cb = cb;
+	q.data = data;
+	ViewEntry root;
+	root.node = this->bvh.root;
+	root.views = numCams == 32 ? ~0u : (1u<<numCams)-1;
+	root.inside = 0;
+	viewsRecurse(&this->bvh, &root, &q);
+}
+
+void
+World::forAllAtomicsInSphere(Sphere *sphere, Atomic::Callback cb, void *data)
+{
+	if(this->bvh.root != NULLNODE)
+		sphereRecurse(&this->bvh, this->bvh.root, sphere, cb, data);
+}
+
+void
+World::forAllAtomicsInBox(BBox *box, Atomic::Callback cb, void *data)
+{
+	if(this->bvh.root != NULLNODE)
+		boxRecurse(&this->bvh, this->bvh.root, box, cb, data);
+}
+
+void
+World::buildBVH(void)
+{
+	this->bvh.build();
+}
+
+}
@@ -27,6 +27,7 @@ namespace rw {
 	{
 		engine->currentCamera = cam;
 		Frame::syncDirty();
+		ObjPipeline::uploadPrepared();
 		engine->device.beginUpdate(cam);
 	}
 
@@ -265,6 +266,9 @@ namespace rw {
 	{
 		engine->currentWorld = cam->world;
 		cam->originalBeginUpdate(cam);
+		// after the frames are synced
+		if(cam->world && cam->world->lightGrid)
+			cam->world->lightGrid->build(cam->world, cam);
 	}
 
 	void
@@ -446,6 +450,53 @@ namespace rw {
 		return res;
 	}
 
+	// closestX/Y/Z select the corner furthest along the normal
+	int32
+		Camera::frustumTestBox(const BBox* box) const
+	{
+		int32 res = BOXINSIDE;
+		const FrustumPlane* p = this->frustumPlanes;
+		for (int32 i = 0; i < 6; i++) {
+			V3d pmax, pmin;
+			pmax.x = p->closestX ? box->sup.x : box->inf.x;
+			pmax.y = p->closestY ? box->sup.y : box->inf.y;
+			pmax.z = p->closestZ ? box->sup.z : box->inf.z;
+			pmin.x = p->closestX ? box->inf.x : box->sup.x;
+			pmin.y = p->closestY ? box->inf.y : box->sup.y;
+			pmin.z = p->closestZ ? box->inf.z : box->sup.z;
+			if (dot(p->plane.normal, pmin) > p->plane.distance)
+				return BOXOUTSIDE;
+			if (dot(p->plane.normal, pmax) > p->plane.distance)
+				res = BOXBOUNDARY;
+			p++;
+		}
+		return res;
+	}
+
+	// Test many spheres at once, plane by plane.
+	// Only tells outside from not outside.
+	int32
+		Camera::frustumTestSpheres(const Sphere* s, int32 n, uint8* visible) const
+	{
+		int32 i, j;
+		for (i = 0; i < n; i++)
+			visible[i] = 1;
+		for (j = 0; j < 6; j++) {
+			const Plane* p = &this->frustumPlanes[j].plane;
+			float32 nx = p->normal.x, ny = p->normal.y, nz = p->normal.z;
+			float32 d = p->distance;
+			for (i = 0; i < n; i++) {
+				float32 dist = nx * s[i].center.x + ny * s[i].center.y +
+					nz * s[i].center.z - d;
+				visible[i] &= dist <= s[i].radius;
+			}
+		}
+		int32 numVisible = 0;
+		for (i = 0; i < n; i++)
+			numVisible += visible[i];
+		return numVisible;
+	}
+
 	struct CameraChunkData
 	{
 		V2d viewWindow;
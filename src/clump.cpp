@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <math.h>
 
 #include "rwbase.h"
 #include "rwerror.h"
@@ -203,11 +204,11 @@ Clump::streamRead(Stream *stream)
 			memset(geometryList, 0, sz);
 		}
 		for(int32 i = 0; i < numGeometries; i++){
-			if(!findChunk(stream, ID_GEOMETRY, nil, nil)){
+			if(!findChunk(stream, ID_GEOMETRY, &length, nil)){
 				RWERROR((ERR_CHUNK, "GEOMETRY"));
 				goto failgeo;
 			}
-			geometryList[i] = Geometry::streamRead(stream);
+			geometryList[i] = Geometry::streamReadShared(stream, length);
 			if(geometryList[i] == nil)
 				goto failgeo;
 		}
@@ -378,15 +379,59 @@ Clump::streamGetSize(void)
 	return size;
 }
 
+static bool32 frustumCulling = 1;
+CullStats cullStats;
+
+void Clump::setFrustumCulling(bool32 b) { frustumCulling = b; }
+bool32 Clump::getFrustumCulling(void) { return frustumCulling; }
+void Clump::getCullStats(CullStats *stats) { *stats = cullStats; }
+void Clump::resetCullStats(void) { memset(&cullStats, 0, sizeof(cullStats)); }
+
+enum { CULLBATCH = 64 };
+
+static void
+renderCulled(Camera *cam, Atomic **atomics, Sphere *spheres, int32 n)
+{
+	uint8 visible[CULLBATCH];
+	int32 numVisible = cam->frustumTestSpheres(spheres, n, visible);
+	cullStats.numTested += n;
+	cullStats.numCulled += n - numVisible;
+	for(int32 i = 0; i < n; i++)
+		if(visible[i])
+			atomics[i]->render();
+}
+
 void
 Clump::render(void)
 {
 	Atomic *a;
+	Camera *cam = engine->currentCamera;
+	if(!frustumCulling || cam == nil){
+		FORLIST(lnk, this->atomics){
+			a = Atomic::fromClump(lnk);
+			if(a->object.object.flags & Atomic::RENDER)
+				a->render();
+		}
+		return;
+	}
+
+	// test world spheres in batches
+	Atomic *atomics[CULLBATCH];
+	Sphere spheres[CULLBATCH];
+	int32 n = 0;
 	FORLIST(lnk, this->atomics){
 		a = Atomic::fromClump(lnk);
-		if(a->object.object.flags & Atomic::RENDER)
-			a->render();
+		if(!(a->object.object.flags & Atomic::RENDER))
+			continue;
+		atomics[n] = a;
+		spheres[n] = *a->getWorldBoundingSphere();
+		if(++n == CULLBATCH){
+			renderCulled(cam, atomics, spheres, n);
+			n = 0;
+		}
 	}
+	if(n)
+		renderCulled(cam, atomics, spheres, n);
 }
 void
 Clump::beginUpdate(void)
@@ -415,6 +460,8 @@ worldAtomicSync(ObjectWithFrame *obj)
 {
 	Atomic *atomic = (Atomic*)obj;
 	atomic->originalSync(obj);
+	if(atomic->world)
+		atomic->world->updateAtomic(atomic);
 }
 
 Atomic*
@@ -433,6 +480,9 @@ Atomic::create(void)
 	atomic->boundingSphere.radius = 0.0f;
 	atomic->worldBoundingSphere.center.set(0.0f, 0.0f, 0.0f);
 	atomic->worldBoundingSphere.radius = 0.0f;
+	atomic->boundingBox.inf.set(0.0f, 0.0f, 0.0f);
+	atomic->boundingBox.sup.set(0.0f, 0.0f, 0.0f);
+	atomic->worldBoundingBox = atomic->boundingBox;
 	atomic->setFrame(nil);
 	atomic->object.object.privateFlags |= WORLDBOUNDDIRTY;
 	atomic->clump = nil;
@@ -445,6 +495,9 @@ Atomic::create(void)
 
 	// World extension
 	atomic->world = nil;
+	atomic->ties = nil;
+	atomic->worldSerial = 0;
+	atomic->bvhLeaf = -1;
 	atomic->originalSync = atomic->object.syncCB;
 	atomic->object.syncCB = worldAtomicSync;
 
@@ -497,25 +550,58 @@ Atomic::setGeometry(Geometry *geo, uint32 flags)
 		return;
 	if(geo){
 		this->boundingSphere = geo->morphTargets[0].boundingSphere;
+		this->boundingBox = geo->morphTargets[0].boundingBox;
 		if(this->getFrame())	// TODO: && getWorld???
 			this->getFrame()->updateObjects();
 	}
 }
 
+// Updates both the world sphere and box
+static void
+updateWorldBounds(Atomic *atomic)
+{
+	// morph interpolation sets the object space bounds
+	if(!atomic->getFrame()->dirty() &&
+	   (atomic->object.object.privateFlags & Atomic::WORLDBOUNDDIRTY) == 0)
+		return;
+	Matrix *ltm = atomic->getFrame()->getLTM();
+
+	Sphere *s = &atomic->worldBoundingSphere;
+	V3d::transformPoints(&s->center, &atomic->boundingSphere.center, 1, ltm);
+	float32 sx = dot(ltm->right, ltm->right);
+	float32 sy = dot(ltm->up, ltm->up);
+	float32 sz = dot(ltm->at, ltm->at);
+	float32 maxScale = sx > sy ? sx : sy;
+	maxScale = sz > maxScale ? sz : maxScale;
+	s->radius = atomic->boundingSphere.radius*sqrtf(maxScale);
+
+	// transform center and extent of the box (Arvo)
+	BBox *box = &atomic->boundingBox;
+	V3d c = scale(add(box->sup, box->inf), 0.5f);
+	V3d e = scale(sub(box->sup, box->inf), 0.5f);
+	V3d wc, we;
+	V3d::transformPoints(&wc, &c, 1, ltm);
+	we.x = fabsf(ltm->right.x)*e.x + fabsf(ltm->up.x)*e.y + fabsf(ltm->at.x)*e.z;
+	we.y = fabsf(ltm->right.y)*e.x + fabsf(ltm->up.y)*e.y + fabsf(ltm->at.y)*e.z;
+	we.z = fabsf(ltm->right.z)*e.x + fabsf(ltm->up.z)*e.y + fabsf(ltm->at.z)*e.z;
+	atomic->worldBoundingBox.inf = sub(wc, we);
+	atomic->worldBoundingBox.sup = add(wc, we);
+
+	atomic->object.object.privateFlags &= ~Atomic::WORLDBOUNDDIRTY;
+}
+
 Sphere*
 Atomic::getWorldBoundingSphere(void)
 {
-	Sphere *s = &this->worldBoundingSphere;
-	// TODO: if we ever support morphing, check interpolation
-	if(!this->getFrame()->dirty() &&
-	   (this->object.object.privateFlags & WORLDBOUNDDIRTY) == 0)
-		return s;
-	Matrix *ltm = this->getFrame()->getLTM();
-	// TODO: support scaling
-	V3d::transformPoints(&s->center, &this->boundingSphere.center, 1, ltm);
-	s->radius = this->boundingSphere.radius;
-	this->object.object.privateFlags &= ~WORLDBOUNDDIRTY;
-	return s;
+	updateWorldBounds(this);
+	return &this->worldBoundingSphere;
+}
+
+BBox*
+Atomic::getWorldBoundingBox(void)
+{
+	updateWorldBounds(this);
+	return &this->worldBoundingBox;
 }
 
 static uint32 atomicRights[2];
@@ -536,12 +622,13 @@ Atomic::streamReadClump(Stream *stream,
 		return nil;
 	atomic->setFrame(frameList->frames[buf[0]]);
 	Geometry *g;
+	uint32 length;
 	if(version < 0x30400){
-		if(!findChunk(stream, ID_GEOMETRY, nil, nil)){
+		if(!findChunk(stream, ID_GEOMETRY, &length, nil)){
 			RWERROR((ERR_CHUNK, "STRUCT"));
 			goto fail;
 		}
-		g = Geometry::streamRead(stream);
+		g = Geometry::streamReadShared(stream, length);
 		if(g == nil)
 			goto fail;
 		atomic->setGeometry(g, 0);
@@ -0,0 +1,897 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <float.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+#include "rwanim.h"
+#include "rwplugins.h"
+
+#define PLUGIN_ID ID_COLLTREE
+
+/*
+ * Collision trees for geometry.
+ *
+ * A tree is an AABB hierarchy over a copy of the triangles and
+ * vertices of the first morph target, so it stays usable when
+ * the geometry itself only has native data. Triangles are sorted
+ * so every leaf references a contiguous run of them.
+ * Trees are streamed in their own chunk. The binary layout of
+ * RW's Collision PLG is not known, such chunks are skipped and
+ * the tree is built from the triangles after the geometry is read.
+ * Nothing here depends on a render device.
+ */
+
+namespace rw {
+
+CollisionGlobals collisionGlobals = { 0, 0 };
+
+enum { LEAFSIZE = 4, STACKSIZE = 64 };
+
+struct CollisionData
+{
+	CollisionTree *tree;
+	bool32 build;	// RW collision data was seen while reading
+};
+
+#define GETCOLLDATA(geo) PLUGINOFFSET(CollisionData, geo, collisionGlobals.geoOffset)
+
+static CollisionTree*
+allocTree(int32 numVertices, int32 numTriangles, int32 numNodes)
+{
+	CollisionTree *t = (CollisionTree*)rwNew(sizeof(CollisionTree) +
+		numVertices*sizeof(V3d) + numTriangles*sizeof(CollisionTriangle) +
+		numNodes*sizeof(CollisionNode), MEMDUR_EVENT | ID_COLLTREE);
+	t->numVertices = numVertices;
+	t->numTriangles = numTriangles;
+	t->numNodes = numNodes;
+	t->depth = 0;
+	t->nodes = (CollisionNode*)(t+1);
+	t->vertices = (V3d*)(t->nodes + numNodes);
+	t->triangles = (CollisionTriangle*)(t->vertices + numVertices);
+	return t;
+}
+
+//
+// Building
+//
+
+struct CollBuildData
+{
+	CollisionTree *tree;
+	CollisionTriangle *tris;	// in geometry order
+	int32 *order;
+	V3d *centers;
+};
+
+static void
+boundTriangles(CollisionTree *tree, CollisionTriangle *tris, int32 n, BBox *box)
+{
+	box->initialize(&tree->vertices[tris[0].v[0]]);
+	for(int32 i = 0; i < n; i++)
+		for(int32 j = 0; j < 3; j++)
+			box->addPoint(&tree->vertices[tris[i].v[j]]);
+}
+
+// Split at the middle of the longest axis of the centers,
+// returns size of the left part
+static int32
+splitTriangles(CollBuildData *bd, int32 *order, int32 n)
+{
+	int32 i;
+	BBox cb;
+	cb.initialize(&bd->centers[order[0]]);
+	for(i = 1; i < n; i++)
+		cb.addPoint(&bd->centers[order[i]]);
+	V3d ext = sub(cb.sup, cb.inf);
+	int32 axis = ext.x > ext.y ? (ext.x > ext.z ? 0 : 2) : (ext.y > ext.z ? 1 : 2);
+	float32 mid = (&cb.inf.x)[axis] + (&ext.x)[axis]*0.5f;
+	int32 left = 0, right = n-1;
+	while(left <= right){
+		if((&bd->centers[order[left]].x)[axis] < mid)
+			left++;
+		else{
+			int32 tmp = order[left];
+			order[left] = order[right];
+			order[right--] = tmp;
+		}
+	}
+	return left == 0 || left == n ? n/2 : left;
+}
+
+static void
+buildNode(CollBuildData *bd, int32 node, int32 first, int32 n, int32 depth)
+{
+	CollisionTree *tree = bd->tree;
+	CollisionNode *nd = &tree->nodes[node];
+	if(depth > tree->depth)
+		tree->depth = depth;
+	if(n <= LEAFSIZE){
+		for(int32 i = 0; i < n; i++)
+			tree->triangles[first+i] = bd->tris[bd->order[first+i]];
+		boundTriangles(tree, &tree->triangles[first], n, &nd->box);
+		nd->index = first;
+		nd->count = n;
+		return;
+	}
+	int32 mid = splitTriangles(bd, &bd->order[first], n);
+	nd->index = tree->numNodes;
+	nd->count = 0;
+	tree->numNodes += 2;
+	buildNode(bd, nd->index, first, mid, depth+1);
+	buildNode(bd, nd->index+1, first+mid, n-mid, depth+1);
+	nd = &tree->nodes[node];
+	nd->box = tree->nodes[nd->index].box;
+	nd->box.addPoint(&tree->nodes[nd->index+1].box.inf);
+	nd->box.addPoint(&tree->nodes[nd->index+1].box.sup);
+}
+
+CollisionTree*
+CollisionTree::build(Geometry *geo)
+{
+	int32 i;
+	CollisionData *cd = GETCOLLDATA(geo);
+	int32 n = geo->numTriangles;
+	if(n == 0 || geo->numMorphTargets == 0 || (geo->flags & Geometry::NATIVE))
+		return nil;
+
+	// at most 2n-1 nodes
+	CollisionTree *tree = allocTree(geo->numVertices, n, 2*n);
+	tree->numNodes = 1;
+	memcpy(tree->vertices, geo->morphTargets[0].vertices, geo->numVertices*sizeof(V3d));
+
+	CollBuildData bd;
+	bd.tree = tree;
+	bd.tris = rwNewT(CollisionTriangle, n, MEMDUR_FUNCTION | ID_COLLTREE);
+	bd.order = rwNewT(int32, n, MEMDUR_FUNCTION | ID_COLLTREE);
+	bd.centers = rwNewT(V3d, n, MEMDUR_FUNCTION | ID_COLLTREE);
+	for(i = 0; i < n; i++){
+		CollisionTriangle *t = &bd.tris[i];
+		t->v[0] = geo->getTriVertex(i, 0);
+		t->v[1] = geo->getTriVertex(i, 1);
+		t->v[2] = geo->getTriVertex(i, 2);
+		t->index = i;
+		t->matId = geo->getTriMatId(i);
+		V3d c = add(tree->vertices[t->v[0]], add(tree->vertices[t->v[1]], tree->vertices[t->v[2]]));
+		bd.centers[i] = scale(c, 1.0f/3.0f);
+		bd.order[i] = i;
+	}
+	buildNode(&bd, 0, 0, n, 0);
+	rwFree(bd.centers);
+	rwFree(bd.order);
+	rwFree(bd.tris);
+
+	rwFree(cd->tree);
+	cd->tree = tree;
+	return tree;
+}
+
+void
+CollisionTree::remove(Geometry *geo)
+{
+	CollisionData *cd = GETCOLLDATA(geo);
+	rwFree(cd->tree);
+	cd->tree = nil;
+}
+
+CollisionTree*
+CollisionTree::get(Geometry *geo)
+{
+	return GETCOLLDATA(geo)->tree;
+}
+
+//
+// Primitive tests
+//
+
+static V3d
+closestOnTriangle(V3d p, V3d a, V3d b, V3d c)
+{
+	V3d ab = sub(b, a);
+	V3d ac = sub(c, a);
+	V3d ap = sub(p, a);
+	float32 d1 = dot(ab, ap);
+	float32 d2 = dot(ac, ap);
+	if(d1 <= 0.0f && d2 <= 0.0f)
+		return a;
+	V3d bp = sub(p, b);
+	float32 d3 = dot(ab, bp);
+	float32 d4 = dot(ac, bp);
+	if(d3 >= 0.0f && d4 <= d3)
+		return b;
+	float32 vc = d1*d4 - d3*d2;
+	if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+		return add(a, scale(ab, d1/(d1 - d3)));
+	V3d cp = sub(p, c);
+	float32 d5 = dot(ab, cp);
+	float32 d6 = dot(ac, cp);
+	if(d6 >= 0.0f && d5 <= d6)
+		return c;
+	float32 vb = d5*d2 - d1*d6;
+	if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+		return add(a, scale(ac, d2/(d2 - d6)));
+	float32 va = d3*d6 - d5*d4;
+	if(va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+		return add(b, scale(sub(c, b), (d4 - d3)/((d4 - d3) + (d5 - d6))));
+	float32 sum = va + vb + vc;
+	if(sum <= 0.0f)	// degenerate
+		return a;
+	return add(a, add(scale(ab, vb/sum), scale(ac, vc/sum)));
+}
+
+static float32
+clamp01(float32 f)
+{
+	return f < 0.0f ? 0.0f : f > 1.0f ? 1.0f : f;
+}
+
+// Closest points of segments p1-q1 and p2-q2
+static void
+closestSegmentSegment(V3d p1, V3d q1, V3d p2, V3d q2, V3d *c1, V3d *c2)
+{
+	V3d d1 = sub(q1, p1);
+	V3d d2 = sub(q2, p2);
+	V3d r = sub(p1, p2);
+	float32 a = dot(d1, d1);
+	float32 e = dot(d2, d2);
+	float32 f = dot(d2, r);
+	float32 s, t;
+	if(a <= 1.0e-12f && e <= 1.0e-12f){
+		*c1 = p1;
+		*c2 = p2;
+		return;
+	}
+	if(a <= 1.0e-12f){
+		s = 0.0f;
+		t = clamp01(f/e);
+	}else{
+		float32 c = dot(d1, r);
+		if(e <= 1.0e-12f){
+			t = 0.0f;
+			s = clamp01(-c/a);
+		}else{
+			float32 b = dot(d1, d2);
+			float32 denom = a*e - b*b;
+			s = denom > 0.0f ? clamp01((b*f - c*e)/denom) : 0.0f;
+			t = (b*s + f)/e;
+			if(t < 0.0f){
+				t = 0.0f;
+				s = clamp01(-c/a);
+			}else if(t > 1.0f){
+				t = 1.0f;
+				s = clamp01((b - c)/a);
+			}
+		}
+	}
+	*c1 = add(p1, scale(d1, s));
+	*c2 = add(p2, scale(d2, t));
+}
+
+// Moeller-Trumbore, both sides count. Returns t along dir or -1.
+static float32
+rayTriangle(V3d start, V3d dir, V3d a, V3d b, V3d c, float32 maxT)
+{
+	V3d e1 = sub(b, a);
+	V3d e2 = sub(c, a);
+	V3d p = cross(dir, e2);
+	float32 det = dot(e1, p);
+	if(fabsf(det) <= 1.0e-20f)
+		return -1.0f;
+	float32 inv = 1.0f/det;
+	V3d s = sub(start, a);
+	float32 u = dot(s, p)*inv;
+	if(u < 0.0f || u > 1.0f)
+		return -1.0f;
+	V3d q = cross(s, e1);
+	float32 v = dot(dir, q)*inv;
+	if(v < 0.0f || u + v > 1.0f)
+		return -1.0f;
+	float32 t = dot(e2, q)*inv;
+	return t >= 0.0f && t <= maxT ? t : -1.0f;
+}
+
+// Squared distance between segment p-q and a triangle
+static float32
+closestSegmentTriangle(V3d p, V3d q, const V3d *tri, V3d *onSeg, V3d *onTri)
+{
+	V3d d = sub(q, p);
+	float32 t = rayTriangle(p, d, tri[0], tri[1], tri[2], 1.0f);
+	if(t >= 0.0f){
+		*onSeg = *onTri = add(p, scale(d, t));
+		return 0.0f;
+	}
+	V3d c1, c2;
+	float32 best;
+	*onSeg = p;
+	*onTri = closestOnTriangle(p, tri[0], tri[1], tri[2]);
+	V3d diff = sub(*onSeg, *onTri);
+	best = dot(diff, diff);
+	c2 = closestOnTriangle(q, tri[0], tri[1], tri[2]);
+	diff = sub(q, c2);
+	if(dot(diff, diff) < best){
+		best = dot(diff, diff);
+		*onSeg = q;
+		*onTri = c2;
+	}
+	for(int32 i = 0; i < 3; i++){
+		closestSegmentSegment(p, q, tri[i], tri[(i+1)%3], &c1, &c2);
+		diff = sub(c1, c2);
+		if(dot(diff, diff) < best){
+			best = dot(diff, diff);
+			*onSeg = c1;
+			*onTri = c2;
+		}
+	}
+	return best;
+}
+
+static V3d
+faceNormal(const V3d *tri)
+{
+	V3d n = cross(sub(tri[1], tri[0]), sub(tri[2], tri[0]));
+	float32 len = length(n);
+	return len > 0.0f ? scale(n, 1.0f/len) : makeV3d(0.0f, 0.0f, 1.0f);
+}
+
+static bool32
+boxesOverlap(const BBox *a, const BBox *b)
+{
+	return a->inf.x <= b->sup.x && a->sup.x >= b->inf.x &&
+	       a->inf.y <= b->sup.y && a->sup.y >= b->inf.y &&
+	       a->inf.z <= b->sup.z && a->sup.z >= b->inf.z;
+}
+
+//
+// Queries
+//
+
+struct ContactList
+{
+	CollisionContact *contacts;
+	int32 max;
+	int32 num;
+};
+
+// When full the shallowest contact makes room
+static void
+addContact(ContactList *l, const CollisionContact *c)
+{
+	if(l->num < l->max){
+		l->contacts[l->num++] = *c;
+		return;
+	}
+	if(l->max == 0)
+		return;
+	int32 j = 0;
+	for(int32 i = 1; i < l->max; i++)
+		if(l->contacts[i].distance < l->contacts[j].distance)
+			j = i;
+	if(c->distance > l->contacts[j].distance)
+		l->contacts[j] = *c;
+}
+
+// A traversal never holds more than depth+2 nodes
+struct CollisionStack
+{
+	int32 buf[STACKSIZE];
+	int32 *nodes;
+	int32 sp;
+	int32 size;
+
+	void init(int32 depth){
+		this->size = depth+2;
+		this->sp = 0;
+		this->nodes = this->size <= STACKSIZE ? this->buf :
+			rwNewT(int32, this->size, MEMDUR_FUNCTION | ID_COLLTREE);
+	}
+	void deinit(void){
+		if(this->nodes != this->buf)
+			rwFree(this->nodes);
+	}
+	void push(int32 n){
+		assert(this->sp < this->size);
+		if(this->sp < this->size)
+			this->nodes[this->sp++] = n;
+	}
+	int32 pop(void) { return this->nodes[--this->sp]; }
+	bool32 empty(void) { return this->sp == 0; }
+};
+
+typedef void (*LeafCB)(CollisionTree *tree, CollisionTriangle *tri, void *data);
+
+// Calls cb for all triangles in leaves overlapping box
+static void
+forAllLeaves(CollisionTree *tree, const BBox *box, LeafCB cb, void *data)
+{
+	CollisionStack st;
+	if(tree->numNodes == 0)
+		return;
+	st.init(tree->depth);
+	st.push(0);
+	while(!st.empty()){
+		CollisionNode *n = &tree->nodes[st.pop()];
+		if(!boxesOverlap(&n->box, box))
+			continue;
+		if(n->count){
+			for(int32 i = 0; i < n->count; i++)
+				cb(tree, &tree->triangles[n->index+i], data);
+			continue;
+		}
+		st.push(n->index);
+		st.push(n->index+1);
+	}
+	st.deinit();
+}
+
+static void
+getTriangle(CollisionTree *tree, CollisionTriangle *t, V3d *tri)
+{
+	tri[0] = tree->vertices[t->v[0]];
+	tri[1] = tree->vertices[t->v[1]];
+	tri[2] = tree->vertices[t->v[2]];
+}
+
+struct SphereQuery
+{
+	const Sphere *sphere;
+	ContactList list;
+};
+
+static void
+sphereLeaf(CollisionTree *tree, CollisionTriangle *t, void *data)
+{
+	SphereQuery *q = (SphereQuery*)data;
+	V3d tri[3];
+	getTriangle(tree, t, tri);
+	V3d p = closestOnTriangle(q->sphere->center, tri[0], tri[1], tri[2]);
+	V3d d = sub(q->sphere->center, p);
+	float32 dist2 = dot(d, d);
+	float32 r = q->sphere->radius;
+	if(dist2 > r*r)
+		return;
+	CollisionContact c;
+	float32 dist = sqrtf(dist2);
+	c.point = p;
+	c.normal = dist > 0.0f ? scale(d, 1.0f/dist) : faceNormal(tri);
+	c.distance = r - dist;
+	c.triangle = t->index;
+	c.matId = t->matId;
+	addContact(&q->list, &c);
+}
+
+int32
+CollisionTree::collideSphere(const Sphere *s, CollisionContact *contacts, int32 maxContacts)
+{
+	SphereQuery q;
+	BBox box;
+	V3d r = makeV3d(s->radius, s->radius, s->radius);
+	box.inf = sub(s->center, r);
+	box.sup = add(s->center, r);
+	q.sphere = s;
+	q.list.contacts = contacts;
+	q.list.max = maxContacts;
+	q.list.num = 0;
+	forAllLeaves(this, &box, sphereLeaf, &q);
+	return q.list.num;
+}
+
+struct CapsuleQuery
+{
+	V3d a, b;
+	float32 radius;
+	ContactList list;
+};
+
+static void
+capsuleLeaf(CollisionTree *tree, CollisionTriangle *t, void *data)
+{
+	CapsuleQuery *q = (CapsuleQuery*)data;
+	V3d tri[3];
+	V3d onSeg, onTri;
+	getTriangle(tree, t, tri);
+	float32 dist2 = closestSegmentTriangle(q->a, q->b, tri, &onSeg, &onTri);
+	if(dist2 > q->radius*q->radius)
+		return;
+	CollisionContact c;
+	float32 dist = sqrtf(dist2);
+	c.point = onTri;
+	if(dist > 0.0f)
+		c.normal = scale(sub(onSeg, onTri), 1.0f/dist);
+	else{
+		// segment passes through, push towards the capsule's middle
+		c.normal = faceNormal(tri);
+		V3d mid = scale(add(q->a, q->b), 0.5f);
+		if(dot(c.normal, sub(mid, tri[0])) < 0.0f)
+			c.normal = neg(c.normal);
+	}
+	c.distance = q->radius - dist;
+	c.triangle = t->index;
+	c.matId = t->matId;
+	addContact(&q->list, &c);
+}
+
+int32
+CollisionTree::collideCapsule(const V3d *a, const V3d *b, float32 radius,
+	CollisionContact *contacts, int32 maxContacts)
+{
+	CapsuleQuery q;
+	BBox box;
+	V3d r = makeV3d(radius, radius, radius);
+	box.initialize((V3d*)a);
+	box.addPoint((V3d*)b);
+	box.inf = sub(box.inf, r);
+	box.sup = add(box.sup, r);
+	q.a = *a;
+	q.b = *b;
+	q.radius = radius;
+	q.list.contacts = contacts;
+	q.list.max = maxContacts;
+	q.list.num = 0;
+	forAllLeaves(this, &box, capsuleLeaf, &q);
+	return q.list.num;
+}
+
+// Slab test, returns entry distance or -1 if missed within maxT
+static float32
+rayBox(V3d start, V3d invDir, const BBox *b, float32 maxT)
+{
+	float32 t1 = (b->inf.x - start.x)*invDir.x;
+	float32 t2 = (b->sup.x - start.x)*invDir.x;
+	float32 tmin = t1 < t2 ? t1 : t2;
+	float32 tmax = t1 > t2 ? t1 : t2;
+	t1 = (b->inf.y - start.y)*invDir.y;
+	t2 = (b->sup.y - start.y)*invDir.y;
+	tmin = fmaxf(tmin, t1 < t2 ? t1 : t2);
+	tmax = fminf(tmax, t1 > t2 ? t1 : t2);
+	t1 = (b->inf.z - start.z)*invDir.z;
+	t2 = (b->sup.z - start.z)*invDir.z;
+	tmin = fmaxf(tmin, t1 < t2 ? t1 : t2);
+	tmax = fminf(tmax, t1 > t2 ? t1 : t2);
+	tmin = fmaxf(tmin, 0.0f);
+	return tmin <= tmax && tmin <= maxT ? tmin : -1.0f;
+}
+
+bool32
+CollisionTree::collideRay(const Ray *ray, float32 maxDist, CollisionContact *contact)
+{
+	CollisionStack st;
+	CollisionTriangle *hit = nil;
+	float32 best = maxDist;
+	V3d start = ray->start;
+	V3d dir = ray->dir;
+	V3d invDir;
+	invDir.x = dir.x != 0.0f ? 1.0f/dir.x : FLT_MAX;
+	invDir.y = dir.y != 0.0f ? 1.0f/dir.y : FLT_MAX;
+	invDir.z = dir.z != 0.0f ? 1.0f/dir.z : FLT_MAX;
+	if(this->numNodes == 0 || rayBox(start, invDir, &this->nodes[0].box, best) < 0.0f)
+		return 0;
+	st.init(this->depth);
+	st.push(0);
+	while(!st.empty()){
+		CollisionNode *n = &this->nodes[st.pop()];
+		if(n->count){
+			for(int32 i = 0; i < n->count; i++){
+				CollisionTriangle *t = &this->triangles[n->index+i];
+				V3d tri[3];
+				getTriangle(this, t, tri);
+				float32 d = rayTriangle(start, dir, tri[0], tri[1], tri[2], best);
+				if(d >= 0.0f){
+					best = d;
+					hit = t;
+				}
+			}
+			continue;
+		}
+		// push the far child first
+		float32 t0 = rayBox(start, invDir, &this->nodes[n->index].box, best);
+		float32 t1 = rayBox(start, invDir, &this->nodes[n->index+1].box, best);
+		int32 nearChild = n->index, farChild = n->index+1;
+		if(t1 >= 0.0f && (t0 < 0.0f || t1 < t0)){
+			int32 tmp = nearChild; nearChild = farChild; farChild = tmp;
+			float32 tt = t0; t0 = t1; t1 = tt;
+		}
+		if(t1 >= 0.0f)
+			st.push(farChild);
+		if(t0 >= 0.0f)
+			st.push(nearChild);
+	}
+	st.deinit();
+	if(hit == nil)
+		return 0;
+	V3d tri[3];
+	getTriangle(this, hit, tri);
+	contact->point = add(start, scale(dir, best));
+	contact->normal = faceNormal(tri);
+	if(dot(contact->normal, dir) > 0.0f)
+		contact->normal = neg(contact->normal);
+	contact->distance = best;
+	contact->triangle = hit->index;
+	contact->matId = hit->matId;
+	return 1;
+}
+
+//
+// World space queries against atomics
+//
+
+static CollisionTree*
+getAtomicTree(Atomic *atomic, Matrix *inv, float32 *scl)
+{
+	if(atomic->geometry == nil || atomic->getFrame() == nil)
+		return nil;
+	CollisionTree *tree = CollisionTree::get(atomic->geometry);
+	if(tree == nil)
+		return nil;
+	Matrix *ltm = atomic->getFrame()->getLTM();
+	Matrix::invert(inv, ltm);
+	*scl = length(ltm->right);
+	return tree;
+}
+
+static void
+contactsToWorld(Atomic *atomic, CollisionContact *contacts, int32 n, float32 scl)
+{
+	Matrix *ltm = atomic->getFrame()->getLTM();
+	for(int32 i = 0; i < n; i++){
+		CollisionContact *c = &contacts[i];
+		V3d::transformPoints(&c->point, &c->point, 1, ltm);
+		V3d::transformVectors(&c->normal, &c->normal, 1, ltm);
+		c->normal = normalize(c->normal);
+		c->distance *= scl;
+	}
+}
+
+int32
+CollisionTree::collideSphere(Atomic *atomic, const Sphere *s, CollisionContact *contacts, int32 maxContacts)
+{
+	Matrix inv;
+	float32 scl;
+	Sphere *ws = atomic->getWorldBoundingSphere();
+	V3d d = sub(ws->center, s->center);
+	float32 r = ws->radius + s->radius;
+	if(dot(d, d) > r*r)
+		return 0;
+	CollisionTree *tree = getAtomicTree(atomic, &inv, &scl);
+	if(tree == nil)
+		return 0;
+	Sphere os;
+	V3d::transformPoints(&os.center, &s->center, 1, &inv);
+	os.radius = s->radius/scl;
+	int32 n = tree->collideSphere(&os, contacts, maxContacts);
+	contactsToWorld(atomic, contacts, n, scl);
+	return n;
+}
+
+int32
+CollisionTree::collideCapsule(Atomic *atomic, const V3d *a, const V3d *b, float32 radius,
+	CollisionContact *contacts, int32 maxContacts)
+{
+	Matrix inv;
+	float32 scl;
+	CollisionTree *tree = getAtomicTree(atomic, &inv, &scl);
+	if(tree == nil)
+		return 0;
+	V3d oa, ob;
+	V3d::transformPoints(&oa, a, 1, &inv);
+	V3d::transformPoints(&ob, b, 1, &inv);
+	int32 n = tree->collideCapsule(&oa, &ob, radius/scl, contacts, maxContacts);
+	contactsToWorld(atomic, contacts, n, scl);
+	return n;
+}
+
+bool32
+CollisionTree::collideRay(Atomic *atomic, const Ray *ray, float32 maxDist, CollisionContact *contact)
+{
+	Matrix inv;
+	float32 scl;
+	CollisionTree *tree = getAtomicTree(atomic, &inv, &scl);
+	if(tree == nil)
+		return 0;
+	// object space segment, distance in [0,1] scales to maxDist
+	Ray r;
+	V3d seg[2];
+	seg[0] = ray->start;
+	seg[1] = add(ray->start, scale(ray->dir, maxDist));
+	V3d::transformPoints(seg, seg, 2, &inv);
+	r.start = seg[0];
+	r.dir = sub(seg[1], seg[0]);
+	if(!tree->collideRay(&r, 1.0f, contact))
+		return 0;
+	contactsToWorld(atomic, contact, 1, 1.0f);
+	contact->distance *= maxDist;
+	return 1;
+}
+
+//
+// Plugin
+//
+
+static void*
+createCollision(void *object, int32 offset, int32)
+{
+	CollisionData *cd = PLUGINOFFSET(CollisionData, object, offset);
+	cd->tree = nil;
+	cd->build = 0;
+	return object;
+}
+
+static void*
+destroyCollision(void *object, int32 offset, int32)
+{
+	CollisionData *cd = PLUGINOFFSET(CollisionData, object, offset);
+	rwFree(cd->tree);
+	cd->tree = nil;
+	return object;
+}
+
+static void*
+copyCollision(void *dst, void *src, int32 offset, int32)
+{
+	CollisionTree *srct = PLUGINOFFSET(CollisionData, src, offset)->tree;
+	if(srct == nil)
+		return dst;
+	CollisionTree *dstt = allocTree(srct->numVertices, srct->numTriangles, srct->numNodes);
+	dstt->depth = srct->depth;
+	memcpy(dstt->nodes, srct->nodes, srct->numNodes*sizeof(CollisionNode));
+	memcpy(dstt->vertices, srct->vertices, srct->numVertices*sizeof(V3d));
+	memcpy(dstt->triangles, srct->triangles, srct->numTriangles*sizeof(CollisionTriangle));
+	PLUGINOFFSET(CollisionData, dst, offset)->tree = dstt;
+	return dst;
+}
+
+// Checks all indices and recomputes the depth
+static bool32
+validTree(CollisionTree *t)
+{
+	int32 i;
+	for(i = 0; i < t->numTriangles; i++){
+		CollisionTriangle *tri = &t->triangles[i];
+		if(tri->v[0] >= (uint32)t->numVertices ||
+		   tri->v[1] >= (uint32)t->numVertices ||
+		   tri->v[2] >= (uint32)t->numVertices)
+			return 0;
+	}
+	if(t->numNodes == 0)
+		return t->numTriangles == 0;
+	// children always come after their parent and
+	// every node but the root is some node's child exactly once
+	int32 *depths = rwNewT(int32, t->numNodes, MEMDUR_FUNCTION | ID_COLLTREE);
+	uint8 *refs = rwNewT(uint8, t->numNodes, MEMDUR_FUNCTION | ID_COLLTREE);
+	memset(depths, 0, t->numNodes*sizeof(int32));
+	memset(refs, 0, t->numNodes);
+	bool32 valid = 1;
+	t->depth = 0;
+	for(i = 0; i < t->numNodes; i++){
+		CollisionNode *n = &t->nodes[i];
+		if((i > 0 && refs[i] != 1) ||
+		   n->count < 0 ||
+		   (n->count ? n->index < 0 || n->index + n->count > t->numTriangles
+		             : n->index <= i || n->index+1 >= t->numNodes ||
+		               refs[n->index] || refs[n->index+1])){
+			valid = 0;
+			break;
+		}
+		if(depths[i] > t->depth)
+			t->depth = depths[i];
+		if(n->count == 0){
+			refs[n->index] = refs[n->index+1] = 1;
+			depths[n->index] = depths[n->index+1] = depths[i]+1;
+		}
+	}
+	rwFree(refs);
+	rwFree(depths);
+	return valid;
+}
+
+static Stream*
+readCollision(Stream *stream, int32 length, void *object, int32 offset, int32)
+{
+	int32 i;
+	CollisionData *cd = PLUGINOFFSET(CollisionData, object, offset);
+	int32 numVertices = stream->readI32();
+	int32 numTriangles = stream->readI32();
+	int32 numNodes = stream->readI32();
+	if(numVertices < 0 || numTriangles < 0 || numNodes < 0 ||
+	   12 + numNodes*32 + numVertices*12 + numTriangles*20 != length){
+		RWERROR((ERR_GENERAL, "invalid collision tree, rebuilding"));
+		stream->seek(length - 12);
+		cd->build = 1;
+		return stream;
+	}
+	CollisionTree *t = allocTree(numVertices, numTriangles, numNodes);
+	for(i = 0; i < numNodes; i++){
+		CollisionNode *n = &t->nodes[i];
+		stream->read32(&n->box, sizeof(BBox));
+		n->index = stream->readI32();
+		n->count = stream->readI32();
+	}
+	stream->read32(t->vertices, numVertices*sizeof(V3d));
+	for(i = 0; i < numTriangles; i++){
+		CollisionTriangle *tri = &t->triangles[i];
+		stream->read32(tri->v, 12);
+		tri->index = stream->readI32();
+		tri->matId = stream->readI32();
+	}
+	rwFree(cd->tree);
+	cd->tree = nil;
+	if(validTree(t))
+		cd->tree = t;
+	else{
+		RWERROR((ERR_GENERAL, "invalid collision tree, rebuilding"));
+		rwFree(t);
+		cd->build = 1;
+	}
+	return stream;
+}
+
+static Stream*
+writeCollision(Stream *stream, int32, void *object, int32 offset, int32)
+{
+	int32 i;
+	CollisionTree *t = PLUGINOFFSET(CollisionData, object, offset)->tree;
+	stream->writeI32(t->numVertices);
+	stream->writeI32(t->numTriangles);
+	stream->writeI32(t->numNodes);
+	for(i = 0; i < t->numNodes; i++){
+		CollisionNode *n = &t->nodes[i];
+		stream->write32(&n->box, sizeof(BBox));
+		stream->writeI32(n->index);
+		stream->writeI32(n->count);
+	}
+	stream->write32(t->vertices, t->numVertices*sizeof(V3d));
+	for(i = 0; i < t->numTriangles; i++){
+		CollisionTriangle *tri = &t->triangles[i];
+		stream->write32(tri->v, 12);
+		stream->writeI32(tri->index);
+		stream->writeI32(tri->matId);
+	}
+	return stream;
+}
+
+static int32
+getSizeCollision(void *object, int32 offset, int32)
+{
+	CollisionTree *t = PLUGINOFFSET(CollisionData, object, offset)->tree;
+	if(t == nil)
+		return 0;
+	return 12 + t->numNodes*32 + t->numVertices*12 + t->numTriangles*20;
+}
+
+// RW's own collision data, only remember that there was some
+static Stream*
+readRWCollision(Stream *stream, int32 length, void *object, int32, int32)
+{
+	stream->seek(length);
+	GETCOLLDATA(object)->build = 1;
+	return stream;
+}
+
+static void
+collisionAlways(void *object, int32 offset, int32)
+{
+	Geometry *geo = (Geometry*)object;
+	CollisionData *cd = PLUGINOFFSET(CollisionData, object, offset);
+	if(cd->tree == nil && (cd->build || collisionGlobals.buildOnLoad))
+		CollisionTree::build(geo);
+	cd->build = 0;
+}
+
+void
+registerCollisionPlugin(void)
+{
+	collisionGlobals.geoOffset = Geometry::registerPlugin(sizeof(CollisionData), ID_COLLTREE,
+		createCollision, destroyCollision, copyCollision);
+	Geometry::registerPluginStream(ID_COLLTREE, readCollision, writeCollision, getSizeCollision);
+	Geometry::setStreamAlwaysCallback(ID_COLLTREE, collisionAlways);
+	Geometry::registerPlugin(0, ID_COLLISION, nil, nil, nil);
+	Geometry::registerPluginStream(ID_COLLISION, readRWCollision, nil, nil);
+}
+
+}
@@ -85,15 +85,24 @@ int vertFormatMap[] = {
 	-1, VERT_FLOAT2, VERT_FLOAT3, VERT_FLOAT4, VERT_ARGB, VERT_RGBA /* blend indices */
 };
 
+// per thread, the device is only used by the render thread
+static thread_local bool32 staging;
+
+void setStaging(bool32 b) { staging = b; }
+bool32 getStaging(void) { return staging; }
+
 void*
-createIndexBuffer(uint32 length, bool dynamic)
+createIndexBuffer(uint32 length, bool dynamic, bool index32)
 {
 #ifdef RW_D3D9
+	if(staging)
+		return rwNewT(uint8, length, MEMDUR_EVENT | ID_DRIVER);
 	IDirect3DIndexBuffer9 *ibuf;
+	D3DFORMAT format = index32 ? D3DFMT_INDEX32 : D3DFMT_INDEX16;
 	if(dynamic)
-		d3ddevice->CreateIndexBuffer(length, D3DUSAGE_WRITEONLY|D3DUSAGE_DYNAMIC, D3DFMT_INDEX16, D3DPOOL_DEFAULT, &ibuf, 0);
+		d3ddevice->CreateIndexBuffer(length, D3DUSAGE_WRITEONLY|D3DUSAGE_DYNAMIC, format, D3DPOOL_DEFAULT, &ibuf, 0);
 	else
-		d3ddevice->CreateIndexBuffer(length, D3DUSAGE_WRITEONLY, D3DFMT_INDEX16, D3DPOOL_MANAGED, &ibuf, 0);
+		d3ddevice->CreateIndexBuffer(length, D3DUSAGE_WRITEONLY, format, D3DPOOL_MANAGED, &ibuf, 0);
 	if(ibuf)
 		d3d9Globals.numIndexBuffers++;
 	return ibuf;
@@ -122,6 +131,8 @@ lockIndices(void *indexBuffer, uint32 offset, uint32 size, uint32 flags)
 	if(indexBuffer == nil)
 		return nil;
 #ifdef RW_D3D9
+	if(staging)
+		return (uint16*)indexBuffer;
 	uint16 *indices;
 	IDirect3DIndexBuffer9 *ibuf = (IDirect3DIndexBuffer9*)indexBuffer;
 	ibuf->Lock(offset, size, (void**)&indices, flags);
@@ -140,6 +151,8 @@ unlockIndices(void *indexBuffer)
 	if(indexBuffer == nil)
 		return;
 #ifdef RW_D3D9
+	if(staging)
+		return;
 	IDirect3DIndexBuffer9 *ibuf = (IDirect3DIndexBuffer9*)indexBuffer;
 	ibuf->Unlock();
 #endif
@@ -149,6 +162,8 @@ void*
 createVertexBuffer(uint32 length, uint32 fvf, bool dynamic)
 {
 #ifdef RW_D3D9
+	if(staging)
+		return rwNewT(uint8, length, MEMDUR_EVENT | ID_DRIVER);
 	IDirect3DVertexBuffer9 *vbuf;
 	if(dynamic)
 		d3ddevice->CreateVertexBuffer(length, D3DUSAGE_WRITEONLY|D3DUSAGE_DYNAMIC, fvf, D3DPOOL_DEFAULT, &vbuf, 0);
@@ -183,6 +198,8 @@ lockVertices(void *vertexBuffer, uint32 offset, uint32 size, uint32 flags)
 	if(vertexBuffer == nil)
 		return nil;
 #ifdef RW_D3D9
+	if(staging)
+		return (uint8*)vertexBuffer;
 	uint8 *verts;
 	IDirect3DVertexBuffer9 *vertbuf = (IDirect3DVertexBuffer9*)vertexBuffer;
 	vertbuf->Lock(offset, size, (void**)&verts, flags);
@@ -201,6 +218,8 @@ unlockVertices(void *vertexBuffer)
 	if(vertexBuffer == nil)
 		return;
 #ifdef RW_D3D9
+	if(staging)
+		return;
 	IDirect3DVertexBuffer9 *vertbuf = (IDirect3DVertexBuffer9*)vertexBuffer;
 	vertbuf->Unlock();
 #endif
@@ -10,6 +10,8 @@
 #include "../rwpipeline.h"
 #include "../rwobjects.h"
 #include "../rwengine.h"
+#include "../rwanim.h"
+#include "../rwplugins.h"
 #include "rwd3d.h"
 #include "rwd3d9.h"
 
@@ -71,12 +73,14 @@ void*
 createVertexDeclaration(VertexElement *elements)
 {
 #ifdef RW_D3D9
-	IDirect3DVertexDeclaration9 *decl = 0;
-	d3ddevice->CreateVertexDeclaration((D3DVERTEXELEMENT9*)elements, &decl);
-	if(decl)
-		d3d9Globals.numVertexDeclarations++;
-	return decl;
-#else
+	if(!getStaging()){
+		IDirect3DVertexDeclaration9 *decl = 0;
+		d3ddevice->CreateVertexDeclaration((D3DVERTEXELEMENT9*)elements, &decl);
+		if(decl)
+			d3d9Globals.numVertexDeclarations++;
+		return decl;
+	}
+#endif
 	int n = 0;
 	VertexElement *e = (VertexElement*)elements;
 	while(e[n++].stream != 0xFF)
@@ -84,7 +88,6 @@ createVertexDeclaration(VertexElement *elements)
 	e = rwNewT(VertexElement, n, MEMDUR_EVENT | ID_DRIVER);
 	memcpy(e, elements, n*sizeof(VertexElement));
 	return e;
-#endif
 }
 
 void
@@ -172,12 +175,14 @@ readNativeData(Stream *stream, int32, void *object, int32, int32)
 	header->serialNumber = *(uint32*)p; p += 4;
 	header->numMeshes = *(uint32*)p; p += 4;
 	header->indexBuffer = nil; p += 4;
+	header->index32 = 0;
 	header->primType = *(uint32*)p; p += 4;
 	p += 16*2;	// skip vertex streams, they're repeated with the vertex buffers
 	header->useOffsets = *(bool32*)p; p += 4;
 	header->vertexDeclaration = nil; p += 4;
 	header->totalNumIndex = *(uint32*)p; p += 4;
 	header->totalNumVertex = *(uint32*)p; p += 4;
+	header->morphSerial = 0;
 	header->inst = rwNewT(InstanceData, header->numMeshes, MEMDUR_EVENT | ID_GEOMETRY);
 
 	InstanceData *inst = header->inst;
@@ -250,6 +255,8 @@ writeNativeData(Stream *stream, int32 len, void *object, int32, int32)
 		return stream;
 	stream->writeU32(PLATFORM_D3D9);
 	InstanceDataHeader *header = (InstanceDataHeader*)geometry->instData;
+	// the native format only has 16 bit indices
+	assert(!header->index32);
 	int32 size = 64 + geometry->meshHeader->numMeshes*36;
 	uint8 *data = rwNewT(uint8, size, MEMDUR_FUNCTION | ID_GEOMETRY);
 	stream->writeI32(size);
@@ -355,17 +362,36 @@ instanceMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
 	header->vertexDeclaration = nil;
 	header->totalNumVertex = geo->numVertices;
 	header->totalNumIndex = meshh->totalIndices;
+	header->morphSerial = 0;
 	header->inst = rwNewT(InstanceData, header->numMeshes, MEMDUR_EVENT | ID_GEOMETRY);
 
-	header->indexBuffer = createIndexBuffer(header->totalNumIndex*2, false);
-
-	uint16 *indices = lockIndices(header->indexBuffer, 0, 0, 0);
+	// Indices are relative to baseIndex, so even with 32 bit
+	// mesh indices we can usually get away with 16 bits.
 	InstanceData *inst = header->inst;
 	Mesh *mesh = meshh->getMeshes();
+	header->index32 = 0;
+	for(uint32 i = 0; i < header->numMeshes; i++){
+		if(meshh->index32)
+			findMinVertAndNumVertices(mesh->indices32, mesh->numIndices,
+			                          &inst->minVert, (int32*)&inst->numVertices);
+		else
+			findMinVertAndNumVertices(mesh->indices, mesh->numIndices,
+			                          &inst->minVert, (int32*)&inst->numVertices);
+		if(inst->numVertices > 0x10000)
+			header->index32 = 1;
+		mesh++;
+		inst++;
+	}
+
+	header->indexBuffer = createIndexBuffer(header->totalNumIndex*(header->index32 ? 4 : 2),
+		false, !!header->index32);
+
+	uint16 *indices = lockIndices(header->indexBuffer, 0, 0, 0);
+	uint32 *indices32 = (uint32*)indices;
+	inst = header->inst;
+	mesh = meshh->getMeshes();
 	uint32 startindex = 0;
 	for(uint32 i = 0; i < header->numMeshes; i++){
-		findMinVertAndNumVertices(mesh->indices, mesh->numIndices,
-		                          &inst->minVert, (int32*)&inst->numVertices);
 		inst->numIndex = mesh->numIndices;
 		inst->material = mesh->material;
 		inst->vertexAlpha = 0;
@@ -373,11 +399,14 @@ instanceMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
 		inst->baseIndex = inst->minVert;
 		inst->startIndex = startindex;
 		inst->numPrimitives = header->primType == D3DPT_TRIANGLESTRIP ? inst->numIndex-2 : inst->numIndex/3;
-		if(inst->minVert == 0)
+		if(header->index32)
+			for(uint32 j = 0; j < inst->numIndex; j++)
+				indices32[inst->startIndex+j] = mesh->getIndex(j) - inst->minVert;
+		else if(inst->minVert == 0 && !meshh->index32)
 			memcpy(&indices[inst->startIndex], mesh->indices, inst->numIndex*2);
 		else
 			for(uint32 j = 0; j < inst->numIndex; j++)
-				indices[inst->startIndex+j] = mesh->indices[j] - inst->minVert;
+				indices[inst->startIndex+j] = mesh->getIndex(j) - inst->minVert;
 		startindex += inst->numIndex;
 		mesh++;
 		inst++;
@@ -389,6 +418,34 @@ instanceMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
 	return header;
 }
 
+// Positions and normals of the atomic's morph blend,
+// only written when the blend is a different one.
+static void
+instanceMorph(Atomic *atomic, InstanceDataHeader *header)
+{
+	VertexElement dcl[NUMDECLELT];
+	MorphAtomic *m = Morph::get(atomic);
+	if(header->morphSerial == m->serial)
+		return;
+	getDeclaration(header->vertexDeclaration, dcl);
+	uint8 *verts = lockVertices(header->vertexStream[0].vertexBuffer, 0, 0, D3DLOCK_NOSYSLOCK);
+	for(int i = 0; dcl[i].stream != 0xFF; i++){
+		V3d *src;
+		if(dcl[i].stream != 0 || dcl[i].usageIndex != 0)
+			continue;
+		if(dcl[i].usage == D3DDECLUSAGE_POSITION)
+			src = Morph::getVertices(atomic);
+		else if(dcl[i].usage == D3DDECLUSAGE_NORMAL)
+			src = Morph::getNormals(atomic);
+		else
+			continue;
+		instV3d(vertFormatMap[dcl[i].type], verts + dcl[i].offset, src,
+			header->totalNumVertex, header->vertexStream[0].stride);
+	}
+	unlockVertices(header->vertexStream[0].vertexBuffer);
+	header->morphSerial = m->serial;
+}
+
 static void
 instance(rw::ObjPipeline *rwpipe, Atomic *atomic)
 {
@@ -412,10 +469,85 @@ instance(rw::ObjPipeline *rwpipe, Atomic *atomic)
 	if(geo->instData == nil){
 		geo->instData = instanceMesh(rwpipe, geo);
 		pipe->instanceCB(geo, (InstanceDataHeader*)geo->instData, 0);
-	}else if(geo->lockedSinceInst)
+	}else if(geo->lockedSinceInst){
+		if(geo->lockedSinceInst & (Geometry::LOCKVERTICES|Geometry::LOCKNORMALS))
+			((InstanceDataHeader*)geo->instData)->morphSerial = 0;
 		pipe->instanceCB(geo, (InstanceDataHeader*)geo->instData, 1);
+	}
 
 	geo->lockedSinceInst = 0;
+
+	if(morphGlobals.atomicOffset)
+		instanceMorph(atomic, (InstanceDataHeader*)geo->instData);
+}
+
+// instanceMesh and instanceCB with staging buffers in plain memory,
+// the instanceCB must not use the device other than through them
+static rw::InstanceDataHeader*
+prepareInstance(rw::ObjPipeline *rwpipe, Atomic *atomic)
+{
+	ObjPipeline *pipe = (ObjPipeline*)rwpipe;
+	Geometry *geo = atomic->geometry;
+	if(pipe->instanceCB == nil || geo->instData ||
+	   (geo->flags & Geometry::NATIVE))
+		return nil;
+	setStaging(1);
+	InstanceDataHeader *header = instanceMesh(rwpipe, geo);
+	pipe->instanceCB(geo, header, 0);
+	setStaging(0);
+	return header;
+}
+
+static void
+freeStaged(InstanceDataHeader *header)
+{
+	rwFree(header->vertexDeclaration);
+	rwFree(header->indexBuffer);
+	rwFree(header->vertexStream[0].vertexBuffer);
+	rwFree(header->vertexStream[1].vertexBuffer);
+	rwFree(header->inst);
+	rwFree(header);
+}
+
+#ifdef RW_D3D9
+static void*
+uploadVertices(void *staged, uint32 length)
+{
+	void *vertexBuffer = createVertexBuffer(length, 0, false);
+	memcpy(lockVertices(vertexBuffer, 0, 0, D3DLOCK_NOSYSLOCK), staged, length);
+	unlockVertices(vertexBuffer);
+	rwFree(staged);
+	return vertexBuffer;
+}
+#endif
+
+// Replaces the staging buffers by device objects, on the render thread
+static void
+uploadInstance(rw::ObjPipeline *rwpipe, Geometry *geo, rw::InstanceDataHeader *rwheader)
+{
+	InstanceDataHeader *header = (InstanceDataHeader*)rwheader;
+	if(geo->instData){
+		// prepared twice or instanced since
+		freeStaged(header);
+		return;
+	}
+#ifdef RW_D3D9
+	uint32 length = header->totalNumIndex*(header->index32 ? 4 : 2);
+	void *indexBuffer = createIndexBuffer(length, false, !!header->index32);
+	memcpy(lockIndices(indexBuffer, 0, 0, 0), header->indexBuffer, length);
+	unlockIndices(indexBuffer);
+	rwFree(header->indexBuffer);
+	header->indexBuffer = indexBuffer;
+	for(int32 i = 0; i < 2; i++){
+		VertexStream *s = &header->vertexStream[i];
+		if(s->vertexBuffer)
+			s->vertexBuffer = uploadVertices(s->vertexBuffer, s->stride*header->totalNumVertex);
+	}
+	void *declaration = header->vertexDeclaration;
+	header->vertexDeclaration = createVertexDeclaration((VertexElement*)declaration);
+	rwFree(declaration);
+#endif
+	geo->instData = header;
 }
 
 static void
@@ -433,14 +565,18 @@ uninstance(rw::ObjPipeline *rwpipe, Atomic *atomic)
 
 	InstanceDataHeader *header = (InstanceDataHeader*)geo->instData;
 	uint16 *indices = lockIndices(header->indexBuffer, 0, 0, 0);
+	uint32 *indices32 = (uint32*)indices;
 	InstanceData *inst = header->inst;
 	Mesh *mesh = geo->meshHeader->getMeshes();
 	for(uint32 i = 0; i < header->numMeshes; i++){
-		if(inst->minVert == 0)
+		if(header->index32)
+			for(uint32 j = 0; j < inst->numIndex; j++)
+				mesh->setIndex(j, indices32[inst->startIndex+j] + inst->minVert);
+		else if(inst->minVert == 0 && mesh->indices)
 			memcpy(mesh->indices, &indices[inst->startIndex], inst->numIndex*2);
 		else
 			for(uint32 j = 0; j < inst->numIndex; j++)
-				mesh->indices[j] = indices[inst->startIndex+j] + inst->minVert;
+				mesh->setIndex(j, indices[inst->startIndex+j] + inst->minVert);
 		mesh++;
 		inst++;
 	}
@@ -471,6 +607,8 @@ ObjPipeline::init(void)
 	this->impl.instance = d3d9::instance;
 	this->impl.uninstance = d3d9::uninstance;
 	this->impl.render = d3d9::render;
+	this->impl.prepareInstance = d3d9::prepareInstance;
+	this->impl.uploadInstance = d3d9::uploadInstance;
 	this->instanceCB = nil;
 	this->uninstanceCB = nil;
 	this->renderCB = nil;
@@ -255,7 +255,7 @@ enum {
 
 extern int vertFormatMap[];
 
-void *createIndexBuffer(uint32 length, bool dynamic);
+void *createIndexBuffer(uint32 length, bool dynamic, bool index32 = false);
 void destroyIndexBuffer(void *indexBuffer);
 uint16 *lockIndices(void *indexBuffer, uint32 offset, uint32 size, uint32 flags);
 void unlockIndices(void *indexBuffer);
@@ -265,6 +265,11 @@ void destroyVertexBuffer(void *vertexBuffer);
 uint8 *lockVertices(void *vertexBuffer, uint32 offset, uint32 size, uint32 flags);
 void unlockVertices(void *vertexBuffer);
 
+// While set on a thread the functions above and createVertexDeclaration
+// only use plain memory there, for prepareInstance; default: false
+void setStaging(bool32 b);
+bool32 getStaging(void);
+
 void *createTexture(int32 width, int32 height, int32 levels, uint32 usage, uint32 format);
 void destroyTexture(void *texture);
 uint8 *lockTexture(void *texture, int32 level);
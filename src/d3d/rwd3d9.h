@@ -41,12 +41,14 @@ struct InstanceDataHeader : rw::InstanceDataHeader
 	uint32  serialNumber;
 	uint32  numMeshes;
 	void   *indexBuffer;
+	bool32  index32;	// only when a mesh spans more than 64k vertices
 	uint32  primType;
 	VertexStream vertexStream[2];
 	bool32  useOffsets;
 	void   *vertexDeclaration;
 	uint32  totalNumIndex;
 	uint32  totalNumVertex;
+	uint32  morphSerial;	// of the morph blend in the vertex buffer
 
 	InstanceData *inst;
 };
@@ -76,6 +78,8 @@ public:
 	void init(void);
 	static ObjPipeline *create(void);
 
+	// also runs off the render thread for prepareInstance, so it may only
+	// use the device through the buffer and declaration functions
 	void (*instanceCB)(Geometry *geo, InstanceDataHeader *header, bool32 reinstance);
 	void (*uninstanceCB)(Geometry *geo, InstanceDataHeader *header);
 	void (*renderCB)(Atomic *atomic, InstanceDataHeader *header);
@@ -23,6 +23,16 @@ PluginList Material::s_plglist(sizeof(Material));
 
 static SurfaceProperties defaultSurfaceProps = { 1.0f, 1.0f, 1.0f };
 
+static BBox
+sphereBox(const Sphere *s)
+{
+	BBox box;
+	V3d r = { s->radius, s->radius, s->radius };
+	box.inf = sub(s->center, r);
+	box.sup = add(s->center, r);
+	return box;
+}
+
 // We allocate twice because we have to allocate the data separately for uninstancing
 Geometry*
 Geometry::create(int32 numVerts, int32 numTris, uint32 flags)
@@ -41,23 +51,30 @@ Geometry::create(int32 numVerts, int32 numTris, uint32 flags)
 		                       (geo->flags & TEXTURED2) ? 2 : 0;
 	geo->numTriangles = numTris;
 	geo->numVertices = numVerts;
+	if(numVerts > 0xFFFF && !(geo->flags & NATIVE))
+		geo->flags |= INDEX32;
 
 	geo->colors = nil;
 	for(int32 i = 0; i < 8; i++)
 		geo->texCoords[i] = nil;
 	geo->triangles = nil;
+	geo->triangles32 = nil;
 	// Allocate all attributes at once. The triangle pointer
 	// will hold the first address (even when there are no triangles)
 	// so we can free easily.
 	if(!(geo->flags & NATIVE)){
-		int32 sz = geo->numTriangles*sizeof(Triangle);
+		int32 trisz = geo->flags & INDEX32 ? sizeof(Triangle32) : sizeof(Triangle);
+		int32 sz = geo->numTriangles*trisz;
 		if(geo->flags & PRELIT)
 			sz += geo->numVertices*sizeof(RGBA);
 		sz += geo->numTexCoordSets*geo->numVertices*sizeof(TexCoords);
 
 		uint8 *data = (uint8*)rwNew(sz, MEMDUR_EVENT | ID_GEOMETRY);
-		geo->triangles = (Triangle*)data;
-		data += geo->numTriangles*sizeof(Triangle);
+		if(geo->flags & INDEX32)
+			geo->triangles32 = (Triangle32*)data;
+		else
+			geo->triangles = (Triangle*)data;
+		data += geo->numTriangles*trisz;
 		if(geo->flags & PRELIT && geo->numVertices){
 			geo->colors = (RGBA*)data;
 			data += geo->numVertices*sizeof(RGBA);
@@ -70,7 +87,7 @@ Geometry::create(int32 numVerts, int32 numTris, uint32 flags)
 
 		// init triangles
 		for(int32 i = 0; i < geo->numTriangles; i++)
-			geo->triangles[i].matId = 0xFFFF;
+			geo->setTriMatId(i, 0xFFFF);
 	}
 	geo->numMorphTargets = 0;
 	geo->morphTargets = nil;
@@ -80,6 +97,8 @@ Geometry::create(int32 numVerts, int32 numTris, uint32 flags)
 	geo->lockedSinceInst = 0;
 	geo->meshHeader = nil;
 	geo->instData = nil;
+	geo->shareEntry = nil;
+	geo->triangleBVH = nil;
 	geo->refCount = 1;
 
 	s_plglist.construct(geo);
@@ -91,9 +110,11 @@ Geometry::destroy(void)
 {
 	this->refCount--;
 	if(this->refCount <= 0){
+		this->unshare();
+		this->removeTriangleBVH();
 		s_plglist.destruct(this);
 		// Also frees colors and tex coords
-		rwFree(this->triangles);
+		rwFree(this->triangles32 ? (void*)this->triangles32 : this->triangles);
 		// Also frees their data
 		rwFree(this->morphTargets);
 		// Also frees indices
@@ -108,6 +129,10 @@ void
 Geometry::lock(int32 lockFlags)
 {
 	lockedSinceInst |= lockFlags;
+	// no longer what was streamed in
+	this->unshare();
+	if(lockFlags & (LOCKPOLYGONS | LOCKVERTICES))
+		this->removeTriangleBVH();
 	if(lockFlags & LOCKPOLYGONS){
 		rwFree(this->meshHeader);
 		this->meshHeader = nil;
@@ -130,6 +155,48 @@ struct GeoStreamData
 	int32 numMorphTargets;
 };
 
+// Read all triangles at once and unpack them in place.
+// The stream has two words per triangle: v0<<16 | v1 and v2<<16 | matId.
+// With INDEX32 the upper halves come in a separate chunk.
+static void
+readTriangles(Stream *stream, Geometry *geo)
+{
+	int32 i;
+	int32 n = geo->numTriangles;
+	if(geo->triangles32){
+		// read into the upper half so we never overwrite
+		// words we haven't unpacked yet
+		uint32 *src = (uint32*)(geo->triangles32 + n) - 2*n;
+		stream->read32(src, 8*n);
+		Triangle32 *dst = geo->triangles32;
+		for(i = 0; i < n; i++){
+			uint32 w0 = src[0];
+			uint32 w1 = src[1];
+			dst->v[0] = w0 >> 16;
+			dst->v[1] = w0 & 0xFFFF;
+			dst->v[2] = w1 >> 16;
+			dst->matId = w1 & 0xFFFF;
+			dst->pad = 0;
+			src += 2;
+			dst++;
+		}
+	}else{
+		uint32 *src = (uint32*)geo->triangles;
+		stream->read32(src, 8*n);
+		Triangle *dst = geo->triangles;
+		for(i = 0; i < n; i++){
+			uint32 w0 = src[0];
+			uint32 w1 = src[1];
+			dst->v[0] = w0 >> 16;
+			dst->v[1] = w0 & 0xFFFF;
+			dst->v[2] = w1 >> 16;
+			dst->matId = w1 & 0xFFFF;
+			src += 2;
+			dst++;
+		}
+	}
+}
+
 Geometry*
 Geometry::streamRead(Stream *stream)
 {
@@ -158,14 +225,7 @@ Geometry::streamRead(Stream *stream)
 		for(int32 i = 0; i < geo->numTexCoordSets; i++)
 			stream->read32(geo->texCoords[i],
 				    2*geo->numVertices*4);
-		for(int32 i = 0; i < geo->numTriangles; i++){
-			uint32 tribuf[2];
-			stream->read32(tribuf, 8);
-			geo->triangles[i].v[0]  = tribuf[0] >> 16;
-			geo->triangles[i].v[1]  = tribuf[0];
-			geo->triangles[i].v[2]  = tribuf[1] >> 16;
-			geo->triangles[i].matId = tribuf[1];
-		}
+		readTriangles(stream, geo);
 	}
 
 	for(int32 i = 0; i < geo->numMorphTargets; i++){
@@ -177,6 +237,8 @@ Geometry::streamRead(Stream *stream)
 			stream->read32(m->vertices, 3*geo->numVertices*4);
 		if(hasNormals)
 			stream->read32(m->normals, 3*geo->numVertices*4);
+		m->boundingBox = hasVertices ? m->calculateBoundingBox() :
+			sphereBox(&m->boundingSphere);
 	}
 
 	if(!findChunk(stream, ID_MATLIST, nil, nil)){
@@ -235,7 +297,7 @@ Geometry::streamWrite(Stream *stream)
 	writeChunkHeader(stream, ID_GEOMETRY, this->streamGetSize());
 	writeChunkHeader(stream, ID_STRUCT, geoStructSize(this));
 
-	buf.flags = this->flags | this->numTexCoordSets << 16;
+	buf.flags = (this->flags & ~INDEX32) | this->numTexCoordSets << 16;
 	buf.numTriangles = this->numTriangles;
 	buf.numVertices = this->numVertices;
 	buf.numMorphTargets = this->numMorphTargets;
@@ -251,10 +313,10 @@ Geometry::streamWrite(Stream *stream)
 				    2*this->numVertices*4);
 		for(int32 i = 0; i < this->numTriangles; i++){
 			uint32 tribuf[2];
-			tribuf[0] = this->triangles[i].v[0] << 16 |
-			            this->triangles[i].v[1];
-			tribuf[1] = this->triangles[i].v[2] << 16 |
-			            this->triangles[i].matId;
+			tribuf[0] = this->getTriVertex(i, 0) << 16 |
+			            (this->getTriVertex(i, 1) & 0xFFFF);
+			tribuf[1] = this->getTriVertex(i, 2) << 16 |
+			            this->getTriMatId(i);
 			stream->write32(tribuf, 8);
 		}
 	}
@@ -314,9 +376,10 @@ Geometry::addMorphTargets(int32 n)
 		mts = (MorphTarget*)rwResize(this->morphTargets, n*sz, MEMDUR_EVENT | ID_GEOMETRY);
 		this->morphTargets = mts;
 		// Since we now have more morph targets than before, move the vertex data up
-		uint8 *src = (uint8*)mts + sz*this->numMorphTargets;
-		uint8 *dst = (uint8*)mts + sz*n;
+		// so it starts right after the new MorphTarget array
 		uint32 len = (sz-sizeof(MorphTarget))*this->numMorphTargets;
+		uint8 *src = (uint8*)mts + sz*this->numMorphTargets;
+		uint8 *dst = (uint8*)&mts[n] + len;
 		while(len--)
 			*--dst = *--src;
 	}else{
@@ -335,6 +398,8 @@ Geometry::addMorphTargets(int32 n)
 			mts->boundingSphere.center.y = 0.0f;
 			mts->boundingSphere.center.z = 0.0f;
 			mts->boundingSphere.radius = 0.0f;
+			mts->boundingBox.inf = mts->boundingSphere.center;
+			mts->boundingBox.sup = mts->boundingSphere.center;
 		}
 		if(!(this->flags & NATIVE) && this->numVertices){
 			mts->vertices = data;
@@ -355,6 +420,7 @@ Geometry::calculateBoundingSphere(void)
 	for(int32 i = 0; i < this->numMorphTargets; i++){
 		MorphTarget *m = &this->morphTargets[i];
 		m->boundingSphere = m->calculateBoundingSphere();
+		m->boundingBox = m->calculateBoundingBox();
 	}
 }
 
@@ -376,16 +442,22 @@ Geometry::allocateData(void)
 {
 	// Geometry data
 	// Pretty much copy pasted from ::create above
-	int32 sz = this->numTriangles*sizeof(Triangle);
+	int32 trisz = this->flags & INDEX32 ? sizeof(Triangle32) : sizeof(Triangle);
+	int32 sz = this->numTriangles*trisz;
 	if(this->flags & PRELIT)
 		sz += this->numVertices*sizeof(RGBA);
 	sz += this->numTexCoordSets*this->numVertices*sizeof(TexCoords);
 
 	uint8 *data = (uint8*)rwNew(sz, MEMDUR_EVENT | ID_GEOMETRY);
-	this->triangles = (Triangle*)data;
-	data += this->numTriangles*sizeof(Triangle);
+	this->triangles = nil;
+	this->triangles32 = nil;
+	if(this->flags & INDEX32)
+		this->triangles32 = (Triangle32*)data;
+	else
+		this->triangles = (Triangle*)data;
+	data += this->numTriangles*trisz;
 	for(int32 i = 0; i < this->numTriangles; i++)
-		this->triangles[i].matId = 0xFFFF;
+		this->setTriMatId(i, 0xFFFF);
 	if(this->flags & PRELIT){
 		this->colors = (RGBA*)data;
 		data += this->numVertices*sizeof(RGBA);
@@ -421,12 +493,31 @@ Geometry::allocateData(void)
 	}
 }
 
+void
+Geometry::setTriangle(int32 i, uint32 v0, uint32 v1, uint32 v2, uint16 matId)
+{
+	if(this->triangles32){
+		Triangle32 *t = &this->triangles32[i];
+		t->v[0] = v0;
+		t->v[1] = v1;
+		t->v[2] = v2;
+		t->matId = matId;
+	}else{
+		Triangle *t = &this->triangles[i];
+		t->v[0] = v0;
+		t->v[1] = v1;
+		t->v[2] = v2;
+		t->matId = matId;
+	}
+}
+
 static int
-isDegenerate(uint16 *idx)
+isDegenerate(Mesh *m, uint32 j)
 {
-	return idx[0] == idx[1] ||
-	       idx[0] == idx[2] ||
-	       idx[1] == idx[2];
+	uint32 a = m->getIndex(j);
+	uint32 b = m->getIndex(j+1);
+	uint32 c = m->getIndex(j+2);
+	return a == b || a == c || b == c;
 }
 
 // This functions assumes there is enough space allocated
@@ -451,7 +542,7 @@ Geometry::generateTriangles(int8 *adc)
 		if(header->flags == MeshHeader::TRISTRIP){
 			for(uint32 j = 0; j < m->numIndices-2; j++){
 				if(!(adc && adcbits[j+2]) &&
-				   !isDegenerate(&m->indices[j]))
+				   !isDegenerate(m, j))
 					this->numTriangles++;
 			}
 		}else
@@ -460,7 +551,7 @@ Geometry::generateTriangles(int8 *adc)
 		m++;
 	}
 
-	Triangle *tri = this->triangles;
+	int32 tri = 0;
 	m = header->getMeshes();
 	adcbits = adc;
 	for(uint32 i = 0; i < header->numMeshes; i++){
@@ -473,22 +564,19 @@ Geometry::generateTriangles(int8 *adc)
 		if(header->flags == MeshHeader::TRISTRIP)
 			for(uint32 j = 0; j < m->numIndices-2; j++){
 				if((adc && adcbits[j+2]) ||
-				   isDegenerate(&m->indices[j]))
+				   isDegenerate(m, j))
 					continue;
-				tri->v[0] = m->indices[j+0];
-				tri->v[1] = m->indices[j+1 + (j%2)];
-				tri->v[2] = m->indices[j+2 - (j%2)];
-				tri->matId = matid;
-				tri++;
+				this->setTriangle(tri++,
+					m->getIndex(j+0),
+					m->getIndex(j+1 + (j%2)),
+					m->getIndex(j+2 - (j%2)), matid);
 			}
 		else
-			for(uint32 j = 0; j < m->numIndices-2; j+=3){
-				tri->v[0] = m->indices[j+0];
-				tri->v[1] = m->indices[j+1];
-				tri->v[2] = m->indices[j+2];
-				tri->matId = matid;
-				tri++;
-			}
+			for(uint32 j = 0; j < m->numIndices-2; j+=3)
+				this->setTriangle(tri++,
+					m->getIndex(j+0),
+					m->getIndex(j+1),
+					m->getIndex(j+2), matid);
 		adcbits += m->numIndices;
 		m++;
 	}
@@ -513,7 +601,6 @@ dumpMesh(Mesh *m)
 void
 Geometry::buildMeshes(void)
 {
-	Triangle *tri;
 	Mesh *mesh;
 
 	if(this->flags & Geometry::NATIVE){
@@ -524,17 +611,17 @@ Geometry::buildMeshes(void)
 	rwFree(this->meshHeader);
 	this->meshHeader = nil;
 	int32 numMeshes = this->matList.numMaterials;
-	if((this->flags & Geometry::TRISTRIP) == 0){
+	// the tristripper only knows 16 bit indices
+	if((this->flags & Geometry::TRISTRIP) == 0 ||
+	   this->flags & Geometry::INDEX32){
 		int32 *numIndices = rwNewT(int32, numMeshes,
 			MEMDUR_FUNCTION | ID_GEOMETRY);
 		memset(numIndices, 0, numMeshes*sizeof(int32));
 
 		// count indices per mesh
-		tri = this->triangles;
 		for(int32 i = 0; i < this->numTriangles; i++){
-			assert(tri->matId < numMeshes);
-			numIndices[tri->matId] += 3;
-			tri++;
+			assert(this->getTriMatId(i) < numMeshes);
+			numIndices[this->getTriMatId(i)] += 3;
 		}
 		// setup meshes
 		this->allocateMeshes(numMeshes, this->numTriangles*3, 0);
@@ -549,14 +636,15 @@ Geometry::buildMeshes(void)
 		// now fill in the indices
 		for(int32 i = 0; i < numMeshes; i++)
 			mesh[i].numIndices = 0;
-		tri = this->triangles;
 		for(int32 i = 0; i < this->numTriangles; i++){
-			uint32 idx = mesh[tri->matId].numIndices;
-			mesh[tri->matId].indices[idx++] = tri->v[0];
-			mesh[tri->matId].indices[idx++] = tri->v[1];
-			mesh[tri->matId].indices[idx++] = tri->v[2];
-			mesh[tri->matId].numIndices = idx;
-			tri++;
+			Mesh *m = &mesh[this->getTriMatId(i)];
+			m->setIndex(m->numIndices++, this->getTriVertex(i, 0));
+			m->setIndex(m->numIndices++, this->getTriVertex(i, 1));
+			m->setIndex(m->numIndices++, this->getTriVertex(i, 2));
+		}
+		if(getVertexCacheOptimization()){
+			this->optimizeVertexCache();
+			this->optimizeVertexFetch();
 		}
 	}else
 		this->buildTristrips();
@@ -570,7 +658,7 @@ Geometry::correctTristripWinding(void)
 {
 	MeshHeader *header = this->meshHeader;
 	if(this->flags & NATIVE || header == nil ||
-	   header->flags != MeshHeader::TRISTRIP)
+	   header->flags != MeshHeader::TRISTRIP || header->index32)
 		return;
 	this->meshHeader = nil;
 	// Allocate no indices, we realloc later
@@ -628,7 +716,7 @@ Geometry::removeUnusedMaterials(void)
 	MeshHeader *mh = this->meshHeader;
 	Mesh *m = mh->getMeshes();
 	for(uint32 i = 0; i < mh->numMeshes; i++)
-		if(m[i].indices == nil)
+		if(m[i].indices == nil && m[i].indices32 == nil)
 			return;
 
 	int32 *map = rwNewT(int32, this->matList.numMaterials,
@@ -671,40 +759,131 @@ Geometry::removeUnusedMaterials(void)
 	for(uint32 i = 0; i < mh->numMeshes; i++){
 		if(m[i].numIndices <= 0)
 			continue;
-		memcpy(newm->indices, m[i].indices,
-		       m[i].numIndices*sizeof(*m[i].indices));
+		if(newmh->index32 == mh->index32)
+			memcpy(newmh->index32 ? (void*)newm->indices32 : newm->indices,
+			       mh->index32 ? (void*)m[i].indices32 : m[i].indices,
+			       m[i].numIndices*(mh->index32 ? 4 : 2));
+		else
+			for(uint32 j = 0; j < m[i].numIndices; j++)
+				newm->setIndex(j, m[i].getIndex(j));
 		newm++;
 	}
 	rwFree(mh);
 
 	/* Remap triangle material IDs */
 	for(int32 i = 0; i < this->numTriangles; i++)
-		this->triangles[i].matId = map[this->triangles[i].matId];
+		this->setTriMatId(i, map[this->getTriMatId(i)]);
 	rwFree(map);
 }
 
+// Grow the sphere just enough to include all points
+static void
+growSphere(Sphere *s, V3d *v, int32 n, int32 step)
+{
+	float32 r2 = s->radius*s->radius;
+	int32 j = 0;
+	for(int32 i = 0; i < n; i++){
+		V3d d = sub(v[j], s->center);
+		float32 d2 = dot(d, d);
+		if(d2 > r2){
+			float32 dist = sqrtf(d2);
+			float32 r = (s->radius + dist)*0.5f;
+			s->center = add(s->center, scale(d, (r - s->radius)/dist));
+			s->radius = r;
+			r2 = r*r;
+		}
+		// visit points in a different order each pass
+		j += step;
+		if(j >= n) j -= n;
+	}
+}
+
+static int32
+gcd(int32 a, int32 b)
+{
+	while(b){
+		int32 t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+// Ritter's sphere from the most distant pair of extremes along
+// the axes and diagonals, then shrunk and regrown a few times
+// (Larsson's iterative Ritter).
+// Usually within a few percent of the minimal sphere.
 Sphere
 MorphTarget::calculateBoundingSphere(void) const
 {
+	static int32 steps[] = { 7919, 104729, 1299709, 15485863 };
+	static V3d dirs[7] = {
+		{ 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+		{ 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, -1.0f },
+		{ 1.0f, -1.0f, 1.0f }, { 1.0f, -1.0f, -1.0f }
+	};
 	Sphere sphere;
-	V3d min = {  1000000.0f,  1000000.0f,  1000000.0f };
-	V3d max = { -1000000.0f, -1000000.0f, -1000000.0f };
 	V3d *v = this->vertices;
-	for(int32 j = 0; j < this->parent->numVertices; j++){
-		if(v->x > max.x) max.x = v->x;
-		if(v->x < min.x) min.x = v->x;
-		if(v->y > max.y) max.y = v->y;
-		if(v->y < min.y) min.y = v->y;
-		if(v->z > max.z) max.z = v->z;
-		if(v->z < min.z) min.z = v->z;
-		v++;
+	int32 n = this->parent->numVertices;
+	int32 i, j;
+
+	sphere.center.set(0.0f, 0.0f, 0.0f);
+	sphere.radius = 0.0f;
+	if(v == nil || n == 0)
+		return sphere;
+
+	int32 minv[7], maxv[7];
+	float32 mind[7], maxd[7];
+	for(j = 0; j < 7; j++){
+		minv[j] = maxv[j] = 0;
+		mind[j] = maxd[j] = dot(v[0], dirs[j]);
 	}
-	sphere.center = scale(add(min, max), 1/2.0f);
-	max = sub(max, sphere.center);
-	sphere.radius = length(max);
+	for(i = 1; i < n; i++)
+		for(j = 0; j < 7; j++){
+			float32 d = dot(v[i], dirs[j]);
+			if(d < mind[j]){ mind[j] = d; minv[j] = i; }
+			if(d > maxd[j]){ maxd[j] = d; maxv[j] = i; }
+		}
+	int32 a = 0, b = 0;
+	float32 maxd2 = -1.0f;
+	for(j = 0; j < 7; j++){
+		V3d d = sub(v[maxv[j]], v[minv[j]]);
+		if(dot(d, d) > maxd2){
+			maxd2 = dot(d, d);
+			a = minv[j];
+			b = maxv[j];
+		}
+	}
+	sphere.center = scale(add(v[a], v[b]), 0.5f);
+	sphere.radius = sqrtf(maxd2)*0.5f;
+	growSphere(&sphere, v, n, 1);
+
+	Sphere s = sphere;
+	for(i = 0; i < 4; i++){
+		// has to be coprime to visit every point
+		int32 step = steps[i] % n;
+		if(step == 0 || gcd(n, step) != 1)
+			step = 1;
+		s.radius *= 0.95f;
+		growSphere(&s, v, n, step);
+		if(s.radius < sphere.radius)
+			sphere = s;
+	}
+	// guard against rounding
+	sphere.radius *= 1.0001f;
 	return sphere;
 }
 
+BBox
+MorphTarget::calculateBoundingBox(void) const
+{
+	BBox box;
+	if(this->vertices == nil || this->parent->numVertices == 0)
+		return sphereBox(&this->boundingSphere);
+	box.calculate(this->vertices, this->parent->numVertices);
+	return box;
+}
+
 
 //
 // MaterialList
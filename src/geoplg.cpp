@@ -36,12 +36,13 @@ Geometry::allocateMeshes(int32 numMeshes, uint32 numIndices, bool32 noIndices)
 	uint32 sz;
 	MeshHeader *mh;
 	Mesh *m;
-	uint16 *indices;
+	uint8 *indices;
 	int32 oldNumMeshes;
 	int32 i;
+	bool32 index32 = !!(this->flags & INDEX32);
 	sz = sizeof(MeshHeader) + numMeshes*sizeof(Mesh);
 	if(!noIndices)
-		sz += numIndices*sizeof(uint16);
+		sz += numIndices*(index32 ? sizeof(uint32) : sizeof(uint16));
 	if(this->meshHeader){
 		oldNumMeshes = this->meshHeader->numMeshes;
 		mh = (MeshHeader*)rwResize(this->meshHeader, sz, MEMDUR_EVENT | ID_GEOMETRY);
@@ -55,8 +56,9 @@ Geometry::allocateMeshes(int32 numMeshes, uint32 numIndices, bool32 noIndices)
 	mh->numMeshes = numMeshes;
 	mh->serialNum = nextSerialNum++;
 	mh->totalIndices = numIndices;
+	mh->index32 = index32;
 	m = mh->getMeshes();
-	indices = (uint16*)&m[numMeshes];
+	indices = (uint8*)&m[numMeshes];
 	for(i = 0; i < mh->numMeshes; i++){
 		// keep these
 		if(i >= oldNumMeshes){
@@ -64,11 +66,16 @@ Geometry::allocateMeshes(int32 numMeshes, uint32 numIndices, bool32 noIndices)
 			m->numIndices = 0;
 		}
 		// always init indices
-		if(noIndices)
-			m->indices = nil;
-		else{
-			m->indices = indices;
-			indices += m->numIndices;
+		m->indices = nil;
+		m->indices32 = nil;
+		if(!noIndices){
+			if(index32){
+				m->indices32 = (uint32*)indices;
+				indices += m->numIndices*sizeof(uint32);
+			}else{
+				m->indices = (uint16*)indices;
+				indices += m->numIndices*sizeof(uint16);
+			}
 		}
 		m++;
 	}
@@ -80,15 +87,22 @@ MeshHeader::setupIndices(void)
 {
 	int32 i;
 	uint16 *indices;
+	uint32 *indices32;
 	Mesh *m;
 	m = this->getMeshes();
 	indices = m->indices;
+	indices32 = m->indices32;
 	// return if native
-	if(indices == nil)
+	if(indices == nil && indices32 == nil)
 		return;
 	for(i = 0; i < this->numMeshes; i++){
-		m->indices = indices;
-		indices += m->numIndices;
+		if(indices32){
+			m->indices32 = indices32;
+			indices32 += m->numIndices;
+		}else{
+			m->indices = indices;
+			indices += m->numIndices;
+		}
 		m++;
 	}
 }
@@ -115,6 +129,7 @@ readMesh(Stream *stream, int32 len, void *object, int32, int32)
 	Mesh *mesh;
 	int32 indbuf[256];
 	uint16 *indices;
+	uint32 *indices32;
 	Geometry *geo = (Geometry*)object;
 
 	stream->read32(&mhs, sizeof(MeshHeaderStream));
@@ -128,6 +143,7 @@ readMesh(Stream *stream, int32 len, void *object, int32, int32)
 
 	mesh = mh->getMeshes();
 	indices = mesh->indices;
+	indices32 = mesh->indices32;
 	for(uint32 i = 0; i < mh->numMeshes; i++){
 		stream->read32(&ms, sizeof(MeshStream));
 		mesh->numIndices = ms.numIndices;
@@ -140,6 +156,11 @@ readMesh(Stream *stream, int32 len, void *object, int32, int32)
 				stream->read16(mesh->indices,
 				            mesh->numIndices*2);
 			}
+		}else if(mh->index32){
+			// binary mesh indices are 32 bit anyway
+			mesh->indices32 = indices32;
+			indices32 += mesh->numIndices;
+			stream->read32(mesh->indices32, mesh->numIndices*4);
 		}else{
 			mesh->indices = indices;
 			indices += mesh->numIndices;
@@ -179,6 +200,8 @@ writeMesh(Stream *stream, int32, void *object, int32, int32)
 			if(geo->instData->platform == PLATFORM_WDGL)
 				stream->write16(mesh->indices,
 				            mesh->numIndices*2);
+		}else if(mesh->indices32){
+			stream->write32(mesh->indices32, mesh->numIndices*4);
 		}else{
 			uint16 *ind = mesh->indices;
 			int32 numIndices = mesh->numIndices;
@@ -212,11 +235,59 @@ getSizeMesh(void *object, int32, int32)
 	return size;
 }
 
+// 32 bit triangle indices. The geometry struct only has room for
+// 16 bits, so with Geometry::INDEX32 the full indices are written here.
+
+static Stream*
+readTriangles32(Stream *stream, int32 len, void *object, int32, int32)
+{
+	uint32 tribuf[3];
+	Geometry *geo = (Geometry*)object;
+	int32 numTris = stream->readI32();
+	if(geo->flags & Geometry::NATIVE || numTris != geo->numTriangles){
+		stream->seek(len-4);
+		return stream;
+	}
+	for(int32 i = 0; i < numTris; i++){
+		stream->read32(tribuf, 12);
+		geo->setTriangle(i, tribuf[0], tribuf[1], tribuf[2],
+			geo->getTriMatId(i));
+	}
+	return stream;
+}
+
+static Stream*
+writeTriangles32(Stream *stream, int32, void *object, int32, int32)
+{
+	uint32 tribuf[3];
+	Geometry *geo = (Geometry*)object;
+	stream->writeI32(geo->numTriangles);
+	for(int32 i = 0; i < geo->numTriangles; i++){
+		tribuf[0] = geo->getTriVertex(i, 0);
+		tribuf[1] = geo->getTriVertex(i, 1);
+		tribuf[2] = geo->getTriVertex(i, 2);
+		stream->write32(tribuf, 12);
+	}
+	return stream;
+}
+
+static int32
+getSizeTriangles32(void *object, int32, int32)
+{
+	Geometry *geo = (Geometry*)object;
+	if(geo->flags & Geometry::NATIVE || geo->triangles32 == nil ||
+	   geo->numTriangles == 0)
+		return -1;
+	return 4 + geo->numTriangles*12;
+}
+
 void
 registerMeshPlugin(void)
 {
 	Geometry::registerPlugin(0, ID_MESH, nil, nil, nil);
 	Geometry::registerPluginStream(ID_MESH, readMesh, writeMesh, getSizeMesh);
+	Geometry::registerPlugin(0, ID_TRIANGLES32, nil, nil, nil);
+	Geometry::registerPluginStream(ID_TRIANGLES32, readTriangles32, writeTriangles32, getSizeTriangles32);
 }
 
 // Returns the maximum number of triangles. Just so
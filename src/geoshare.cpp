@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+
+#define PLUGIN_ID ID_GEOMETRY
+
+/*
+ * Sharing of identical geometry between streamed clumps.
+ *
+ * The complete geometry chunk (struct, material list and
+ * extensions) is read into memory and hashed. If a geometry
+ * with the same bytes is still alive it is returned
+ * with an extra reference instead of reading a new one,
+ * so its instance data is shared as well.
+ * Each entry keeps a copy of the chunk so a hash collision
+ * can never hand out the wrong geometry.
+ * The registry does not hold references, geometries remove
+ * themselves when destroyed or locked for modification.
+ */
+
+namespace rw {
+
+struct GeometryShareEntry
+{
+	uint64 hash;
+	uint32 length;
+	Geometry *geo;
+	GeometryShareEntry *next;
+	uint8 *data;	// the chunk, stored after the entry
+};
+
+static bool32 sharing;
+static GeometryShareEntry **buckets;
+static int32 numBuckets;
+static int32 numEntries;
+
+void Geometry::setSharing(bool32 b) { sharing = b; }
+bool32 Geometry::getSharing(void) { return sharing; }
+
+static uint64
+hashData(uint8 *data, uint32 length)
+{
+	uint64 h = 0x9E3779B97F4A7C15ULL ^ length;
+	uint64 k;
+	uint32 i;
+	for(i = 0; i+8 <= length; i += 8){
+		memcpy(&k, data+i, 8);
+		k *= 0x87C37B91114253D5ULL;
+		k ^= k >> 31;
+		h = (h ^ k) * 0x4CF5AD432745937FULL;
+	}
+	if(i < length){
+		k = 0;
+		memcpy(&k, data+i, length-i);
+		k *= 0x87C37B91114253D5ULL;
+		k ^= k >> 31;
+		h = (h ^ k) * 0x4CF5AD432745937FULL;
+	}
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	return h;
+}
+
+static void
+resizeBuckets(int32 n)
+{
+	GeometryShareEntry **newBuckets = rwNewT(GeometryShareEntry*, n, MEMDUR_EVENT | ID_GEOMETRY);
+	memset(newBuckets, 0, n*sizeof(GeometryShareEntry*));
+	for(int32 i = 0; i < numBuckets; i++){
+		GeometryShareEntry *e, *next;
+		for(e = buckets[i]; e; e = next){
+			next = e->next;
+			GeometryShareEntry **b = &newBuckets[e->hash & (n-1)];
+			e->next = *b;
+			*b = e;
+		}
+	}
+	rwFree(buckets);
+	buckets = newBuckets;
+	numBuckets = n;
+}
+
+static Geometry*
+findShared(uint64 hash, uint8 *data, uint32 length)
+{
+	if(numBuckets == 0)
+		return nil;
+	GeometryShareEntry *e;
+	for(e = buckets[hash & (numBuckets-1)]; e; e = e->next)
+		if(e->hash == hash && e->length == length &&
+		   memcmp(e->data, data, length) == 0)
+			return e->geo;
+	return nil;
+}
+
+static void
+addShared(Geometry *geo, uint64 hash, uint8 *data, uint32 length)
+{
+	if(numEntries >= numBuckets)
+		resizeBuckets(numBuckets ? numBuckets*2 : 256);
+	GeometryShareEntry *e = (GeometryShareEntry*)rwNew(sizeof(GeometryShareEntry)+length,
+		MEMDUR_EVENT | ID_GEOMETRY);
+	e->hash = hash;
+	e->length = length;
+	e->geo = geo;
+	e->data = (uint8*)(e+1);
+	memcpy(e->data, data, length);
+	GeometryShareEntry **b = &buckets[hash & (numBuckets-1)];
+	e->next = *b;
+	*b = e;
+	geo->shareEntry = e;
+	numEntries++;
+}
+
+void
+Geometry::unshare(void)
+{
+	GeometryShareEntry *e = this->shareEntry;
+	if(e == nil)
+		return;
+	GeometryShareEntry **p;
+	for(p = &buckets[e->hash & (numBuckets-1)]; *p != e; p = &(*p)->next)
+		;
+	*p = e->next;
+	rwFree(e);
+	this->shareEntry = nil;
+	if(--numEntries == 0){
+		rwFree(buckets);
+		buckets = nil;
+		numBuckets = 0;
+	}
+}
+
+Geometry*
+Geometry::streamReadShared(Stream *stream, uint32 length)
+{
+	if(!sharing)
+		return Geometry::streamRead(stream);
+
+	uint8 *data = rwNewT(uint8, length, MEMDUR_FUNCTION | ID_GEOMETRY);
+	if(stream->read8(data, length) != length){
+		RWERROR((ERR_CHUNK, "GEOMETRY"));
+		rwFree(data);
+		return nil;
+	}
+	uint64 hash = hashData(data, length);
+	Geometry *geo = findShared(hash, data, length);
+	if(geo){
+		geo->addRef();
+		rwFree(data);
+		return geo;
+	}
+
+	StreamMemory mem;
+	mem.open(data, length);
+	geo = Geometry::streamRead(&mem);
+	mem.close();
+	if(geo)
+		addShared(geo, hash, data, length);
+	rwFree(data);
+	return geo;
+}
+
+}
@@ -135,9 +135,12 @@ int32 u_lightColor;
 
 int32 u_matColor;
 int32 u_surfProps;
+int32 u_instWorld;
 
 Shader *defaultShader, *defaultShader_noAT;
 Shader *defaultShader_fullLight, *defaultShader_fullLight_noAT;
+Shader *defaultShader_inst, *defaultShader_inst_noAT;
+Shader *defaultShader_inst_fullLight, *defaultShader_inst_fullLight_noAT;
 
 static bool32 stateDirty = 1;
 static bool32 sceneDirty = 1;
@@ -1822,6 +1825,7 @@ initOpenGL(void)
 #endif
 	u_matColor = registerUniform("u_matColor", UNIFORM_VEC4);
 	u_surfProps = registerUniform("u_surfProps", UNIFORM_VEC4);
+	u_instWorld = registerUniform("u_instWorld", UNIFORM_VEC4, 3*MAX_INSTANCES);
 
 	// for im2d
 	registerUniform("u_xform", UNIFORM_VEC4);
@@ -1887,6 +1891,21 @@ initOpenGL(void)
 	defaultShader_fullLight_noAT = Shader::create(vs_fullLight, fs_noAT);
 	assert(defaultShader_fullLight_noAT);
 
+	// gl_InstanceID needs GLSL 3
+	if(gl3Caps.glversion >= 30){
+		const char *instDecl = "#define INSTANCING\n#define MAX_INSTANCES 32\n";
+		const char *vs_inst[] = { shaderDecl, instDecl, header_vert_src, default_vert_src, nil };
+		const char *vs_inst_fullLight[] = { shaderDecl, instDecl, "#define DIRECTIONALS\n", header_vert_src, default_vert_src, nil };
+		defaultShader_inst = Shader::create(vs_inst, fs);
+		assert(defaultShader_inst);
+		defaultShader_inst_noAT = Shader::create(vs_inst, fs_noAT);
+		assert(defaultShader_inst_noAT);
+		defaultShader_inst_fullLight = Shader::create(vs_inst_fullLight, fs);
+		assert(defaultShader_inst_fullLight);
+		defaultShader_inst_fullLight_noAT = Shader::create(vs_inst_fullLight, fs_noAT);
+		assert(defaultShader_inst_fullLight_noAT);
+	}
+
 	openIm2D();
 	openIm3D();
 
@@ -1907,6 +1926,16 @@ termOpenGL(void)
 	defaultShader_fullLight = nil;
 	defaultShader_fullLight_noAT->destroy();
 	defaultShader_fullLight_noAT = nil;
+	if(defaultShader_inst){
+		defaultShader_inst->destroy();
+		defaultShader_inst = nil;
+		defaultShader_inst_noAT->destroy();
+		defaultShader_inst_noAT = nil;
+		defaultShader_inst_fullLight->destroy();
+		defaultShader_inst_fullLight = nil;
+		defaultShader_inst_fullLight_noAT->destroy();
+		defaultShader_inst_fullLight_noAT = nil;
+	}
 
 	glDeleteTextures(1, &whitetex);
 	whitetex = 0;
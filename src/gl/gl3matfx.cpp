@@ -30,6 +30,9 @@ static int32 u_texMatrix;
 static int32 u_fxparams;
 static int32 u_colorClamp;
 static int32 u_envColor;
+static Shader *bumpShader, *bumpShader_noAT;
+static Shader *bumpShader_fullLight, *bumpShader_fullLight_noAT;
+static int32 u_bumpLight;
 
 void
 matfxDefaultRender(InstanceDataHeader *header, InstanceData *inst, int32 vsBits, uint32 flags)
@@ -149,10 +152,59 @@ matfxEnvRender(InstanceDataHeader *header, InstanceData *inst, int32 vsBits, uin
 	rw::SetRenderState(SRCBLEND, BLENDSRCALPHA);
 }
 
+// Emboss style bump mapping: the bump texture is read as a height map
+// twice, the second time shifted towards the light in tangent space.
+void
+matfxBumpRender(InstanceDataHeader *header, InstanceData *inst, int32 vsBits, uint32 flags, MatFX::Bump *bump)
+{
+	Material *m;
+	m = inst->material;
+
+	if(bump->tex == nil || bump->coefficient == 0.0f){
+		matfxDefaultRender(header, inst, vsBits, flags);
+		return;
+	}
+
+	setTexture(0, m->texture);
+	setTexture(1, bump->tex);
+
+	setMaterial(flags, m->color, m->surfaceProps);
+
+	// the light shines along the frame's at vector, the camera's by default
+	Frame *frame = bump->frame;
+	if(frame == nil)
+		frame = engine->currentCamera->getFrame();
+	V3d *at = &frame->getLTM()->at;
+	float bumpLight[4];
+	bumpLight[0] = at->x;
+	bumpLight[1] = at->y;
+	bumpLight[2] = at->z;
+	bumpLight[3] = bump->coefficient/128.0f;	// about a texel of a 128 map
+	setUniform(u_bumpLight, bumpLight);
+
+	rw::SetRenderState(VERTEXALPHA, inst->vertexAlpha || m->color.alpha != 0xFF);
+
+	if((vsBits & VSLIGHT_MASK) == 0){
+		if(getAlphaTest())
+			bumpShader->use();
+		else
+			bumpShader_noAT->use();
+	}else{
+		if(getAlphaTest())
+			bumpShader_fullLight->use();
+		else
+			bumpShader_fullLight_noAT->use();
+	}
+
+	drawInst(header, inst);
+}
+
 void
 matfxRenderCB(Atomic *atomic, InstanceDataHeader *header)
 {
 	uint32 flags = atomic->geometry->flags;
+	// bump mapping needs tangents, see Tangents::generate
+	bool32 hasTangents = Tangents::get(atomic->geometry) != nil;
 	setWorldMatrix(atomic->getFrame()->getLTM());
 	int32 vsBits = lightingCB(atomic);
 
@@ -172,6 +224,12 @@ matfxRenderCB(Atomic *atomic, InstanceDataHeader *header)
 		case MatFX::ENVMAP:
 			matfxEnvRender(header, inst, vsBits, flags, &matfx->fx[0].env);
 			break;
+		case MatFX::BUMPMAP:
+			if(hasTangents)
+				matfxBumpRender(header, inst, vsBits, flags, &matfx->fx[0].bump);
+			else
+				matfxDefaultRender(header, inst, vsBits, flags);
+			break;
 		default:
 			matfxDefaultRender(header, inst, vsBits, flags);
 			break;
@@ -187,6 +245,7 @@ makeMatFXPipeline(void)
 	ObjPipeline *pipe = ObjPipeline::create();
 	pipe->instanceCB = defaultInstanceCB;
 	pipe->uninstanceCB = defaultUninstanceCB;
+	pipe->packCB = defaultPackCB;
 	pipe->renderCB = matfxRenderCB;
 	pipe->beginUpdate = defaultUpdateCB;
 	pipe->pluginID = ID_MATFX;
@@ -215,6 +274,21 @@ matfxOpen(void *o, int32, int32)
 	envShader_fullLight_noAT = Shader::create(vs_fullLight, fs_noAT);
 	assert(envShader_fullLight_noAT);
 
+	const char *bump_vs[] = { shaderDecl, header_vert_src, matfx_bump_vert_src, nil };
+	const char *bump_vs_fullLight[] = { shaderDecl, "#define DIRECTIONALS\n#define POINTLIGHTS\n#define SPOTLIGHTS\n", header_vert_src, matfx_bump_vert_src, nil };
+	const char *bump_fs[] = { shaderDecl, header_frag_src, matfx_bump_frag_src, nil };
+	const char *bump_fs_noAT[] = { shaderDecl, "#define NO_ALPHATEST\n", header_frag_src, matfx_bump_frag_src, nil };
+
+	bumpShader = Shader::create(bump_vs, bump_fs);
+	assert(bumpShader);
+	bumpShader_noAT = Shader::create(bump_vs, bump_fs_noAT);
+	assert(bumpShader_noAT);
+
+	bumpShader_fullLight = Shader::create(bump_vs_fullLight, bump_fs);
+	assert(bumpShader_fullLight);
+	bumpShader_fullLight_noAT = Shader::create(bump_vs_fullLight, bump_fs_noAT);
+	assert(bumpShader_fullLight_noAT);
+
 	return o;
 }
 
@@ -233,6 +307,15 @@ matfxClose(void *o, int32, int32)
 	envShader_fullLight_noAT->destroy();
 	envShader_fullLight_noAT = nil;
 
+	bumpShader->destroy();
+	bumpShader = nil;
+	bumpShader_noAT->destroy();
+	bumpShader_noAT = nil;
+	bumpShader_fullLight->destroy();
+	bumpShader_fullLight = nil;
+	bumpShader_fullLight_noAT->destroy();
+	bumpShader_fullLight_noAT = nil;
+
 	return o;
 }
 
@@ -243,6 +326,7 @@ initMatFX(void)
 	u_fxparams = registerUniform("u_fxparams", UNIFORM_VEC4);
 	u_colorClamp = registerUniform("u_colorClamp", UNIFORM_VEC4);
 	u_envColor = registerUniform("u_envColor", UNIFORM_VEC4);
+	u_bumpLight = registerUniform("u_bumpLight", UNIFORM_VEC4);
 
 	Driver::registerPlugin(PLATFORM_GL3, 0, ID_MATFX,
 	                       matfxOpen, matfxClose);
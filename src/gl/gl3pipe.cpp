@@ -9,6 +9,8 @@
 #include "../rwpipeline.h"
 #include "../rwobjects.h"
 #include "../rwengine.h"
+#include "../rwanim.h"
+#include "../rwplugins.h"
 
 #include "rwgl3.h"
 #include "rwgl3shader.h"
@@ -20,14 +22,9 @@ namespace gl3 {
 
 #ifdef RW_OPENGL
 
-void
-freeInstanceData(Geometry *geometry)
+static void
+freeHeader(InstanceDataHeader *header)
 {
-	if(geometry->instData == nil ||
-	   geometry->instData->platform != PLATFORM_GL3)
-		return;
-	InstanceDataHeader *header = (InstanceDataHeader*)geometry->instData;
-	geometry->instData = nil;
 	glDeleteBuffers(1, &header->ibo);
 	glDeleteBuffers(1, &header->vbo);
 #ifdef RW_GL_USE_VAOS
@@ -40,6 +37,17 @@ freeInstanceData(Geometry *geometry)
 	rwFree(header);
 }
 
+void
+freeInstanceData(Geometry *geometry)
+{
+	if(geometry->instData == nil ||
+	   geometry->instData->platform != PLATFORM_GL3)
+		return;
+	InstanceDataHeader *header = (InstanceDataHeader*)geometry->instData;
+	geometry->instData = nil;
+	freeHeader(header);
+}
+
 void*
 destroyNativeData(void *object, int32, int32)
 {
@@ -47,12 +55,12 @@ destroyNativeData(void *object, int32, int32)
 	return object;
 }
 
+// Everything but the GL objects, ibo stays 0 until createIndexBuffer
 static InstanceDataHeader*
-instanceMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
+packMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
 {
 	InstanceDataHeader *header = rwNewT(InstanceDataHeader, 1, MEMDUR_EVENT | ID_GEOMETRY);
 	MeshHeader *meshh = geo->meshHeader;
-	geo->instData = header;
 	header->platform = PLATFORM_GL3;
 
 	header->serialNumber = meshh->serialNum;
@@ -62,13 +70,19 @@ instanceMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
 	header->totalNumIndex = meshh->totalIndices;
 	header->inst = rwNewT(InstanceData, header->numMeshes, MEMDUR_EVENT | ID_GEOMETRY);
 
-	header->indexBuffer = rwNewT(uint16, header->totalNumIndex, MEMDUR_EVENT | ID_GEOMETRY);
+	uint32 indexSize = meshh->index32 ? 4 : 2;
+	header->indexType = meshh->index32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+	header->indexBuffer = (uint16*)rwNew(header->totalNumIndex*indexSize, MEMDUR_EVENT | ID_GEOMETRY);
 	InstanceData *inst = header->inst;
 	Mesh *mesh = meshh->getMeshes();
 	uint32 offset = 0;
 	for(uint32 i = 0; i < header->numMeshes; i++){
-		findMinVertAndNumVertices(mesh->indices, mesh->numIndices,
-		                          &inst->minVert, &inst->numVertices);
+		if(meshh->index32)
+			findMinVertAndNumVertices(mesh->indices32, mesh->numIndices,
+			                          &inst->minVert, &inst->numVertices);
+		else
+			findMinVertAndNumVertices(mesh->indices, mesh->numIndices,
+			                          &inst->minVert, &inst->numVertices);
 		assert(inst->minVert != 0xFFFFFFFF);
 		inst->numIndex = mesh->numIndices;
 		inst->material = mesh->material;
@@ -76,8 +90,9 @@ instanceMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
 		inst->program = 0;
 		inst->offset = offset;
 		memcpy((uint8*)header->indexBuffer + inst->offset,
-		       mesh->indices, inst->numIndex*2);
-		offset += inst->numIndex*2;
+		       meshh->index32 ? (void*)mesh->indices32 : mesh->indices,
+		       inst->numIndex*indexSize);
+		offset += inst->numIndex*indexSize;
 		mesh++;
 		inst++;
 	}
@@ -85,21 +100,97 @@ instanceMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
 	header->vertexBuffer = nil;
 	header->numAttribs = 0;
 	header->attribDesc = nil;
+	header->vertexFormat = ((ObjPipeline*)rwpipe)->vertexFormat;
+	header->morphSerial = 0;
 	header->ibo = 0;
 	header->vbo = 0;
+	return header;
+}
 
+static void
+createIndexBuffer(InstanceDataHeader *header)
+{
+	uint32 indexSize = header->indexType == GL_UNSIGNED_INT ? 4 : 2;
 #ifdef RW_GL_USE_VAOS
 	glGenVertexArrays(1, &header->vao);
 	glBindVertexArray(header->vao);
 #endif
 	glGenBuffers(1, &header->ibo);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, header->ibo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, header->totalNumIndex*2,
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, header->totalNumIndex*indexSize,
 			header->indexBuffer, GL_STATIC_DRAW);
+}
 
+static InstanceDataHeader*
+instanceMesh(rw::ObjPipeline *rwpipe, Geometry *geo)
+{
+	InstanceDataHeader *header = packMesh(rwpipe, geo);
+	geo->instData = header;
+	createIndexBuffer(header);
 	return header;
 }
 
+void
+uploadVertexBuffer(InstanceDataHeader *header)
+{
+	if(header->vbo == 0)
+		glGenBuffers(1, &header->vbo);
+#ifdef RW_GL_USE_VAOS
+	glBindVertexArray(header->vao);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, header->ibo);
+#endif
+	glBindBuffer(GL_ARRAY_BUFFER, header->vbo);
+	glBufferData(GL_ARRAY_BUFFER, header->totalNumVertex*header->attribDesc[0].stride,
+	             header->vertexBuffer, GL_STATIC_DRAW);
+#ifdef RW_GL_USE_VAOS
+	setAttribPointers(header->attribDesc, header->numAttribs);
+	glBindVertexArray(0);
+#endif
+}
+
+// Write the atomic's morph blend into the vertex buffer.
+// Atomics sharing a geometry overwrite each other's blend,
+// so this only uploads when the blend is a different one.
+static void
+instanceMorph(Atomic *atomic, InstanceDataHeader *header)
+{
+	Geometry *geo = atomic->geometry;
+	MorphAtomic *m = Morph::get(atomic);
+	if(header->morphSerial == m->serial)
+		return;
+	MorphTarget *mt1 = &geo->morphTargets[m->startTarget];
+	MorphTarget *mt2 = &geo->morphTargets[m->endTarget];
+	uint8 *verts = header->vertexBuffer;
+	AttribDesc *a;
+	for(a = header->attribDesc; a != &header->attribDesc[header->numAttribs]; a++){
+		int32 type;
+		V3d *src1, *src2;
+		if(a->index == ATTRIB_POS){
+			type = getPosType(header->vertexFormat);
+			src1 = mt1->vertices;
+			src2 = mt2->vertices;
+		}else if(a->index == ATTRIB_NORMAL){
+			type = getNormalType(header->vertexFormat);
+			src1 = mt1->normals;
+			src2 = mt2->normals;
+		}else
+			continue;
+		if(type == VERT_FLOAT3)
+			// straight into the vertex buffer
+			Morph::blendStrided(verts + a->offset, a->stride,
+				src1, src2, header->totalNumVertex, m->t);
+		else
+			instV3d(type, verts + a->offset,
+				a->index == ATTRIB_POS ? Morph::getVertices(atomic) : Morph::getNormals(atomic),
+				header->totalNumVertex, a->stride);
+	}
+	// orphan the old storage instead of waiting for it
+	glBindBuffer(GL_ARRAY_BUFFER, header->vbo);
+	glBufferData(GL_ARRAY_BUFFER, header->totalNumVertex*header->attribDesc[0].stride,
+	             header->vertexBuffer, GL_DYNAMIC_DRAW);
+	header->morphSerial = m->serial;
+}
+
 static void
 instance(rw::ObjPipeline *rwpipe, Atomic *atomic)
 {
@@ -123,10 +214,45 @@ instance(rw::ObjPipeline *rwpipe, Atomic *atomic)
 	if(geo->instData == nil){
 		geo->instData = instanceMesh(rwpipe, geo);
 		pipe->instanceCB(geo, (InstanceDataHeader*)geo->instData, 0);
-	}else if(geo->lockedSinceInst)
+	}else if(geo->lockedSinceInst){
+		if(geo->lockedSinceInst & (Geometry::LOCKVERTICES|Geometry::LOCKNORMALS))
+			((InstanceDataHeader*)geo->instData)->morphSerial = 0;
 		pipe->instanceCB(geo, (InstanceDataHeader*)geo->instData, 1);
+	}
 
 	geo->lockedSinceInst = 0;
+
+	if(morphGlobals.atomicOffset)
+		instanceMorph(atomic, (InstanceDataHeader*)geo->instData);
+}
+
+// The CPU half of instance, makes no GL calls
+static rw::InstanceDataHeader*
+prepareInstance(rw::ObjPipeline *rwpipe, Atomic *atomic)
+{
+	ObjPipeline *pipe = (ObjPipeline*)rwpipe;
+	Geometry *geo = atomic->geometry;
+	if(pipe->packCB == nil || geo->instData ||
+	   (geo->flags & Geometry::NATIVE))
+		return nil;
+	InstanceDataHeader *header = packMesh(rwpipe, geo);
+	pipe->packCB(geo, header, 0);
+	return header;
+}
+
+// The GL half, on the render thread
+static void
+uploadInstance(rw::ObjPipeline *rwpipe, Geometry *geo, rw::InstanceDataHeader *rwheader)
+{
+	InstanceDataHeader *header = (InstanceDataHeader*)rwheader;
+	if(geo->instData){
+		// prepared twice or instanced since
+		freeHeader(header);
+		return;
+	}
+	createIndexBuffer(header);
+	uploadVertexBuffer(header);
+	geo->instData = header;
 }
 
 static void
@@ -153,6 +279,50 @@ render(rw::ObjPipeline *rwpipe, Atomic *atomic)
 		pipe->renderCB(atomic, (InstanceDataHeader*)geo->instData);
 }
 
+static bool32
+canQueue(rw::ObjPipeline *rwpipe, Atomic *atomic)
+{
+	// morphing atomics rewrite the shared VBO in instance(),
+	// so they can't be instanced ahead of a batch
+	if(Morph::isMorphing(atomic))
+		return 0;
+	return ((ObjPipeline*)rwpipe)->renderCB == defaultRenderCB;
+}
+
+static bool32
+meshVertexAlpha(rw::ObjPipeline *rwpipe, Atomic *atomic, int32 mesh)
+{
+	rwpipe->instance(atomic);
+	InstanceDataHeader *header = (InstanceDataHeader*)atomic->geometry->instData;
+	return header && mesh < (int32)header->numMeshes &&
+		header->inst[mesh].vertexAlpha;
+}
+
+static void
+renderMeshes(rw::ObjPipeline *rwpipe, MeshDraw *draws, int32 n)
+{
+	int32 i;
+	ObjPipeline *pipe = (ObjPipeline*)rwpipe;
+	for(i = 0; i < n; i++)
+		if(i == 0 || draws[i].atomic != draws[i-1].atomic){
+			pipe->instance(draws[i].atomic);
+			assert(draws[i].atomic->geometry->instData != nil);
+			assert(draws[i].atomic->geometry->instData->platform == PLATFORM_GL3);
+		}
+	pipe->renderMeshesCB(draws, n);
+}
+
+static void
+renderInstanced(rw::ObjPipeline *rwpipe, Atomic **atomics, int32 n, WorldLights *lights)
+{
+	ObjPipeline *pipe = (ObjPipeline*)rwpipe;
+	Geometry *geo = atomics[0]->geometry;
+	pipe->instance(atomics[0]);
+	assert(geo->instData != nil);
+	assert(geo->instData->platform == PLATFORM_GL3);
+	pipe->renderInstancedCB(atomics, n, (InstanceDataHeader*)geo->instData, lights);
+}
+
 void
 ObjPipeline::init(void)
 {
@@ -161,9 +331,15 @@ ObjPipeline::init(void)
 	this->impl.uninstance = gl3::uninstance;
 	this->impl.render = gl3::render;
 	this->impl.beginUpdate = gl3::beginUpdate;
+	this->impl.prepareInstance = gl3::prepareInstance;
+	this->impl.uploadInstance = gl3::uploadInstance;
 	this->instanceCB = nil;
 	this->uninstanceCB = nil;
+	this->packCB = nil;
 	this->renderCB = nil;
+	this->renderMeshesCB = nil;
+	this->renderInstancedCB = nil;
+	this->vertexFormat = 0;
 }
 
 ObjPipeline*
@@ -174,16 +350,82 @@ ObjPipeline::create(void)
 	return pipe;
 }
 
+int32
+getPosType(uint32 vertexFormat)
+{
+	return vertexFormat & VERTFMT_HALFPOS ? VERT_HALF3 : VERT_FLOAT3;
+}
+
+int32
+getNormalType(uint32 vertexFormat)
+{
+	return vertexFormat & VERTFMT_BYTENORMAL ? VERT_BYTE3 : VERT_FLOAT3;
+}
+
+int32
+getTexCoordType(uint32 vertexFormat)
+{
+	return vertexFormat & VERTFMT_HALFTEX ? VERT_HALF2 : VERT_FLOAT2;
+}
+
+uint32
+setAttribType(AttribDesc *a, int32 type)
+{
+	a->normalized = GL_FALSE;
+	switch(type){
+	case VERT_FLOAT2:
+		a->size = 2;
+		a->type = GL_FLOAT;
+		break;
+	case VERT_FLOAT3:
+		a->size = 3;
+		a->type = GL_FLOAT;
+		break;
+	case VERT_FLOAT4:
+		a->size = 4;
+		a->type = GL_FLOAT;
+		break;
+	case VERT_HALF2:
+		a->size = 2;
+		a->type = GL_HALF_FLOAT;
+		break;
+	case VERT_HALF3:
+		a->size = 3;
+		a->type = GL_HALF_FLOAT;
+		break;
+	case VERT_BYTE3:
+		a->size = 3;
+		a->type = GL_BYTE;
+		a->normalized = GL_TRUE;
+		break;
+	case VERT_NORMSHORT2:
+		a->size = 2;
+		a->type = GL_SHORT;
+		a->normalized = GL_TRUE;
+		break;
+	case VERT_NORMSHORT3:
+		a->size = 3;
+		a->type = GL_SHORT;
+		a->normalized = GL_TRUE;
+		break;
+	default:
+		assert(0 && "unsupported attribute type");
+	}
+	// keep attributes aligned
+	return (vertFormatSize(type) + 3) & ~3;
+}
+
 void
-defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
+defaultPackCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 {
 	AttribDesc *attribs, *a;
 
 	bool isPrelit = !!(geo->flags & Geometry::PRELIT);
 	bool hasNormals = !!(geo->flags & Geometry::NORMALS);
+	Tangents *tangents = Tangents::get(geo);
 
 	if(!reinstance){
-		AttribDesc tmpAttribs[12];
+		AttribDesc tmpAttribs[13];
 		uint32 stride;
 
 		//
@@ -194,22 +436,15 @@ defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 
 		// Positions
 		a->index = ATTRIB_POS;
-		a->size = 3;
-		a->type = GL_FLOAT;
-		a->normalized = GL_FALSE;
 		a->offset = stride;
-		stride += 12;
+		stride += setAttribType(a, getPosType(header->vertexFormat));
 		a++;
 
 		// Normals
-		// TODO: compress
 		if(hasNormals){
 			a->index = ATTRIB_NORMAL;
-			a->size = 3;
-			a->type = GL_FLOAT;
-			a->normalized = GL_FALSE;
 			a->offset = stride;
-			stride += 12;
+			stride += setAttribType(a, getNormalType(header->vertexFormat));
 			a++;
 		}
 
@@ -227,11 +462,16 @@ defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 		// Texture coordinates
 		for(int32 n = 0; n < geo->numTexCoordSets; n++){
 			a->index = ATTRIB_TEXCOORDS0+n;
-			a->size = 2;
-			a->type = GL_FLOAT;
-			a->normalized = GL_FALSE;
 			a->offset = stride;
-			stride += 8;
+			stride += setAttribType(a, getTexCoordType(header->vertexFormat));
+			a++;
+		}
+
+		// Tangents
+		if(tangents){
+			a->index = ATTRIB_TANGENT;
+			a->offset = stride;
+			stride += setAttribType(a, VERT_FLOAT4);
 			a++;
 		}
 
@@ -246,8 +486,6 @@ defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 		// Allocate vertex buffer
 		//
 		header->vertexBuffer = rwNewT(uint8, header->totalNumVertex*stride, MEMDUR_EVENT | ID_GEOMETRY);
-		assert(header->vbo == 0);
-		glGenBuffers(1, &header->vbo);
 	}
 
 	attribs = header->attribDesc;
@@ -262,7 +500,7 @@ defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 	if(!reinstance || geo->lockedSinceInst&Geometry::LOCKVERTICES){
 		for(a = attribs; a->index != ATTRIB_POS; a++)
 			;
-		instV3d(VERT_FLOAT3, verts + a->offset,
+		instV3d(getPosType(header->vertexFormat), verts + a->offset,
 			geo->morphTargets[0].vertices,
 			header->totalNumVertex, a->stride);
 	}
@@ -271,7 +509,7 @@ defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 	if(hasNormals && (!reinstance || geo->lockedSinceInst&Geometry::LOCKNORMALS)){
 		for(a = attribs; a->index != ATTRIB_NORMAL; a++)
 			;
-		instV3d(VERT_FLOAT3, verts + a->offset,
+		instV3d(getNormalType(header->vertexFormat), verts + a->offset,
 			geo->morphTargets[0].normals,
 			header->totalNumVertex, a->stride);
 	}
@@ -297,23 +535,29 @@ defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 		if(!reinstance || geo->lockedSinceInst&(Geometry::LOCKTEXCOORDS<<n)){
 			for(a = attribs; a->index != ATTRIB_TEXCOORDS0+n; a++)
 				;
-			instTexCoords(VERT_FLOAT2, verts + a->offset,
+			instTexCoords(getTexCoordType(header->vertexFormat), verts + a->offset,
 				geo->texCoords[n],
 				header->totalNumVertex, a->stride);
 		}
 	}
 
-#ifdef RW_GL_USE_VAOS
-	glBindVertexArray(header->vao);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, header->ibo);
-#endif
-	glBindBuffer(GL_ARRAY_BUFFER, header->vbo);
-	glBufferData(GL_ARRAY_BUFFER, header->totalNumVertex*attribs[0].stride,
-	             header->vertexBuffer, GL_STATIC_DRAW);
-#ifdef RW_GL_USE_VAOS
-	setAttribPointers(header->attribDesc, header->numAttribs);
-	glBindVertexArray(0);
-#endif
+	// Tangents, only if they already existed at first instancing
+	if(tangents && (!reinstance || geo->lockedSinceInst&Geometry::LOCKNORMALS)){
+		for(a = attribs; a != &attribs[header->numAttribs]; a++)
+			if(a->index == ATTRIB_TANGENT){
+				instV4d(VERT_FLOAT4, verts + a->offset,
+					tangents->tangents,
+					header->totalNumVertex, a->stride);
+				break;
+			}
+	}
+}
+
+void
+defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
+{
+	defaultPackCB(geo, header, reinstance);
+	uploadVertexBuffer(header);
 }
 
 void
@@ -328,8 +572,15 @@ makeDefaultPipeline(void)
 	ObjPipeline *pipe = ObjPipeline::create();
 	pipe->instanceCB = defaultInstanceCB;
 	pipe->uninstanceCB = defaultUninstanceCB;
+	pipe->packCB = defaultPackCB;
 	pipe->renderCB = defaultRenderCB;
 	pipe->beginUpdate= defaultUpdateCB;
+	pipe->renderMeshesCB = defaultRenderMeshesCB;
+	pipe->impl.canQueue = gl3::canQueue;
+	pipe->impl.meshVertexAlpha = gl3::meshVertexAlpha;
+	pipe->impl.renderMeshes = gl3::renderMeshes;
+	pipe->renderInstancedCB = defaultRenderInstancedCB;
+	pipe->impl.renderInstanced = gl3::renderInstanced;
 	return pipe;
 }
 
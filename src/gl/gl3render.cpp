@@ -9,6 +9,8 @@
 #include "../rwengine.h"
 #include "../rwpipeline.h"
 #include "../rwobjects.h"
+#include "../rwanim.h"
+#include "../rwplugins.h"
 
 #ifdef RW_OPENGL
 #include "rwgl3.h"
@@ -22,16 +24,21 @@ namespace gl3 {
 #define MAX_LIGHTS 
 
 void
-drawInst_simple(InstanceDataHeader *header, InstanceData *inst)
+drawInst_simple(InstanceDataHeader *header, InstanceData *inst, int32 numInstances)
 {
 	flushCache();
-	glDrawElements(header->primType, inst->numIndex,
-	               GL_UNSIGNED_SHORT, (void*)(uintptr)inst->offset);
+	if(numInstances > 1)
+		glDrawElementsInstanced(header->primType, inst->numIndex,
+		                        header->indexType, (void*)(uintptr)inst->offset,
+		                        numInstances);
+	else
+		glDrawElements(header->primType, inst->numIndex,
+		               header->indexType, (void*)(uintptr)inst->offset);
 }
 
 // Emulate PS2 GS alpha test FB_ONLY case: failed alpha writes to frame- but not to depth buffer
 void
-drawInst_GSemu(InstanceDataHeader *header, InstanceData *inst)
+drawInst_GSemu(InstanceDataHeader *header, InstanceData *inst, int32 numInstances)
 {
 	uint32 hasAlpha;
 	int alphafunc, alpharef, gsalpharef;
@@ -46,29 +53,52 @@ drawInst_GSemu(InstanceDataHeader *header, InstanceData *inst)
 
 			SetRenderState(rw::ALPHATESTFUNC, rw::ALPHAGREATEREQUAL);
 			SetRenderState(rw::ALPHATESTREF, gsalpharef);
-			drawInst_simple(header, inst);
+			drawInst_simple(header, inst, numInstances);
 			SetRenderState(rw::ALPHATESTFUNC, rw::ALPHALESS);
 			SetRenderState(rw::ZWRITEENABLE, 0);
-			drawInst_simple(header, inst);
+			drawInst_simple(header, inst, numInstances);
 			SetRenderState(rw::ZWRITEENABLE, 1);
 			SetRenderState(rw::ALPHATESTFUNC, alphafunc);
 			SetRenderState(rw::ALPHATESTREF, alpharef);
 		}else{
 			SetRenderState(rw::ALPHATESTFUNC, rw::ALPHAALWAYS);
-			drawInst_simple(header, inst);
+			drawInst_simple(header, inst, numInstances);
 			SetRenderState(rw::ALPHATESTFUNC, alphafunc);
 		}
 	}else
-		drawInst_simple(header, inst);
+		drawInst_simple(header, inst, numInstances);
 }
 
 void
-drawInst(InstanceDataHeader *header, InstanceData *inst)
+drawInst(InstanceDataHeader *header, InstanceData *inst, int32 numInstances)
 {
 	if(rw::GetRenderState(rw::GSALPHATEST))
-		drawInst_GSemu(header, inst);
+		drawInst_GSemu(header, inst, numInstances);
 	else
-		drawInst_simple(header, inst);
+		drawInst_simple(header, inst, numInstances);
+}
+
+
+// Draw only the visible meshlets of an instance,
+// merging adjacent ones into a single draw
+static void
+drawInstMeshlets(InstanceDataHeader *header, InstanceData *inst,
+                 Meshlet *meshlets, int32 numMeshlets, uint8 *visible)
+{
+	InstanceData sub = *inst;
+	uint32 indexSize = header->indexType == GL_UNSIGNED_INT ? 4 : 2;
+	int32 i, j;
+	for(i = 0; i < numMeshlets; i = j){
+		if(!visible[i]){
+			j = i+1;
+			continue;
+		}
+		sub.offset = inst->offset + meshlets[i].firstIndex*indexSize;
+		sub.numIndex = 0;
+		for(j = i; j < numMeshlets && visible[j]; j++)
+			sub.numIndex += meshlets[j].numTriangles*3;
+		drawInst(header, &sub);
+	}
 }
 
 
@@ -150,12 +180,63 @@ defaultUpdateCB(Atomic* atomic, InstanceDataHeader* header)
 	//pointless for opengl, good for vulkan or dx12
 }
 
+// material, texture and shader state of one mesh
+static void
+setupMesh(uint32 flags, InstanceData *inst, int32 vsBits, bool32 instanced = 0)
+{
+	Material *m = inst->material;
+
+	setMaterial(flags, m->color, m->surfaceProps);
+
+	setTexture(0, m->texture);
+
+	rw::SetRenderState(VERTEXALPHA, inst->vertexAlpha || m->color.alpha != 0xFF);
+
+	if(instanced){
+		if((vsBits & VSLIGHT_MASK) == 0){
+			if(getAlphaTest())
+				defaultShader_inst->use();
+			else
+				defaultShader_inst_noAT->use();
+		}else{
+			if(getAlphaTest())
+				defaultShader_inst_fullLight->use();
+			else
+				defaultShader_inst_fullLight_noAT->use();
+		}
+	}else if((vsBits & VSLIGHT_MASK) == 0){
+		if(getAlphaTest())
+			defaultShader->use();
+		else
+			defaultShader_noAT->use();
+	}else{
+		if(getAlphaTest())
+			defaultShader_fullLight->use();
+		else
+			defaultShader_fullLight_noAT->use();
+	}
+}
+
 void
 defaultRenderCB(Atomic *atomic, InstanceDataHeader *header)
 {
-	Material *m;
+	Meshlets *meshlets;
+	uint8 *visible;
 
 	uint32 flags = atomic->geometry->flags;
+
+	meshlets = nil;
+	visible = nil;
+	if(Meshlets::getCulling() &&
+	   (meshlets = Meshlets::get(atomic->geometry)) &&
+	   meshlets->numMeshes == (int32)header->numMeshes){
+		visible = Meshlets::getVisibleBuffer(meshlets->numMeshlets);
+		if(meshlets->cull(atomic, (Camera*)engine->currentCamera,
+		                  rw::GetRenderState(rw::CULLMODE) == rw::CULLBACK, visible) == 0)
+			return;
+	}else
+		meshlets = nil;
+
 	setWorldMatrix(atomic->getFrame()->getLTM());
 	int32 vsBits = lightingCB(atomic);
 
@@ -165,33 +246,98 @@ defaultRenderCB(Atomic *atomic, InstanceDataHeader *header)
 	int32 n = header->numMeshes;
 
 	while(n--){
-		m = inst->material;
+		setupMesh(flags, inst, vsBits);
+
+		if(meshlets){
+			int32 first = meshlets->meshStart[header->numMeshes-1-n];
+			int32 last = meshlets->meshStart[header->numMeshes-n];
+			drawInstMeshlets(header, inst, &meshlets->meshlets[first],
+			                 last-first, &visible[first]);
+		}else
+			drawInst(header, inst);
+		inst++;
+	}
+	teardownVertexInput(header);
+}
+
+// Meshes in sorted order, always draws all of their meshlets.
+// Object state is only set again when the atomic changes,
+// vertex input when the instance data does.
+void
+defaultRenderMeshesCB(MeshDraw *draws, int32 n)
+{
+	int32 i;
+	Atomic *atomic = nil;
+	InstanceDataHeader *header = nil;
+	int32 vsBits = 0;
+
+	for(i = 0; i < n; i++){
+		MeshDraw *d = &draws[i];
+		InstanceDataHeader *h = (InstanceDataHeader*)d->atomic->geometry->instData;
+		if(d->mesh >= (int32)h->numMeshes)
+			continue;
+		if(d->atomic != atomic){
+			atomic = d->atomic;
+			setWorldMatrix(atomic->getFrame()->getLTM());
+			vsBits = d->lights ? setLights(d->lights) : lightingCB(atomic);
+		}
+		if(h != header){
+			if(header)
+				teardownVertexInput(header);
+			header = h;
+			setupVertexInput(header);
+		}
+		setupMesh(atomic->geometry->flags, &header->inst[d->mesh], vsBits);
+		drawInst(header, &header->inst[d->mesh]);
+	}
+	if(header)
+		teardownVertexInput(header);
+}
 
-		setMaterial(flags, m->color, m->surfaceProps);
+// Atomics of one geometry, lit only by the ambient and directional
+// lights of the first one, which the queue may have found already.
+// World matrices go to the shader as rows of up to MAX_INSTANCES
+// atomics at a time.
+void
+defaultRenderInstancedCB(Atomic **atomics, int32 n, InstanceDataHeader *header, WorldLights *lights)
+{
+	int32 i, j;
+	float32 rows[3*MAX_INSTANCES][4];
 
-		setTexture(0, m->texture);
+	if(defaultShader_inst == nil){
+		for(i = 0; i < n; i++)
+			defaultRenderCB(atomics[i], header);
+		return;
+	}
 
-		rw::SetRenderState(VERTEXALPHA, inst->vertexAlpha || m->color.alpha != 0xFF);
+	uint32 flags = atomics[0]->geometry->flags;
+	int32 vsBits = lights ? setLights(lights) : lightingCB(atomics[0]);
 
-		if((vsBits & VSLIGHT_MASK) == 0){
-			if(getAlphaTest())
-				defaultShader->use();
-			else
-				defaultShader_noAT->use();
-		}else{
-			if(getAlphaTest())
-				defaultShader_fullLight->use();
-			else
-				defaultShader_fullLight_noAT->use();
+	setupVertexInput(header);
+	memset(rows, 0, sizeof(rows));
+	for(i = 0; i < n; i += MAX_INSTANCES){
+		int32 num = n-i < MAX_INSTANCES ? n-i : MAX_INSTANCES;
+		for(j = 0; j < num; j++){
+			Matrix *m = atomics[i+j]->getFrame()->getLTM();
+			float32 *r = rows[j*3];
+			r[0] = m->right.x; r[1] = m->up.x; r[2] = m->at.x; r[3] = m->pos.x;
+			r += 4;
+			r[0] = m->right.y; r[1] = m->up.y; r[2] = m->at.y; r[3] = m->pos.y;
+			r += 4;
+			r[0] = m->right.z; r[1] = m->up.z; r[2] = m->at.z; r[3] = m->pos.z;
 		}
+		setUniform(u_instWorld, rows);
 
-		drawInst(header, inst);
-		inst++;
+		InstanceData *inst = header->inst;
+		for(j = 0; j < (int32)header->numMeshes; j++){
+			setupMesh(flags, inst, vsBits, 1);
+			drawInst(header, inst, num);
+			inst++;
+		}
 	}
 	teardownVertexInput(header);
 }
 
-
 }
 }
 
@@ -224,6 +224,7 @@ linkprogram(GLint vs, GLint fs, GLuint *program)
 		glBindAttribLocation(prog, ATTRIB_INDICES, "in_indices");
 		glBindAttribLocation(prog, ATTRIB_TEXCOORDS0, "in_tex0");
 		glBindAttribLocation(prog, ATTRIB_TEXCOORDS1, "in_tex1");
+		glBindAttribLocation(prog, ATTRIB_TANGENT, "in_tangent");
 	}
 
 	glAttachShader(prog, vs);
@@ -29,12 +29,13 @@ static Shader *skinShader_fullLight, *skinShader_fullLight_noAT;
 static int32 u_boneMatrices;
 
 void
-skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
+skinPackCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 {
 	AttribDesc *attribs, *a;
 
 	bool isPrelit = !!(geo->flags & Geometry::PRELIT);
 	bool hasNormals = !!(geo->flags & Geometry::NORMALS);
+	Tangents *tangents = Tangents::get(geo);
 
 	if(!reinstance){
 		AttribDesc tmpAttribs[14];
@@ -48,22 +49,15 @@ skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 
 		// Positions
 		a->index = ATTRIB_POS;
-		a->size = 3;
-		a->type = GL_FLOAT;
-		a->normalized = GL_FALSE;
 		a->offset = stride;
-		stride += 12;
+		stride += setAttribType(a, getPosType(header->vertexFormat));
 		a++;
 
 		// Normals
-		// TODO: compress
 		if(hasNormals){
 			a->index = ATTRIB_NORMAL;
-			a->size = 3;
-			a->type = GL_FLOAT;
-			a->normalized = GL_FALSE;
 			a->offset = stride;
-			stride += 12;
+			stride += setAttribType(a, getNormalType(header->vertexFormat));
 			a++;
 		}
 
@@ -81,11 +75,16 @@ skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 		// Texture coordinates
 		for(int32 n = 0; n < geo->numTexCoordSets; n++){
 			a->index = ATTRIB_TEXCOORDS0+n;
-			a->size = 2;
-			a->type = GL_FLOAT;
-			a->normalized = GL_FALSE;
 			a->offset = stride;
-			stride += 8;
+			stride += setAttribType(a, getTexCoordType(header->vertexFormat));
+			a++;
+		}
+
+		// Tangents
+		if(tangents){
+			a->index = ATTRIB_TANGENT;
+			a->offset = stride;
+			stride += setAttribType(a, VERT_FLOAT4);
 			a++;
 		}
 
@@ -118,8 +117,6 @@ skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 		// Allocate vertex buffer
 		//
 		header->vertexBuffer = rwNewT(uint8, header->totalNumVertex*stride, MEMDUR_EVENT | ID_GEOMETRY);
-		assert(header->vbo == 0);
-		glGenBuffers(1, &header->vbo);
 	}
 
 	Skin *skin = Skin::get(geo);
@@ -135,7 +132,7 @@ skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 	if(!reinstance || geo->lockedSinceInst&Geometry::LOCKVERTICES){
 		for(a = attribs; a->index != ATTRIB_POS; a++)
 			;
-		instV3d(VERT_FLOAT3, verts + a->offset,
+		instV3d(getPosType(header->vertexFormat), verts + a->offset,
 			geo->morphTargets[0].vertices,
 			header->totalNumVertex, a->stride);
 	}
@@ -144,7 +141,7 @@ skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 	if(hasNormals && (!reinstance || geo->lockedSinceInst&Geometry::LOCKNORMALS)){
 		for(a = attribs; a->index != ATTRIB_NORMAL; a++)
 			;
-		instV3d(VERT_FLOAT3, verts + a->offset,
+		instV3d(getNormalType(header->vertexFormat), verts + a->offset,
 			geo->morphTargets[0].normals,
 			header->totalNumVertex, a->stride);
 	}
@@ -163,12 +160,23 @@ skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 		if(!reinstance || geo->lockedSinceInst&(Geometry::LOCKTEXCOORDS<<n)){
 			for(a = attribs; a->index != ATTRIB_TEXCOORDS0+n; a++)
 				;
-			instTexCoords(VERT_FLOAT2, verts + a->offset,
+			instTexCoords(getTexCoordType(header->vertexFormat), verts + a->offset,
 				geo->texCoords[n],
 				header->totalNumVertex, a->stride);
 		}
 	}
 
+	// Tangents, only if they already existed at first instancing
+	if(tangents && (!reinstance || geo->lockedSinceInst&Geometry::LOCKNORMALS)){
+		for(a = attribs; a != &attribs[header->numAttribs]; a++)
+			if(a->index == ATTRIB_TANGENT){
+				instV4d(VERT_FLOAT4, verts + a->offset,
+					tangents->tangents,
+					header->totalNumVertex, a->stride);
+				break;
+			}
+	}
+
 	// Weights
 	if(!reinstance){
 		for(a = attribs; a->index != ATTRIB_WEIGHTS; a++)
@@ -188,18 +196,13 @@ skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
 			  (RGBA*)skin->indices,
 			  header->totalNumVertex, a->stride);
 	}
+}
 
-#ifdef RW_GL_USE_VAOS
-	glBindVertexArray(header->vao);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, header->ibo);
-#endif
-	glBindBuffer(GL_ARRAY_BUFFER, header->vbo);
-	glBufferData(GL_ARRAY_BUFFER, header->totalNumVertex*attribs[0].stride,
-	             header->vertexBuffer, GL_STATIC_DRAW);
-#ifdef RW_GL_USE_VAOS
-	setAttribPointers(header->attribDesc, header->numAttribs);
-	glBindVertexArray(0);
-#endif
+void
+skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance)
+{
+	skinPackCB(geo, header, reinstance);
+	uploadVertexBuffer(header);
 }
 
 void
@@ -349,6 +352,7 @@ makeSkinPipeline(void)
 	ObjPipeline *pipe = ObjPipeline::create();
 	pipe->instanceCB = skinInstanceCB;
 	pipe->uninstanceCB = skinUninstanceCB;
+	pipe->packCB = skinPackCB;
 	pipe->renderCB = skinRenderCB;
 	pipe->beginUpdate = defaultUpdateCB;
 	pipe->pluginID = ID_SKIN;
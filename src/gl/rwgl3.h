@@ -55,11 +55,16 @@ enum AttribIndices
 	ATTRIB_TEXCOORDS5,
 	ATTRIB_TEXCOORDS6,
 	ATTRIB_TEXCOORDS7,
+	ATTRIB_TANGENT,
 };
 
 // default uniform indices
 extern int32 u_matColor;
 extern int32 u_surfProps;
+extern int32 u_instWorld;
+
+// most atomics in one instanced draw, also in the shaders
+enum { MAX_INSTANCES = 32 };
 
 struct InstanceData
 {
@@ -76,7 +81,8 @@ struct InstanceDataHeader : rw::InstanceDataHeader
 {
 	uint32      serialNumber;
 	uint32      numMeshes;
-	uint16     *indexBuffer;
+	uint16     *indexBuffer;	// really uint32 for GL_UNSIGNED_INT
+	uint32      indexType;
 	uint32      primType;
 	uint8      *vertexBuffer;
 	int32       numAttribs;
@@ -84,6 +90,9 @@ struct InstanceDataHeader : rw::InstanceDataHeader
 	uint32      totalNumIndex;
 	uint32      totalNumVertex;
 
+	uint32      vertexFormat;	// VERTFMT flags of the pipeline
+	uint32      morphSerial;	// of the morph blend in the vertex buffer
+
 	uint32      ibo;
 	uint32      vbo;		// or 2?
 #ifdef RW_GL_USE_VAOS
@@ -99,6 +108,9 @@ struct Shader;
 
 extern Shader *defaultShader, *defaultShader_noAT;
 extern Shader *defaultShader_fullLight, *defaultShader_fullLight_noAT;
+// nil without instancing support
+extern Shader *defaultShader_inst, *defaultShader_inst_noAT;
+extern Shader *defaultShader_inst_fullLight, *defaultShader_inst_fullLight_noAT;
 
 struct Im3DVertex
 {
@@ -215,6 +227,15 @@ void flushCache(void);
 
 #endif
 
+// Compressed vertex attributes, chosen per pipeline
+enum VertexFormat
+{
+	VERTFMT_HALFPOS    = 0x1,	// half float positions
+	VERTFMT_BYTENORMAL = 0x2,	// normalized byte normals
+	VERTFMT_HALFTEX    = 0x4,	// half float texture coordinates
+	VERTFMT_COMPRESSED = 0x7
+};
+
 class ObjPipeline : public rw::ObjPipeline
 {
 public:
@@ -223,22 +244,42 @@ public:
 
 	void (*instanceCB)(Geometry *geo, InstanceDataHeader *header, bool32 reinstance);
 	void (*uninstanceCB)(Geometry *geo, InstanceDataHeader *header);
+	// instanceCB without the GL calls, for prepareInstance; optional
+	void (*packCB)(Geometry *geo, InstanceDataHeader *header, bool32 reinstance);
 	void (*renderCB)(Atomic* atomic, InstanceDataHeader* header);
 	void (*beginUpdate)(Atomic* atomic, InstanceDataHeader* header);
+	// mesh and instanced rendering for RenderQueue,
+	// only the default pipeline has them
+	void (*renderMeshesCB)(MeshDraw *draws, int32 n);
+	void (*renderInstancedCB)(Atomic **atomics, int32 n, InstanceDataHeader *header, WorldLights *lights);
+	uint32 vertexFormat;	// VERTFMT flags for new instance data, default: 0
 };
 
+// instV3d/instTexCoords types for a VERTFMT
+int32 getPosType(uint32 vertexFormat);
+int32 getNormalType(uint32 vertexFormat);
+int32 getTexCoordType(uint32 vertexFormat);
+// set up the GL type of an attribute, returns its 4 byte aligned size
+uint32 setAttribType(AttribDesc *a, int32 type);
+// create the vbo if needed and upload header->vertexBuffer
+void uploadVertexBuffer(InstanceDataHeader *header);
+
 void defaultInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance);
+void defaultPackCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance);
 void defaultUninstanceCB(Geometry *geo, InstanceDataHeader *header);
 void defaultRenderCB(Atomic* atomic, InstanceDataHeader* header);
+void defaultRenderMeshesCB(MeshDraw *draws, int32 n);
+void defaultRenderInstancedCB(Atomic **atomics, int32 n, InstanceDataHeader *header, WorldLights *lights);
 void defaultUpdateCB(Atomic* atomic, InstanceDataHeader* header);
 int32 lightingCB(Atomic *atomic);
 int32 lightingCB(void);
 
-void drawInst_simple(InstanceDataHeader *header, InstanceData *inst);
+// numInstances > 1 needs an instancing shader
+void drawInst_simple(InstanceDataHeader *header, InstanceData *inst, int32 numInstances = 1);
 // Emulate PS2 GS alpha test FB_ONLY case: failed alpha writes to frame- but not to depth buffer
-void drawInst_GSemu(InstanceDataHeader *header, InstanceData *inst);
+void drawInst_GSemu(InstanceDataHeader *header, InstanceData *inst, int32 numInstances = 1);
 // This one switches between the above two depending on render state;
-void drawInst(InstanceDataHeader *header, InstanceData *inst);
+void drawInst(InstanceDataHeader *header, InstanceData *inst, int32 numInstances = 1);
 
 
 void *destroyNativeData(void *object, int32, int32);
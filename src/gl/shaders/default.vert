@@ -1,5 +1,9 @@
 VSIN(ATTRIB_POS)	vec3 in_pos;
 
+#ifdef INSTANCING
+uniform vec4 u_instWorld[3*MAX_INSTANCES];	// rows of the world matrices
+#endif
+
 VSOUT vec4 v_color;
 VSOUT vec2 v_tex0;
 VSOUT float v_fog;
@@ -7,9 +11,16 @@ VSOUT float v_fog;
 void
 main(void)
 {
-	vec4 Vertex = u_world * vec4(in_pos, 1.0);
+#ifdef INSTANCING
+	int i = gl_InstanceID*3;
+	mat4 world = transpose(mat4(u_instWorld[i], u_instWorld[i+1], u_instWorld[i+2],
+		vec4(0.0, 0.0, 0.0, 1.0)));
+#else
+	mat4 world = u_world;
+#endif
+	vec4 Vertex = world * vec4(in_pos, 1.0);
 	gl_Position = u_proj * u_view * Vertex;
-	vec3 Normal = mat3(u_world) * in_normal;
+	vec3 Normal = mat3(world) * in_normal;
 
 	v_tex0 = in_tex0;
 
@@ -10,6 +10,7 @@
 #define ATTRIB_INDICES	4
 #define ATTRIB_TEXCOORDS0	5
 #define ATTRIB_TEXCOORDS1	6
+#define ATTRIB_TANGENT	13
 
 
 VSIN(ATTRIB_NORMAL)	vec3 in_normal;
@@ -0,0 +1,24 @@
+uniform sampler2D tex0;
+uniform sampler2D tex1;
+
+FSIN vec4 v_color;
+FSIN vec2 v_tex0;
+FSIN vec2 v_tex1;
+FSIN float v_fog;
+
+float
+Height(vec2 uv)
+{
+	return dot(texture(tex1, vec2(uv.x, 1.0-uv.y)).rgb, vec3(0.299, 0.587, 0.114));
+}
+
+void
+main(void)
+{
+	vec4 color = v_color*texture(tex0, vec2(v_tex0.x, 1.0-v_tex0.y));
+	// emboss: slopes facing the light get brighter
+	color.rgb *= clamp(1.0 + 2.0*(Height(v_tex0) - Height(v_tex1)), 0.0, 2.0);
+	color.rgb = mix(u_fogColor.rgb, color.rgb, v_fog);
+	DoAlphaTest(color.a);
+	FRAGCOLOR(color);
+}
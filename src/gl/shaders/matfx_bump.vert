@@ -0,0 +1,32 @@
+uniform vec4 u_bumpLight;	// light direction, shift per unit of tangent space
+
+VSIN(ATTRIB_POS)	vec3 in_pos;
+VSIN(ATTRIB_TANGENT)	vec4 in_tangent;
+
+VSOUT vec4 v_color;
+VSOUT vec2 v_tex0;
+VSOUT vec2 v_tex1;
+VSOUT float v_fog;
+
+void
+main(void)
+{
+	vec4 Vertex = u_world * vec4(in_pos, 1.0);
+	gl_Position = u_proj * u_view * Vertex;
+	vec3 Normal = mat3(u_world) * in_normal;
+	vec3 Tangent = mat3(u_world) * in_tangent.xyz;
+	vec3 Bitangent = cross(Normal, Tangent) * in_tangent.w;
+
+	// second height lookup is shifted towards the light in tangent space
+	vec3 L = -u_bumpLight.xyz;
+	v_tex0 = in_tex0;
+	v_tex1 = in_tex0 + vec2(dot(L, Tangent), dot(L, Bitangent))*u_bumpLight.w;
+
+	v_color = in_color;
+	v_color.rgb += u_ambLight.rgb*surfAmbient;
+	v_color.rgb += DoDynamicLight(Vertex.xyz, Normal)*surfDiffuse;
+	v_color = clamp(v_color, 0.0, 1.0);
+	v_color *= u_matColor;
+
+	v_fog = DoFog(gl_Position.w);
+}
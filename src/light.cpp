@@ -27,6 +27,8 @@ worldLightSync(ObjectWithFrame *obj)
 {
 	Light *light = (Light*)obj;
 	light->originalSync(obj);
+	if(light->world && light->getType() >= Light::POINT)
+		light->world->updateLight(light);
 }
 
 Light*
@@ -57,6 +59,8 @@ Light::create(int32 type)
 
 	// world extension
 	light->world = nil;
+	light->ties = nil;
+	light->worldSerial = 0;
 	light->originalSync = light->object.syncCB;
 	light->object.syncCB = worldLightSync;
 
@@ -87,6 +91,15 @@ Light::getAngle(void)
 	return acosf(-this->minusCosAngle);
 }
 
+void
+Light::setRadius(float32 radius)
+{
+	this->radius = radius;
+	// world sectors depend on the radius
+	if(this->world && this->getType() >= POINT)
+		this->world->updateLight(this);
+}
+
 void
 Light::setColor(float32 r, float32 g, float32 b)
 {
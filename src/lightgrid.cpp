@@ -0,0 +1,387 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <float.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+
+#define PLUGIN_ID ID_WORLD
+
+/*
+ * Clustered light assignment.
+ *
+ * Everything happens in camera space (x along the frame's right,
+ * y up, z at). Cluster boxes only depend on the camera's
+ * projection parameters and are kept until those change.
+ * Each light's sphere is mapped to a conservative range of
+ * tiles and slices first, inside that range it is tested against
+ * the cluster boxes one row at a time. The (cluster, light) pairs
+ * found are then sorted into per cluster lists with a counting sort.
+ * Nothing is allocated once the arrays have grown large enough.
+ */
+
+namespace rw {
+
+enum { MINX, MINY, MINZ, MAXX, MAXY, MAXZ };
+enum { MAXROW = 256 };	// most tiles in x
+
+#define BOUNDS(g, i) (&(g)->bounds[(i)*(g)->numClusters])
+
+LightGrid*
+LightGrid::create(int32 tilesX, int32 tilesY, int32 numSlices)
+{
+	assert(tilesX > 0 && tilesX <= MAXROW && tilesY > 0 && numSlices > 0);
+	LightGrid *grid = rwNewT(LightGrid, 1, MEMDUR_EVENT | ID_WORLD);
+	grid->dims[0] = tilesX;
+	grid->dims[1] = tilesY;
+	grid->dims[2] = numSlices;
+	grid->numClusters = tilesX*tilesY*numSlices;
+	grid->depthScale = 0.0f;
+	grid->depthBias = 0.0f;
+	grid->camera = nil;
+	grid->numLights = 0;
+	grid->maxLights = 0;
+	grid->lights = nil;
+	grid->clusterOffsets = rwNewT(uint32, grid->numClusters+1, MEMDUR_EVENT | ID_WORLD);
+	memset(grid->clusterOffsets, 0, (grid->numClusters+1)*sizeof(uint32));
+	grid->numIndices = 0;
+	grid->maxIndices = 0;
+	grid->lightIndices = nil;
+	grid->pairs = nil;
+	grid->bounds = rwNewT(float32, 6*grid->numClusters, MEMDUR_EVENT | ID_WORLD);
+	grid->projection = 0;	// bounds not set up yet
+	return grid;
+}
+
+void
+LightGrid::destroy(void)
+{
+	rwFree(this->lights);
+	rwFree(this->clusterOffsets);
+	rwFree(this->lightIndices);
+	rwFree(this->pairs);
+	rwFree(this->bounds);
+	rwFree(this);
+}
+
+//
+// Camera space mapping
+//
+
+struct GridView
+{
+	int32 persp;
+	float32 xscl, yscl;	// 1/(2*viewWindow)
+	float32 ox, oy;
+	float32 zNear, zFar;
+};
+
+static void
+setupView(GridView *v, Camera *cam)
+{
+	v->persp = cam->projection == Camera::PERSPECTIVE;
+	v->xscl = 1.0f/(2.0f*cam->viewWindow.x);
+	v->yscl = 1.0f/(2.0f*cam->viewWindow.y);
+	v->ox = cam->viewOffset.x;
+	v->oy = cam->viewOffset.y;
+	v->zFar = cam->farPlane;
+	v->zNear = cam->nearPlane;
+	// logarithmic slices need a positive near plane
+	if(v->persp && v->zNear < v->zFar*1.0e-4f)
+		v->zNear = v->zFar*1.0e-4f;
+}
+
+// Screen position in [0,1] of a camera space point,
+// same as the camera's view matrix
+static float32
+screenU(GridView *v, float32 x, float32 z)
+{
+	if(v->persp)
+		return 0.5f + v->xscl*(v->ox*(z - 1.0f) - x)/z;
+	return 0.5f + v->xscl*(v->ox*(z - 1.0f) - x);
+}
+
+static float32
+screenV(GridView *v, float32 y, float32 z)
+{
+	if(v->persp)
+		return 0.5f - v->yscl*(v->oy*(z - 1.0f) + y)/z;
+	return 0.5f - v->yscl*(v->oy*(z - 1.0f) + y);
+}
+
+// inverse of the above
+static float32
+cameraX(GridView *v, float32 u, float32 z)
+{
+	if(v->persp)
+		return v->ox*(z - 1.0f) - (u - 0.5f)*z/v->xscl;
+	return v->ox*(z - 1.0f) - (u - 0.5f)/v->xscl;
+}
+
+static float32
+cameraY(GridView *v, float32 sv, float32 z)
+{
+	if(v->persp)
+		return -v->oy*(z - 1.0f) - (sv - 0.5f)*z/v->yscl;
+	return -v->oy*(z - 1.0f) - (sv - 0.5f)/v->yscl;
+}
+
+static float32
+sliceDepth(LightGrid *grid, GridView *v, int32 slice)
+{
+	float32 t = (float32)slice/grid->dims[2];
+	if(v->persp)
+		return v->zNear*powf(v->zFar/v->zNear, t);
+	return v->zNear + (v->zFar - v->zNear)*t;
+}
+
+static int32
+clampIndex(float32 f, int32 n)
+{
+	if(f < 0.0f)
+		return 0;
+	if(f >= (float32)n)
+		return n-1;
+	return (int32)f;
+}
+
+static void
+setupBounds(LightGrid *grid, Camera *cam, GridView *v)
+{
+	int32 x, y, z, i;
+	grid->viewWindow = cam->viewWindow;
+	grid->viewOffset = cam->viewOffset;
+	grid->nearPlane = cam->nearPlane;
+	grid->farPlane = cam->farPlane;
+	grid->projection = cam->projection;
+	if(v->persp){
+		grid->depthScale = grid->dims[2]/logf(v->zFar/v->zNear);
+		grid->depthBias = -logf(v->zNear)*grid->depthScale;
+	}else{
+		grid->depthScale = grid->dims[2]/(v->zFar - v->zNear);
+		grid->depthBias = -v->zNear*grid->depthScale;
+	}
+
+	float32 *b[6];
+	for(i = 0; i < 6; i++)
+		b[i] = BOUNDS(grid, i);
+	int32 c = 0;
+	for(z = 0; z < grid->dims[2]; z++){
+		float32 zs[2] = { sliceDepth(grid, v, z), sliceDepth(grid, v, z+1) };
+		for(y = 0; y < grid->dims[1]; y++){
+			float32 vs[2] = { (float32)y/grid->dims[1], (float32)(y+1)/grid->dims[1] };
+			for(x = 0; x < grid->dims[0]; x++){
+				float32 us[2] = { (float32)x/grid->dims[0], (float32)(x+1)/grid->dims[0] };
+				b[MINX][c] = b[MINY][c] = FLT_MAX;
+				b[MAXX][c] = b[MAXY][c] = -FLT_MAX;
+				b[MINZ][c] = zs[0];
+				b[MAXZ][c] = zs[1];
+				// x and y are linear in z so the corners bound the cluster
+				for(i = 0; i < 8; i++){
+					float32 px = cameraX(v, us[i&1], zs[i>>2]);
+					float32 py = cameraY(v, vs[(i>>1)&1], zs[i>>2]);
+					b[MINX][c] = fminf(b[MINX][c], px);
+					b[MAXX][c] = fmaxf(b[MAXX][c], px);
+					b[MINY][c] = fminf(b[MINY][c], py);
+					b[MAXY][c] = fmaxf(b[MAXY][c], py);
+				}
+				c++;
+			}
+		}
+	}
+}
+
+// Conservative cluster range of a camera space sphere,
+// returns 0 if it's outside the depth range.
+// u and v are monotonic in x, y and z so the box corners
+// give their extremes.
+static bool32
+sphereRange(LightGrid *grid, GridView *v, V3d c, float32 r, int32 *lo, int32 *hi)
+{
+	float32 z0 = c.z - r;
+	float32 z1 = c.z + r;
+	if(z1 < v->zNear || z0 > v->zFar)
+		return 0;
+	z0 = fmaxf(z0, v->zNear);
+	z1 = fminf(z1, v->zFar);
+	float32 u0 = FLT_MAX, u1 = -FLT_MAX;
+	float32 v0 = FLT_MAX, v1 = -FLT_MAX;
+	for(int32 i = 0; i < 4; i++){
+		float32 z = i&2 ? z1 : z0;
+		float32 u = screenU(v, i&1 ? c.x+r : c.x-r, z);
+		float32 sv = screenV(v, i&1 ? c.y+r : c.y-r, z);
+		u0 = fminf(u0, u); u1 = fmaxf(u1, u);
+		v0 = fminf(v0, sv); v1 = fmaxf(v1, sv);
+	}
+	if(u1 < 0.0f || u0 > 1.0f || v1 < 0.0f || v0 > 1.0f)
+		return 0;
+	lo[0] = clampIndex(u0*grid->dims[0], grid->dims[0]);
+	hi[0] = clampIndex(u1*grid->dims[0], grid->dims[0]);
+	lo[1] = clampIndex(v0*grid->dims[1], grid->dims[1]);
+	hi[1] = clampIndex(v1*grid->dims[1], grid->dims[1]);
+	if(v->persp){
+		lo[2] = clampIndex(logf(z0)*grid->depthScale + grid->depthBias, grid->dims[2]);
+		hi[2] = clampIndex(logf(z1)*grid->depthScale + grid->depthBias, grid->dims[2]);
+	}else{
+		lo[2] = clampIndex(z0*grid->depthScale + grid->depthBias, grid->dims[2]);
+		hi[2] = clampIndex(z1*grid->depthScale + grid->depthBias, grid->dims[2]);
+	}
+	return 1;
+}
+
+static void
+toCamera(Camera *cam, const V3d *p, V3d *out)
+{
+	Matrix *ltm = cam->getFrame()->getLTM();
+	V3d d = sub(*p, ltm->pos);
+	out->x = dot(d, ltm->right);
+	out->y = dot(d, ltm->up);
+	out->z = dot(d, ltm->at);
+}
+
+//
+// Building
+//
+
+// Lights can also come from elsewhere:
+// begin, addSphere for each light, then end.
+void
+LightGrid::begin(Camera *cam)
+{
+	GridView v;
+
+	this->camera = nil;
+	this->numLights = 0;
+	this->numIndices = 0;
+	memset(this->clusterOffsets, 0, (this->numClusters+1)*sizeof(uint32));
+	if(cam->getFrame() == nil)
+		return;
+	this->camera = cam;
+	setupView(&v, cam);
+	if(this->projection != cam->projection ||
+	   this->viewWindow.x != cam->viewWindow.x || this->viewWindow.y != cam->viewWindow.y ||
+	   this->viewOffset.x != cam->viewOffset.x || this->viewOffset.y != cam->viewOffset.y ||
+	   this->nearPlane != cam->nearPlane || this->farPlane != cam->farPlane)
+		setupBounds(this, cam, &v);
+}
+
+int32
+LightGrid::addSphere(const Sphere *s)
+{
+	int32 i, x, y, z;
+	int32 lo[3], hi[3];
+	GridView v;
+	uint8 hit[MAXROW];
+	Camera *cam = this->camera;
+
+	if(cam == nil || s->radius <= 0.0f || this->numLights >= 0xFFFF)
+		return -1;
+	if(cam->frustumTestSphere(s) == Camera::SPHEREOUTSIDE)
+		return -1;
+	setupView(&v, cam);
+	V3d c;
+	toCamera(cam, &s->center, &c);
+	if(!sphereRange(this, &v, c, s->radius, lo, hi))
+		return -1;
+
+	if(this->numLights >= this->maxLights){
+		this->maxLights = this->maxLights ? 2*this->maxLights : 64;
+		this->lights = rwResizeT(Light*, this->lights, this->maxLights, MEMDUR_EVENT | ID_WORLD);
+	}
+	int32 li = this->numLights++;
+	this->lights[li] = nil;
+
+	float32 *b[6];
+	for(i = 0; i < 6; i++)
+		b[i] = BOUNDS(this, i);
+	float32 r2 = s->radius*s->radius;
+	int32 n = hi[0] - lo[0] + 1;
+	for(z = lo[2]; z <= hi[2]; z++)
+	for(y = lo[1]; y <= hi[1]; y++){
+		int32 first = this->getCluster(lo[0], y, z);
+		// sphere against the boxes of one row
+		float32 *minx = &b[MINX][first], *maxx = &b[MAXX][first];
+		float32 *miny = &b[MINY][first], *maxy = &b[MAXY][first];
+		float32 *minz = &b[MINZ][first], *maxz = &b[MAXZ][first];
+		for(x = 0; x < n; x++){
+			float32 dx = fmaxf(fmaxf(minx[x] - c.x, c.x - maxx[x]), 0.0f);
+			float32 dy = fmaxf(fmaxf(miny[x] - c.y, c.y - maxy[x]), 0.0f);
+			float32 dz = fmaxf(fmaxf(minz[x] - c.z, c.z - maxz[x]), 0.0f);
+			hit[x] = dx*dx + dy*dy + dz*dz <= r2;
+		}
+		for(x = 0; x < n; x++){
+			if(!hit[x])
+				continue;
+			int32 numPairs = this->numIndices;
+			if(numPairs >= this->maxIndices){
+				this->maxIndices = this->maxIndices ? 2*this->maxIndices : 1024;
+				this->pairs = rwResizeT(int32, this->pairs, 2*this->maxIndices, MEMDUR_EVENT | ID_WORLD);
+				this->lightIndices = rwResizeT(uint16, this->lightIndices, this->maxIndices, MEMDUR_EVENT | ID_WORLD);
+			}
+			this->pairs[2*numPairs] = first + x;
+			this->pairs[2*numPairs+1] = li;
+			this->clusterOffsets[first + x + 1]++;
+			this->numIndices++;
+		}
+	}
+	return li;
+}
+
+void
+LightGrid::end(void)
+{
+	int32 i;
+	// counting sort by cluster, lights stay in order within a cluster
+	for(i = 0; i < this->numClusters; i++)
+		this->clusterOffsets[i+1] += this->clusterOffsets[i];
+	for(i = 0; i < this->numIndices; i++){
+		int32 cl = this->pairs[2*i];
+		uint32 dst = this->clusterOffsets[cl]++;
+		this->lightIndices[dst] = this->pairs[2*i+1];
+	}
+	// the offsets moved one cluster ahead
+	for(i = this->numClusters; i > 0; i--)
+		this->clusterOffsets[i] = this->clusterOffsets[i-1];
+	this->clusterOffsets[0] = 0;
+}
+
+void
+LightGrid::build(World *world, Camera *cam)
+{
+	this->begin(cam);
+	FORLIST(lnk, world->localLights){
+		Light *l = Light::fromWorld(lnk);
+		if(l->getFrame() == nil)
+			continue;
+		Sphere s;
+		s.center = l->getFrame()->getLTM()->pos;
+		s.radius = l->radius;
+		int32 li = this->addSphere(&s);
+		if(li >= 0)
+			this->lights[li] = l;
+	}
+	this->end();
+}
+
+bool32
+LightGrid::getClusterRange(const Sphere *s, int32 *lo, int32 *hi)
+{
+	GridView v;
+	V3d c;
+	Camera *cam = this->camera;
+	if(cam == nil || cam->getFrame() == nil ||
+	   cam->frustumTestSphere(s) != Camera::SPHEREINSIDE)
+		return 0;
+	setupView(&v, cam);
+	toCamera(cam, &s->center, &c);
+	return sphereRange(this, &v, c, s->radius, lo, hi);
+}
+
+}
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+#include "rwanim.h"
+#include "rwplugins.h"
+
+#define PLUGIN_ID ID_LODATOMIC
+
+/*
+ * The LOD geometries are only swapped in for the duration of
+ * the render callback, so everything else (bounds, collision,
+ * the clump's geometry list) only ever sees LOD 0.
+ * Nothing is streamed, existing LOD Atomic chunks are skipped.
+ */
+
+namespace rw {
+
+LODAtomicGlobals lodAtomicGlobals = { 0, 1.0f, 0.1f };
+static int32 lodHistogram[LODAtomic::MAXLODS];
+
+static void
+updateNumLods(LODAtomic *lod)
+{
+	lod->numLods = 1;
+	for(int32 i = 1; i < LODAtomic::MAXLODS; i++)
+		if(lod->geometry[i])
+			lod->numLods = i+1;
+}
+
+void
+LODAtomic::setGeometry(Atomic *atomic, int32 lod, Geometry *geo)
+{
+	LODAtomic *l = LODAtomic::get(atomic);
+	assert(lod > 0 && lod < MAXLODS);
+	if(geo)
+		geo->addRef();
+	if(l->geometry[lod])
+		l->geometry[lod]->destroy();
+	l->geometry[lod] = geo;
+	updateNumLods(l);
+}
+
+Geometry*
+LODAtomic::getGeometry(Atomic *atomic, int32 lod)
+{
+	if(lod == 0)
+		return atomic->geometry;
+	return LODAtomic::get(atomic)->geometry[lod];
+}
+
+void
+LODAtomic::setMinSize(Atomic *atomic, int32 lod, float32 size)
+{
+	assert(lod >= 0 && lod < MAXLODS);
+	LODAtomic::get(atomic)->minSize[lod] = size;
+}
+
+int32
+LODAtomic::generate(Atomic *atomic, int32 numLods, float32 ratio, float32 maxError)
+{
+	Geometry *src = atomic->geometry;
+	int32 i;
+	if(numLods > MAXLODS)
+		numLods = MAXLODS;
+	int32 prevTris = src->numTriangles;
+	float32 target = src->numTriangles;
+	for(i = 1; i < numLods; i++){
+		target *= ratio;
+		// always simplify the original to keep the error down
+		Geometry *geo = src->simplify((int32)target, maxError);
+		if(geo == nil)
+			break;
+		if(geo->numTriangles >= prevTris){
+			// hit the error limit
+			geo->destroy();
+			break;
+		}
+		prevTris = geo->numTriangles;
+		LODAtomic::setGeometry(atomic, i, geo);
+		geo->destroy();
+	}
+	for(; i < MAXLODS; i++)
+		LODAtomic::setGeometry(atomic, i, nil);
+	return LODAtomic::get(atomic)->numLods;
+}
+
+float32
+LODAtomic::getProjectedSize(Atomic *atomic, Camera *cam)
+{
+	Sphere *s = atomic->getWorldBoundingSphere();
+	if(cam->projection == Camera::PARALLEL)
+		return s->radius/cam->viewWindow.y;
+	Matrix *camMat = cam->getFrame()->getLTM();
+	float32 dist = dot(sub(s->center, camMat->pos), camMat->at);
+	if(dist <= s->radius)
+		return 1.0e10f;
+	// viewWindow is half the view at distance 1,
+	// so this is the diameter relative to the view height
+	return s->radius/(dist*cam->viewWindow.y);
+}
+
+// minSize[i] is the switch between LOD i and i+1,
+// moved away from the current LOD by the hysteresis
+// if that was picked for the same camera
+int32
+LODAtomic::selectLod(Atomic *atomic, Camera *cam)
+{
+	LODAtomic *l = LODAtomic::get(atomic);
+	if(l->numLods == 1)
+		return 0;
+	float32 size = LODAtomic::getProjectedSize(atomic, cam)*lodAtomicGlobals.bias;
+	float32 h = l->camera == cam ? lodAtomicGlobals.hysteresis : 0.0f;
+	int32 i;
+	for(i = 0; i < l->numLods-1; i++){
+		float32 threshold = l->minSize[i]*(i < l->currentLod ? 1.0f+h : 1.0f-h);
+		if(l->geometry[i+1] == nil || size >= threshold)
+			break;
+	}
+	return i;
+}
+
+void
+LODAtomic::getHistogram(int32 *counts)
+{
+	memcpy(counts, lodHistogram, sizeof(lodHistogram));
+}
+
+void
+LODAtomic::resetHistogram(void)
+{
+	memset(lodHistogram, 0, sizeof(lodHistogram));
+}
+
+static void
+lodRenderCB(Atomic *atomic)
+{
+	LODAtomic *l = LODAtomic::get(atomic);
+	Camera *cam = (Camera*)engine->currentCamera;
+	l->currentLod = LODAtomic::selectLod(atomic, cam);
+	l->camera = cam;
+	lodHistogram[l->currentLod]++;
+	if(l->currentLod == 0){
+		l->renderCB(atomic);
+		return;
+	}
+	Geometry *geo = atomic->geometry;
+	atomic->geometry = l->geometry[l->currentLod];
+	l->renderCB(atomic);
+	atomic->geometry = geo;
+}
+
+void
+LODAtomic::hookRender(Atomic *atomic)
+{
+	LODAtomic *l = LODAtomic::get(atomic);
+	if(atomic->renderCB == lodRenderCB)
+		return;
+	l->renderCB = atomic->renderCB;
+	atomic->setRenderCB(lodRenderCB);
+}
+
+void
+LODAtomic::unhookRender(Atomic *atomic)
+{
+	LODAtomic *l = LODAtomic::get(atomic);
+	if(atomic->renderCB != lodRenderCB)
+		return;
+	atomic->setRenderCB(l->renderCB);
+	l->renderCB = nil;
+}
+
+static void*
+createLODAtomic(void *object, int32 offset, int32)
+{
+	LODAtomic *l = PLUGINOFFSET(LODAtomic, object, offset);
+	float32 size = 0.25f;
+	for(int32 i = 0; i < LODAtomic::MAXLODS; i++){
+		l->geometry[i] = nil;
+		l->minSize[i] = size;
+		size *= 0.5f;
+	}
+	l->numLods = 1;
+	l->currentLod = 0;
+	l->camera = nil;
+	l->renderCB = nil;
+	return object;
+}
+
+static void*
+destroyLODAtomic(void *object, int32 offset, int32)
+{
+	LODAtomic *l = PLUGINOFFSET(LODAtomic, object, offset);
+	for(int32 i = 1; i < LODAtomic::MAXLODS; i++)
+		if(l->geometry[i]){
+			l->geometry[i]->destroy();
+			l->geometry[i] = nil;
+		}
+	return object;
+}
+
+static void*
+copyLODAtomic(void *dst, void *src, int32 offset, int32)
+{
+	LODAtomic *dstl = PLUGINOFFSET(LODAtomic, dst, offset);
+	LODAtomic *srcl = PLUGINOFFSET(LODAtomic, src, offset);
+	*dstl = *srcl;
+	for(int32 i = 1; i < LODAtomic::MAXLODS; i++)
+		if(dstl->geometry[i])
+			dstl->geometry[i]->addRef();
+	return dst;
+}
+
+void
+registerLODAtomicPlugin(void)
+{
+	lodAtomicGlobals.atomicOffset =
+	Atomic::registerPlugin(sizeof(LODAtomic), ID_LODATOMIC,
+	                       createLODAtomic, destroyLODAtomic, copyLODAtomic);
+}
+
+}
@@ -0,0 +1,419 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+#include "rwanim.h"
+#include "rwplugins.h"
+
+#define PLUGIN_ID ID_MESHLETS
+
+/*
+ * Meshlets split the triangle list meshes of a geometry into
+ * small runs of triangles with a bounding sphere and a normal cone,
+ * so a renderer can cull parts of big atomics against the frustum
+ * and backface cull whole meshlets.
+ * Since a meshlet is just a range of a mesh's indices it can be
+ * drawn with the regular index buffer.
+ */
+
+namespace rw {
+
+MeshletGlobals meshletGlobals = { 0, 0, nil, 0 };
+
+#define GETMESHLETS(geo) (*PLUGINOFFSET(Meshlets*, geo, meshletGlobals.geoOffset))
+
+static Meshlets*
+allocMeshlets(int32 numMeshes, int32 numMeshlets)
+{
+	uint32 sz = sizeof(Meshlets) + numMeshlets*sizeof(Meshlet) + (numMeshes+1)*sizeof(int32);
+	Meshlets *ml = (Meshlets*)rwNew(sz, MEMDUR_EVENT | ID_MESHLETS);
+	ml->numMeshes = numMeshes;
+	ml->numMeshlets = numMeshlets;
+	ml->meshlets = (Meshlet*)(ml+1);
+	ml->meshStart = (int32*)(ml->meshlets + numMeshlets);
+	ml->serialNum = 0;
+	return ml;
+}
+
+static void
+setupMeshStart(Meshlets *ml)
+{
+	int32 i, j;
+	j = 0;
+	for(i = 0; i < ml->numMeshes; i++){
+		ml->meshStart[i] = j;
+		while(j < ml->numMeshlets && ml->meshlets[j].meshIndex == i)
+			j++;
+	}
+	ml->meshStart[ml->numMeshes] = j;
+}
+
+/* Greedily split a triangle list into meshlets in index order.
+ * Only counts if out is nil. stamp has one entry per vertex. */
+static int32
+splitMesh(Mesh *m, uint32 *stamp, uint32 *curStamp, Meshlet *out)
+{
+	uint32 v[3];
+	int32 n = 0;
+	int32 numVerts = 0;
+	int32 numTris = 0;
+	uint32 first = 0;
+	uint32 cur = ++*curStamp;
+	for(uint32 i = 0; i+2 < m->numIndices; i += 3){
+		v[0] = m->getIndex(i);
+		v[1] = m->getIndex(i+1);
+		v[2] = m->getIndex(i+2);
+		int32 newVerts = (stamp[v[0]] != cur) +
+			(stamp[v[1]] != cur && v[1] != v[0]) +
+			(stamp[v[2]] != cur && v[2] != v[0] && v[2] != v[1]);
+		if(numVerts + newVerts > Meshlets::MAXVERTICES ||
+		   numTris == Meshlets::MAXTRIANGLES){
+			if(out){
+				out[n].firstIndex = first;
+				out[n].numVertices = numVerts;
+				out[n].numTriangles = numTris;
+			}
+			n++;
+			first = i;
+			numVerts = 0;
+			numTris = 0;
+			cur = ++*curStamp;
+			newVerts = 1 + (v[1] != v[0]) + (v[2] != v[0] && v[2] != v[1]);
+		}
+		stamp[v[0]] = cur;
+		stamp[v[1]] = cur;
+		stamp[v[2]] = cur;
+		numVerts += newVerts;
+		numTris++;
+	}
+	if(numTris){
+		if(out){
+			out[n].firstIndex = first;
+			out[n].numVertices = numVerts;
+			out[n].numTriangles = numTris;
+		}
+		n++;
+	}
+	return n;
+}
+
+static void
+calculateBounds(Meshlet *ml, Mesh *m, V3d *verts)
+{
+	uint32 i, end;
+	V3d min = {  1000000.0f,  1000000.0f,  1000000.0f };
+	V3d max = { -1000000.0f, -1000000.0f, -1000000.0f };
+	V3d sum = { 0.0f, 0.0f, 0.0f };
+	V3d n[Meshlets::MAXTRIANGLES];
+	int32 numNormals;
+
+	end = ml->firstIndex + ml->numTriangles*3;
+	for(i = ml->firstIndex; i < end; i++){
+		V3d *v = &verts[m->getIndex(i)];
+		if(v->x > max.x) max.x = v->x;
+		if(v->x < min.x) min.x = v->x;
+		if(v->y > max.y) max.y = v->y;
+		if(v->y < min.y) min.y = v->y;
+		if(v->z > max.z) max.z = v->z;
+		if(v->z < min.z) min.z = v->z;
+	}
+	ml->boundingSphere.center = scale(add(min, max), 0.5f);
+	float32 r2 = 0.0f;
+	for(i = ml->firstIndex; i < end; i++){
+		V3d d = sub(verts[m->getIndex(i)], ml->boundingSphere.center);
+		if(dot(d, d) > r2)
+			r2 = dot(d, d);
+	}
+	ml->boundingSphere.radius = sqrtf(r2);
+
+	// Normal cone. Front faces are counter-clockwise.
+	numNormals = 0;
+	for(i = ml->firstIndex; i < end; i += 3){
+		V3d *a = &verts[m->getIndex(i)];
+		V3d *b = &verts[m->getIndex(i+1)];
+		V3d *c = &verts[m->getIndex(i+2)];
+		V3d nrm = cross(sub(*b, *a), sub(*c, *a));
+		float32 len = length(nrm);
+		// degenerate triangles can't be seen anyway
+		if(len < 1.0e-12f)
+			continue;
+		n[numNormals] = scale(nrm, 1.0f/len);
+		sum = add(sum, n[numNormals]);
+		numNormals++;
+	}
+	float32 len = length(sum);
+	if(numNormals == 0 || len < 1.0e-6f){
+		ml->coneAxis = makeV3d(0.0f, 0.0f, 1.0f);
+		ml->coneCos = -1.0f;
+		return;
+	}
+	ml->coneAxis = scale(sum, 1.0f/len);
+	ml->coneCos = 1.0f;
+	for(int32 j = 0; j < numNormals; j++){
+		float32 d = dot(n[j], ml->coneAxis);
+		if(d < ml->coneCos)
+			ml->coneCos = d;
+	}
+}
+
+Meshlets*
+Meshlets::build(Geometry *geo)
+{
+	MeshHeader *mh = geo->meshHeader;
+	Meshlets::remove(geo);
+	if(geo->flags & Geometry::NATIVE || mh == nil ||
+	   mh->flags == MeshHeader::TRISTRIP || geo->numVertices == 0)
+		return nil;
+	Mesh *m = mh->getMeshes();
+	if(m->indices == nil && m->indices32 == nil)
+		return nil;
+
+	uint32 *stamp = rwNewT(uint32, geo->numVertices, MEMDUR_FUNCTION | ID_MESHLETS);
+	memset(stamp, 0, geo->numVertices*sizeof(uint32));
+	uint32 curStamp = 0;
+	int32 numMeshlets = 0;
+	for(uint32 i = 0; i < mh->numMeshes; i++)
+		numMeshlets += splitMesh(&m[i], stamp, &curStamp, nil);
+
+	Meshlets *ml = allocMeshlets(mh->numMeshes, numMeshlets);
+	ml->serialNum = mh->serialNum;
+	Meshlet *out = ml->meshlets;
+	for(uint32 i = 0; i < mh->numMeshes; i++){
+		int32 n = splitMesh(&m[i], stamp, &curStamp, out);
+		for(int32 j = 0; j < n; j++){
+			out[j].meshIndex = i;
+			calculateBounds(&out[j], &m[i], geo->morphTargets[0].vertices);
+		}
+		out += n;
+	}
+	setupMeshStart(ml);
+	rwFree(stamp);
+
+	GETMESHLETS(geo) = ml;
+	return ml;
+}
+
+void
+Meshlets::remove(Geometry *geo)
+{
+	if(meshletGlobals.geoOffset == 0)
+		return;
+	rwFree(GETMESHLETS(geo));
+	GETMESHLETS(geo) = nil;
+}
+
+Meshlets*
+Meshlets::get(Geometry *geo)
+{
+	if(meshletGlobals.geoOffset == 0)
+		return nil;
+	Meshlets *ml = GETMESHLETS(geo);
+	if(ml == nil || geo->meshHeader == nil ||
+	   ml->serialNum != geo->meshHeader->serialNum)
+		return nil;
+	return ml;
+}
+
+bool32
+Meshlet::isBackfacing(const V3d *eye)
+{
+	if(this->coneCos <= 0.0f)
+		return 0;
+	// The meshlet is backfacing if the eye is behind all triangle
+	// planes, i.e. d.n >= radius for every normal n in the cone.
+	// The worst n is tilted by the cone angle away from d.
+	V3d d = sub(this->boundingSphere.center, *eye);
+	float32 len = length(d);
+	if(len <= this->boundingSphere.radius)
+		return 0;
+	float32 cosPhi = dot(d, this->coneAxis)/len;
+	float32 sinPhi = sqrtf(fmaxf(0.0f, 1.0f - cosPhi*cosPhi));
+	float32 sinTheta = sqrtf(1.0f - this->coneCos*this->coneCos);
+	float32 cosSum = cosPhi*this->coneCos - sinPhi*sinTheta;
+	return cosPhi > 0.0f && len*cosSum > this->boundingSphere.radius;
+}
+
+// The backface test happens in object space, which any affine
+// transformation keeps correct. Spheres are scaled by the largest axis.
+int32
+Meshlets::cull(Atomic *atomic, Camera *cam, bool32 cullBack, uint8 *visible)
+{
+	Matrix inv;
+	V3d eye;
+	Sphere s;
+	int32 numVisible = 0;
+	Matrix *ltm = atomic->getFrame()->getLTM();
+	if(cullBack){
+		Matrix::invert(&inv, ltm);
+		V3d::transformPoints(&eye, &cam->getFrame()->getLTM()->pos, 1, &inv);
+	}
+	float32 sx = dot(ltm->right, ltm->right);
+	float32 sy = dot(ltm->up, ltm->up);
+	float32 sz = dot(ltm->at, ltm->at);
+	float32 maxScale = sx > sy ? sx : sy;
+	maxScale = sqrtf(sz > maxScale ? sz : maxScale);
+	Meshlet *m = this->meshlets;
+	for(int32 i = 0; i < this->numMeshlets; i++){
+		V3d::transformPoints(&s.center, &m->boundingSphere.center, 1, ltm);
+		s.radius = m->boundingSphere.radius*maxScale;
+		visible[i] = cam->frustumTestSphere(&s) != Camera::SPHEREOUTSIDE &&
+			!(cullBack && m->isBackfacing(&eye));
+		numVisible += visible[i];
+		m++;
+	}
+	return numVisible;
+}
+
+uint8*
+Meshlets::getVisibleBuffer(int32 n)
+{
+	if(n > meshletGlobals.maxVisible){
+		meshletGlobals.maxVisible = n;
+		meshletGlobals.visible = rwResizeT(uint8, meshletGlobals.visible, n, MEMDUR_GLOBAL | ID_MESHLETS);
+	}
+	return meshletGlobals.visible;
+}
+
+static void*
+meshletOpen(void *object, int32, int32)
+{
+	meshletGlobals.visible = nil;
+	meshletGlobals.maxVisible = 0;
+	return object;
+}
+
+static void*
+meshletClose(void *object, int32, int32)
+{
+	rwFree(meshletGlobals.visible);
+	meshletGlobals.visible = nil;
+	meshletGlobals.maxVisible = 0;
+	return object;
+}
+
+static void*
+createMeshlets(void *object, int32 offset, int32)
+{
+	*PLUGINOFFSET(Meshlets*, object, offset) = nil;
+	return object;
+}
+
+static void*
+destroyMeshlets(void *object, int32 offset, int32)
+{
+	rwFree(*PLUGINOFFSET(Meshlets*, object, offset));
+	*PLUGINOFFSET(Meshlets*, object, offset) = nil;
+	return object;
+}
+
+static void*
+copyMeshlets(void *dst, void *src, int32 offset, int32)
+{
+	Meshlets *srcml = *PLUGINOFFSET(Meshlets*, src, offset);
+	if(srcml == nil)
+		return dst;
+	Meshlets *dstml = allocMeshlets(srcml->numMeshes, srcml->numMeshlets);
+	memcpy(dstml->meshlets, srcml->meshlets, srcml->numMeshlets*sizeof(Meshlet));
+	setupMeshStart(dstml);
+	dstml->serialNum = 0;	// until the copy has meshes
+	*PLUGINOFFSET(Meshlets*, dst, offset) = dstml;
+	return dst;
+}
+
+static Stream*
+readMeshlets(Stream *stream, int32, void *object, int32 offset, int32)
+{
+	int32 numMeshes = stream->readI32();
+	int32 numMeshlets = stream->readI32();
+	Meshlets *ml = allocMeshlets(numMeshes, numMeshlets);
+	Meshlet *m = ml->meshlets;
+	for(int32 i = 0; i < numMeshlets; i++){
+		stream->read32(&m->boundingSphere, 16);
+		stream->read32(&m->coneAxis, 12);
+		m->coneCos = stream->readF32();
+		m->firstIndex = stream->readU32();
+		uint32 info = stream->readU32();
+		m->meshIndex = info & 0xFFFF;
+		m->numVertices = (info >> 16) & 0xFF;
+		m->numTriangles = (info >> 24) & 0xFF;
+		m++;
+	}
+	setupMeshStart(ml);
+	rwFree(*PLUGINOFFSET(Meshlets*, object, offset));
+	*PLUGINOFFSET(Meshlets*, object, offset) = ml;
+	return stream;
+}
+
+static Stream*
+writeMeshlets(Stream *stream, int32, void *object, int32 offset, int32)
+{
+	Meshlets *ml = *PLUGINOFFSET(Meshlets*, object, offset);
+	stream->writeI32(ml->numMeshes);
+	stream->writeI32(ml->numMeshlets);
+	Meshlet *m = ml->meshlets;
+	for(int32 i = 0; i < ml->numMeshlets; i++){
+		stream->write32(&m->boundingSphere, 16);
+		stream->write32(&m->coneAxis, 12);
+		stream->writeF32(m->coneCos);
+		stream->writeU32(m->firstIndex);
+		stream->writeU32(m->meshIndex | m->numVertices<<16 | m->numTriangles<<24);
+		m++;
+	}
+	return stream;
+}
+
+static int32
+getSizeMeshlets(void *object, int32, int32)
+{
+	// don't write out of date meshlets
+	Meshlets *ml = Meshlets::get((Geometry*)object);
+	if(ml == nil)
+		return 0;
+	return 8 + ml->numMeshlets*40;
+}
+
+// The mesh header may be read after us, so check here
+// that the meshlets actually fit the meshes.
+static void
+meshletsAlways(void *object, int32 offset, int32)
+{
+	Geometry *geo = (Geometry*)object;
+	Meshlets *ml = *PLUGINOFFSET(Meshlets*, object, offset);
+	if(ml == nil)
+		return;
+	MeshHeader *mh = geo->meshHeader;
+	if(mh == nil || mh->flags == MeshHeader::TRISTRIP ||
+	   mh->numMeshes != ml->numMeshes)
+		goto fail;
+	for(int32 i = 0; i < ml->numMeshlets; i++){
+		Meshlet *m = &ml->meshlets[i];
+		if(m->meshIndex >= mh->numMeshes ||
+		   m->firstIndex + m->numTriangles*3 > mh->getMeshes()[m->meshIndex].numIndices)
+			goto fail;
+	}
+	ml->serialNum = mh->serialNum;
+	return;
+fail:
+	rwFree(ml);
+	*PLUGINOFFSET(Meshlets*, object, offset) = nil;
+}
+
+void
+registerMeshletPlugin(void)
+{
+	Engine::registerPlugin(0, ID_MESHLETS, meshletOpen, meshletClose);
+	meshletGlobals.geoOffset = Geometry::registerPlugin(sizeof(Meshlets*), ID_MESHLETS,
+		createMeshlets, destroyMeshlets, copyMeshlets);
+	Geometry::registerPluginStream(ID_MESHLETS, readMeshlets, writeMeshlets, getSizeMeshlets);
+	Geometry::setStreamAlwaysCallback(ID_MESHLETS, meshletsAlways);
+}
+
+}
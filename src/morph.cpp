@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+#include "rwanim.h"
+#include "rwplugins.h"
+
+#define PLUGIN_ID ID_MORPH
+
+/*
+ * Interpolation between the morph targets of an atomic's geometry.
+ * An atomic blends from a start to an end target, either set directly
+ * or driven by an animation of MorphKeyFrames.
+ * Every change gets a new global serial number so instance code
+ * can tell whether its vertex buffer is still up to date.
+ * Serial 0 always means plain morph target 0.
+ */
+
+namespace rw {
+
+MorphGlobals morphGlobals = { 0, 0 };
+
+//
+// Blending
+//
+
+void
+Morph::blend(V3d *dst, V3d *a, V3d *b, int32 n, float32 t)
+{
+	float32 *d = (float32*)dst;
+	float32 *fa = (float32*)a;
+	float32 *fb = (float32*)b;
+	n *= 3;
+	for(int32 i = 0; i < n; i++)
+		d[i] = fa[i] + (fb[i] - fa[i])*t;
+}
+
+void
+Morph::blendStrided(uint8 *dst, int32 stride, V3d *a, V3d *b, int32 n, float32 t)
+{
+	for(int32 i = 0; i < n; i++){
+		float32 *d = (float32*)dst;
+		d[0] = a[i].x + (b[i].x - a[i].x)*t;
+		d[1] = a[i].y + (b[i].y - a[i].y)*t;
+		d[2] = a[i].z + (b[i].z - a[i].z)*t;
+		dst += stride;
+	}
+}
+
+static void
+mergeSpheres(Sphere *dst, Sphere *a, Sphere *b)
+{
+	V3d d = sub(b->center, a->center);
+	float32 dist = length(d);
+	if(dist + b->radius <= a->radius){
+		*dst = *a;
+		return;
+	}
+	if(dist + a->radius <= b->radius){
+		*dst = *b;
+		return;
+	}
+	float32 r = (dist + a->radius + b->radius)*0.5f;
+	dst->center = add(a->center, scale(d, (r - a->radius)/dist));
+	dst->radius = r;
+}
+
+static void
+mergeBoxes(BBox *dst, BBox *a, BBox *b)
+{
+	dst->inf = a->inf;
+	dst->sup = a->sup;
+	dst->addPoint(&b->inf);
+	dst->addPoint(&b->sup);
+}
+
+void
+Morph::setInterpolation(Atomic *atomic, int32 start, int32 end, float32 t)
+{
+	MorphAtomic *m = Morph::get(atomic);
+	Geometry *geo = atomic->geometry;
+	assert(start >= 0 && start < geo->numMorphTargets);
+	assert(end >= 0 && end < geo->numMorphTargets);
+	if(t <= 0.0f){
+		end = start;
+		t = 0.0f;
+	}else if(t >= 1.0f){
+		start = end;
+		t = 0.0f;
+	}
+	if(m->startTarget == start && m->endTarget == end && m->t == t)
+		return;
+	m->startTarget = start;
+	m->endTarget = end;
+	m->t = t;
+	m->serial = start == 0 && end == 0 ? 0 : ++morphGlobals.serial;
+
+	// the blend lies within both targets' bounds
+	MorphTarget *mt1 = &geo->morphTargets[start];
+	MorphTarget *mt2 = &geo->morphTargets[end];
+	mergeSpheres(&atomic->boundingSphere, &mt1->boundingSphere, &mt2->boundingSphere);
+	mergeBoxes(&atomic->boundingBox, &mt1->boundingBox, &mt2->boundingBox);
+	atomic->object.object.privateFlags |= Atomic::WORLDBOUNDDIRTY;
+	if(atomic->world && atomic->getFrame())
+		atomic->world->updateAtomic(atomic);
+}
+
+bool32
+Morph::isMorphing(Atomic *atomic)
+{
+	return morphGlobals.atomicOffset && Morph::get(atomic)->serial != 0;
+}
+
+static void
+updateBlend(Atomic *atomic)
+{
+	MorphAtomic *m = Morph::get(atomic);
+	Geometry *geo = atomic->geometry;
+	if(m->blendedSerial == m->serial && m->numVertices == geo->numVertices)
+		return;
+	if(m->numVertices != geo->numVertices){
+		rwFree(m->vertices);
+		m->numVertices = geo->numVertices;
+		m->vertices = rwNewT(V3d, 2*m->numVertices, MEMDUR_EVENT | ID_MORPH);
+		m->normals = m->vertices + m->numVertices;
+	}
+	MorphTarget *mt1 = &geo->morphTargets[m->startTarget];
+	MorphTarget *mt2 = &geo->morphTargets[m->endTarget];
+	Morph::blend(m->vertices, mt1->vertices, mt2->vertices, geo->numVertices, m->t);
+	if(geo->flags & Geometry::NORMALS)
+		Morph::blend(m->normals, mt1->normals, mt2->normals, geo->numVertices, m->t);
+	m->blendedSerial = m->serial;
+}
+
+V3d*
+Morph::getVertices(Atomic *atomic)
+{
+	MorphAtomic *m = Morph::get(atomic);
+	Geometry *geo = atomic->geometry;
+	if(m->t == 0.0f)
+		return geo->morphTargets[m->startTarget].vertices;
+	updateBlend(atomic);
+	return m->vertices;
+}
+
+V3d*
+Morph::getNormals(Atomic *atomic)
+{
+	MorphAtomic *m = Morph::get(atomic);
+	Geometry *geo = atomic->geometry;
+	if(m->t == 0.0f || !(geo->flags & Geometry::NORMALS))
+		return geo->morphTargets[m->startTarget].normals;
+	updateBlend(atomic);
+	return m->normals;
+}
+
+//
+// Animation
+//
+
+Animation*
+Morph::createAnimation(int32 numFrames, float32 duration)
+{
+	AnimInterpolatorInfo *info = AnimInterpolatorInfo::find(INTERPID);
+	Animation *anim = Animation::create(info, numFrames, 0, duration);
+	if(anim == nil)
+		return nil;
+	MorphKeyFrame *frames = (MorphKeyFrame*)anim->keyframes;
+	for(int32 i = 0; i < numFrames; i++){
+		frames[i].prev = i == 0 ? nil : &frames[i-1];
+		frames[i].time = 0.0f;
+		frames[i].target = 0;
+	}
+	return anim;
+}
+
+static void
+applyInterpFrame(Atomic *atomic)
+{
+	MorphAtomic *m = Morph::get(atomic);
+	MorphInterpFrame *f = (MorphInterpFrame*)m->interp->getInterpFrame(0);
+	Morph::setInterpolation(atomic, f->startTarget, f->endTarget, f->t);
+}
+
+bool32
+Morph::setAnimation(Atomic *atomic, Animation *anim)
+{
+	MorphAtomic *m = Morph::get(atomic);
+	if(m->interp == nil){
+		m->interp = AnimInterpolator::create(1, sizeof(MorphInterpFrame));
+		if(m->interp == nil)
+			return 0;
+	}
+	if(!m->interp->setCurrentAnim(anim))
+		return 0;
+	applyInterpFrame(atomic);
+	return 1;
+}
+
+void
+Morph::addTime(Atomic *atomic, float32 t)
+{
+	MorphAtomic *m = Morph::get(atomic);
+	if(m->interp == nil || m->interp->currentAnim == nil)
+		return;
+	m->interp->addTime(t);
+	applyInterpFrame(atomic);
+}
+
+static void
+morphInterpCB(void *vout, void *vin1, void *vin2, float32 t, void*)
+{
+	MorphInterpFrame *out = (MorphInterpFrame*)vout;
+	MorphKeyFrame *in1 = (MorphKeyFrame*)vin1;
+	MorphKeyFrame *in2 = (MorphKeyFrame*)vin2;
+	float32 dt = in2->time - in1->time;
+	out->startTarget = in1->target;
+	out->endTarget = in2->target;
+	out->t = dt > 0.0f ? (t - in1->time)/dt : 0.0f;
+}
+
+static void
+morphFrameRead(Stream *stream, Animation *anim)
+{
+	MorphKeyFrame *frames = (MorphKeyFrame*)anim->keyframes;
+	for(int32 i = 0; i < anim->numFrames; i++){
+		frames[i].time = stream->readF32();
+		frames[i].target = stream->readI32();
+		int32 prev = stream->readI32();
+		frames[i].prev = prev < 0 ? nil : &frames[prev];
+	}
+}
+
+static void
+morphFrameWrite(Stream *stream, Animation *anim)
+{
+	MorphKeyFrame *frames = (MorphKeyFrame*)anim->keyframes;
+	for(int32 i = 0; i < anim->numFrames; i++){
+		stream->writeF32(frames[i].time);
+		stream->writeI32(frames[i].target);
+		stream->writeI32(frames[i].prev ? frames[i].prev - frames : -1);
+	}
+}
+
+static uint32
+morphFrameGetSize(Animation *anim)
+{
+	return anim->numFrames*(4 + 4 + 4);
+}
+
+//
+// Plugin
+//
+
+static void*
+morphOpen(void *object, int32, int32)
+{
+	AnimInterpolatorInfo *info = rwNewT(AnimInterpolatorInfo, 1, MEMDUR_GLOBAL | ID_MORPH);
+	info->id = Morph::INTERPID;
+	info->interpKeyFrameSize = sizeof(MorphInterpFrame);
+	info->animKeyFrameSize = sizeof(MorphKeyFrame);
+	info->customDataSize = 0;
+	info->applyCB = nil;
+	info->blendCB = nil;
+	info->interpCB = morphInterpCB;
+	info->addCB = nil;
+	info->mulRecipCB = nil;
+	info->streamRead = morphFrameRead;
+	info->streamWrite = morphFrameWrite;
+	info->streamGetSize = morphFrameGetSize;
+	AnimInterpolatorInfo::registerInterp(info);
+	return object;
+}
+
+static void*
+morphClose(void *object, int32, int32)
+{
+	AnimInterpolatorInfo::unregisterInterp(AnimInterpolatorInfo::find(Morph::INTERPID));
+	return object;
+}
+
+static void*
+createMorph(void *object, int32 offset, int32)
+{
+	MorphAtomic *m = PLUGINOFFSET(MorphAtomic, object, offset);
+	memset(m, 0, sizeof(*m));
+	return object;
+}
+
+static void*
+destroyMorph(void *object, int32 offset, int32)
+{
+	MorphAtomic *m = PLUGINOFFSET(MorphAtomic, object, offset);
+	if(m->interp)
+		m->interp->destroy();
+	rwFree(m->vertices);
+	memset(m, 0, sizeof(*m));
+	return object;
+}
+
+static void*
+copyMorph(void *dst, void *src, int32 offset, int32)
+{
+	MorphAtomic *dstm = PLUGINOFFSET(MorphAtomic, dst, offset);
+	MorphAtomic *srcm = PLUGINOFFSET(MorphAtomic, src, offset);
+	// the clone starts at the same blend but without animation
+	dstm->startTarget = srcm->startTarget;
+	dstm->endTarget = srcm->endTarget;
+	dstm->t = srcm->t;
+	dstm->serial = srcm->serial;
+	if(srcm->serial){
+		Atomic *atomic = (Atomic*)dst;
+		atomic->boundingSphere = ((Atomic*)src)->boundingSphere;
+		atomic->boundingBox = ((Atomic*)src)->boundingBox;
+	}
+	return dst;
+}
+
+void
+registerMorphPlugin(void)
+{
+	Engine::registerPlugin(0, ID_MORPH, morphOpen, morphClose);
+	morphGlobals.atomicOffset = Atomic::registerPlugin(sizeof(MorphAtomic), ID_MORPH,
+		createMorph, destroyMorph, copyMorph);
+}
+
+}
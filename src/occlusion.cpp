@@ -0,0 +1,290 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+
+#define PLUGIN_ID ID_WORLD
+
+/*
+ * Software occlusion culling.
+ *
+ * Occluder triangles are transformed by the camera's view matrix,
+ * clipped against the near plane and rasterized into a small
+ * depth buffer that holds 1/z, which is linear in screen space.
+ * Coverage is sampled at pixel centers, so occluders should not
+ * be larger than what they stand for, but the depth written is
+ * the farthest one inside the pixel.
+ * After drawing, the farthest depth of every tile is kept so most
+ * box tests never have to look at single pixels.
+ * A box is occluded if its nearest depth is behind the depth
+ * of every pixel it touches.
+ */
+
+namespace rw {
+
+OcclusionBuffer*
+OcclusionBuffer::create(int32 width, int32 height)
+{
+	assert(width > 0 && height > 0);
+	OcclusionBuffer *occ = rwNewT(OcclusionBuffer, 1, MEMDUR_EVENT | ID_WORLD);
+	occ->tilesX = (width + TILESIZE-1)/TILESIZE;
+	occ->tilesY = (height + TILESIZE-1)/TILESIZE;
+	occ->width = occ->tilesX*TILESIZE;
+	occ->height = occ->tilesY*TILESIZE;
+	occ->depth = rwNewT(float32, occ->width*occ->height, MEMDUR_EVENT | ID_WORLD);
+	occ->tileDepth = rwNewT(float32, occ->tilesX*occ->tilesY, MEMDUR_EVENT | ID_WORLD);
+	occ->camera = nil;
+	occ->verts = nil;
+	occ->maxVerts = 0;
+	return occ;
+}
+
+void
+OcclusionBuffer::destroy(void)
+{
+	rwFree(this->depth);
+	rwFree(this->tileDepth);
+	rwFree(this->verts);
+	rwFree(this);
+}
+
+void
+OcclusionBuffer::begin(Camera *cam)
+{
+	this->camera = nil;
+	if(cam == nil || cam->projection != Camera::PERSPECTIVE ||
+	   cam->nearPlane <= 0.0f)
+		return;
+	this->camera = cam;
+	memset(this->depth, 0, this->width*this->height*sizeof(float32));
+}
+
+struct ScreenVert
+{
+	float32 x, y, w;
+};
+
+static void
+drawTriangle(OcclusionBuffer *occ, ScreenVert *v0, ScreenVert *v1, ScreenVert *v2)
+{
+	int32 x, y;
+	float32 area = (v1->x - v0->x)*(v2->y - v0->y) - (v1->y - v0->y)*(v2->x - v0->x);
+	if(area == 0.0f)
+		return;
+	if(area < 0.0f){
+		ScreenVert *tmp = v1;
+		v1 = v2;
+		v2 = tmp;
+		area = -area;
+	}
+
+	float32 xmin = v0->x, xmax = v0->x;
+	float32 ymin = v0->y, ymax = v0->y;
+	if(v1->x < xmin) xmin = v1->x;
+	if(v1->x > xmax) xmax = v1->x;
+	if(v2->x < xmin) xmin = v2->x;
+	if(v2->x > xmax) xmax = v2->x;
+	if(v1->y < ymin) ymin = v1->y;
+	if(v1->y > ymax) ymax = v1->y;
+	if(v2->y < ymin) ymin = v2->y;
+	if(v2->y > ymax) ymax = v2->y;
+	if(xmin < 0.0f) xmin = 0.0f;
+	if(ymin < 0.0f) ymin = 0.0f;
+	if(xmax > occ->width) xmax = occ->width;
+	if(ymax > occ->height) ymax = occ->height;
+	// pixels whose centers can be inside
+	int32 x0 = (int32)ceilf(xmin - 0.5f);
+	int32 x1 = (int32)floorf(xmax - 0.5f);
+	int32 y0 = (int32)ceilf(ymin - 0.5f);
+	int32 y1 = (int32)floorf(ymax - 0.5f);
+	if(x0 > x1 || y0 > y1)
+		return;
+
+	// edge functions e = a*x + b*y + c, positive inside
+	float32 a0 = v1->y - v2->y, b0 = v2->x - v1->x;
+	float32 a1 = v2->y - v0->y, b1 = v0->x - v2->x;
+	float32 a2 = v0->y - v1->y, b2 = v1->x - v0->x;
+	float32 c0 = -(a0*v1->x + b0*v1->y);
+	float32 c1 = -(a1*v2->x + b1*v2->y);
+	float32 c2 = -(a2*v0->x + b2*v0->y);
+	// depth plane from the barycentric weights
+	float32 inv = 1.0f/area;
+	float32 wa = (a0*v0->w + a1*v1->w + a2*v2->w)*inv;
+	float32 wb = (b0*v0->w + b1*v1->w + b2*v2->w)*inv;
+	float32 wc = (c0*v0->w + c1*v1->w + c2*v2->w)*inv;
+	// farthest depth inside the pixel instead of at its center
+	wc -= 0.5f*(fabsf(wa) + fabsf(wb));
+
+	for(y = y0; y <= y1; y++){
+		float32 py = y + 0.5f;
+		float32 r0 = b0*py + c0;
+		float32 r1 = b1*py + c1;
+		float32 r2 = b2*py + c2;
+		float32 rw = wb*py + wc;
+		float32 *row = &occ->depth[y*occ->width];
+		for(x = x0; x <= x1; x++){
+			float32 px = x + 0.5f;
+			float32 w = wa*px + rw;
+			float32 d = row[x];
+			int32 in = (a0*px + r0 >= 0.0f) & (a1*px + r1 >= 0.0f) &
+			           (a2*px + r2 >= 0.0f) & (w > d);
+			row[x] = in ? w : d;
+		}
+	}
+}
+
+static void
+toScreen(OcclusionBuffer *occ, ScreenVert *s, V3d *v)
+{
+	s->w = 1.0f/v->z;
+	s->x = v->x*s->w*occ->width;
+	s->y = v->y*s->w*occ->height;
+}
+
+void
+OcclusionBuffer::drawAtomic(Atomic *atomic)
+{
+	int32 i, j;
+	Camera *cam = this->camera;
+	Geometry *geo = atomic->geometry;
+	if(cam == nil || geo == nil || geo->numMorphTargets == 0 ||
+	   (geo->flags & Geometry::NATIVE))
+		return;
+
+	int32 n = geo->numVertices;
+	if(n > this->maxVerts){
+		this->maxVerts = n;
+		this->verts = rwResizeT(V3d, this->verts, n, MEMDUR_EVENT | ID_WORLD);
+	}
+	// x and y in [0,z] on screen
+	Matrix m;
+	Matrix::mult(&m, atomic->getFrame()->getLTM(), &cam->viewMatrix);
+	V3d::transformPoints(this->verts, geo->morphTargets[0].vertices, n, &m);
+
+	float32 zn = cam->nearPlane;
+	for(i = 0; i < geo->numTriangles; i++){
+		V3d *tri[3];
+		int32 numIn = 0;
+		for(j = 0; j < 3; j++){
+			tri[j] = &this->verts[geo->getTriVertex(i, j)];
+			numIn += tri[j]->z >= zn;
+		}
+		if(numIn == 0)
+			continue;
+
+		ScreenVert poly[4];
+		int32 np = 0;
+		if(numIn == 3)
+			for(j = 0; j < 3; j++)
+				toScreen(this, &poly[np++], tri[j]);
+		else{
+			// clip against the near plane
+			for(j = 0; j < 3; j++){
+				V3d *a = tri[j];
+				V3d *b = tri[(j+1)%3];
+				if(a->z >= zn)
+					toScreen(this, &poly[np++], a);
+				if((a->z >= zn) != (b->z >= zn)){
+					float32 t = (zn - a->z)/(b->z - a->z);
+					V3d p = add(*a, scale(sub(*b, *a), t));
+					p.z = zn;
+					toScreen(this, &poly[np++], &p);
+				}
+			}
+		}
+		drawTriangle(this, &poly[0], &poly[1], &poly[2]);
+		if(np == 4)
+			drawTriangle(this, &poly[0], &poly[2], &poly[3]);
+	}
+}
+
+void
+OcclusionBuffer::end(void)
+{
+	int32 tx, ty, x, y;
+	if(this->camera == nil)
+		return;
+	for(ty = 0; ty < this->tilesY; ty++)
+	for(tx = 0; tx < this->tilesX; tx++){
+		float32 farthest = this->depth[ty*TILESIZE*this->width + tx*TILESIZE];
+		for(y = 0; y < TILESIZE; y++){
+			float32 *row = &this->depth[(ty*TILESIZE + y)*this->width + tx*TILESIZE];
+			for(x = 0; x < TILESIZE; x++)
+				farthest = row[x] < farthest ? row[x] : farthest;
+		}
+		this->tileDepth[ty*this->tilesX + tx] = farthest;
+	}
+}
+
+bool32
+OcclusionBuffer::isBoxOccluded(const BBox *box)
+{
+	int32 i, x, y, tx, ty;
+	Camera *cam = this->camera;
+	if(cam == nil)
+		return 0;
+
+	V3d corners[8];
+	for(i = 0; i < 8; i++){
+		corners[i].x = i & 1 ? box->sup.x : box->inf.x;
+		corners[i].y = i & 2 ? box->sup.y : box->inf.y;
+		corners[i].z = i & 4 ? box->sup.z : box->inf.z;
+	}
+	V3d::transformPoints(corners, corners, 8, &cam->viewMatrix);
+
+	// boxes reaching through the near plane are never occluded
+	float32 zmin = corners[0].z;
+	for(i = 0; i < 8; i++){
+		if(corners[i].z < cam->nearPlane)
+			return 0;
+		if(corners[i].z < zmin) zmin = corners[i].z;
+	}
+	float32 xmin, xmax, ymin, ymax;
+	xmin = xmax = corners[0].x/corners[0].z;
+	ymin = ymax = corners[0].y/corners[0].z;
+	for(i = 1; i < 8; i++){
+		float32 sx = corners[i].x/corners[i].z;
+		float32 sy = corners[i].y/corners[i].z;
+		if(sx < xmin) xmin = sx;
+		if(sx > xmax) xmax = sx;
+		if(sy < ymin) ymin = sy;
+		if(sy > ymax) ymax = sy;
+	}
+	if(xmax < 0.0f || xmin >= 1.0f || ymax < 0.0f || ymin >= 1.0f)
+		return 0;
+	// every pixel the box touches
+	int32 x0 = xmin < 0.0f ? 0 : (int32)(xmin*this->width);
+	int32 x1 = xmax >= 1.0f ? this->width-1 : (int32)(xmax*this->width);
+	int32 y0 = ymin < 0.0f ? 0 : (int32)(ymin*this->height);
+	int32 y1 = ymax >= 1.0f ? this->height-1 : (int32)(ymax*this->height);
+
+	float32 boxDepth = 1.0f/zmin;
+	for(ty = y0/TILESIZE; ty <= y1/TILESIZE; ty++)
+	for(tx = x0/TILESIZE; tx <= x1/TILESIZE; tx++){
+		if(this->tileDepth[ty*this->tilesX + tx] > boxDepth)
+			continue;
+		int32 xs = tx*TILESIZE > x0 ? tx*TILESIZE : x0;
+		int32 xe = tx*TILESIZE+TILESIZE-1 < x1 ? tx*TILESIZE+TILESIZE-1 : x1;
+		int32 ys = ty*TILESIZE > y0 ? ty*TILESIZE : y0;
+		int32 ye = ty*TILESIZE+TILESIZE-1 < y1 ? ty*TILESIZE+TILESIZE-1 : y1;
+		for(y = ys; y <= ye; y++){
+			float32 *row = &this->depth[y*this->width];
+			int32 visible = 0;
+			for(x = xs; x <= xe; x++)
+				visible |= row[x] <= boxDepth;
+			if(visible)
+				return 0;
+		}
+	}
+	return 1;
+}
+
+}
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <math.h>
+#include <atomic>
 
 #include "rwbase.h"
 #include "rwplg.h"
@@ -23,6 +25,12 @@ ObjPipeline::init(uint32 platform)
 	this->impl.instance = nothing;
 	this->impl.uninstance = nothing;
 	this->impl.render = nothing;
+	this->impl.canQueue = nil;
+	this->impl.meshVertexAlpha = nil;
+	this->impl.renderMeshes = nil;
+	this->impl.renderInstanced = nil;
+	this->impl.prepareInstance = nil;
+	this->impl.uploadInstance = nil;
 }
 
 ObjPipeline*
@@ -39,6 +47,53 @@ ObjPipeline::destroy(void)
 	rwFree(this);
 }
 
+// Instance data prepared on any thread, waiting for the render thread.
+// Pushed one at a time but only ever taken as a whole list,
+// so a compare and swap is all it needs.
+struct PreparedInstance
+{
+	ObjPipeline *pipe;
+	Geometry *geo;
+	InstanceDataHeader *header;
+	PreparedInstance *next;
+};
+static std::atomic<PreparedInstance*> preparedInstances(nil);
+
+void
+ObjPipeline::prepareInstance(Atomic *atomic)
+{
+	if(this->impl.prepareInstance == nil)
+		return;
+	InstanceDataHeader *header = this->impl.prepareInstance(this, atomic);
+	if(header == nil)
+		return;
+	// the header has everything locked so far, anything locked
+	// after this is left for instance() to pick up
+	atomic->geometry->lockedSinceInst = 0;
+	PreparedInstance *p = rwNewT(PreparedInstance, 1, MEMDUR_EVENT | ID_GEOMETRY);
+	p->pipe = this;
+	p->geo = atomic->geometry;
+	p->header = header;
+	// keep the geometry until the upload
+	p->geo->addRef();
+	p->next = preparedInstances.load(std::memory_order_relaxed);
+	while(!preparedInstances.compare_exchange_weak(p->next, p,
+		std::memory_order_release, std::memory_order_relaxed));
+}
+
+void
+ObjPipeline::uploadPrepared(void)
+{
+	PreparedInstance *p = preparedInstances.exchange(nil, std::memory_order_acquire);
+	while(p){
+		PreparedInstance *next = p->next;
+		p->pipe->impl.uploadInstance(p->pipe, p->geo, p->header);
+		p->geo->destroy();
+		rwFree(p);
+		p = next;
+	}
+}
+
 // helper functions
 
 void
@@ -65,6 +120,29 @@ findMinVertAndNumVertices(uint16 *indices, uint32 numIndices, uint32 *minVert, i
 		*numVertices = num;
 }
 
+void
+findMinVertAndNumVertices(uint32 *indices, uint32 numIndices, uint32 *minVert, int32 *numVertices)
+{
+	uint32 min = 0xFFFFFFFF;
+	uint32 max = 0;
+	while(numIndices--){
+		if(*indices < min)
+			min = *indices;
+		if(*indices > max)
+			max = *indices;
+		indices++;
+	}
+	uint32 num = max - min + 1;
+	if(min > max){
+		min = 0;
+		num = 0;
+	}
+	if(minVert)
+		*minVert = min;
+	if(numVertices)
+		*numVertices = num;
+}
+
 void
 instV4d(int type, uint8 *dst, V4d *src, uint32 numVertices, uint32 stride)
 {
@@ -78,6 +156,231 @@ instV4d(int type, uint8 *dst, V4d *src, uint32 numVertices, uint32 stride)
 		assert(0 && "unsupported instV4d type");
 }
 
+int32
+vertFormatSize(int type)
+{
+	switch(type){
+	case VERT_BYTE2: return 2;
+	case VERT_BYTE3: return 3;
+	case VERT_SHORT2: return 4;
+	case VERT_SHORT3: return 6;
+	case VERT_NORMSHORT2: return 4;
+	case VERT_NORMSHORT3: return 6;
+	case VERT_FLOAT2: return 8;
+	case VERT_FLOAT3: return 12;
+	case VERT_FLOAT4: return 16;
+	case VERT_ARGB:
+	case VERT_RGBA:
+	case VERT_BARG:
+	case VERT_COMPNORM: return 4;
+	case VERT_HALF2: return 4;
+	case VERT_HALF3: return 6;
+	case VERT_OCTNORM: return 4;
+	}
+	return 0;
+}
+
+// IEEE half float, rounded to nearest even
+static uint16
+floatToHalf(float32 f)
+{
+	uint32 u;
+	memcpy(&u, &f, 4);
+	uint32 sign = (u >> 16) & 0x8000;
+	int32 exp = ((u >> 23) & 0xFF) - 127 + 15;
+	uint32 mant = u & 0x7FFFFF;
+	if(((u >> 23) & 0xFF) == 0xFF)	// inf and nan
+		return sign | 0x7C00 | (mant ? 0x200 : 0);
+	if(exp >= 31)
+		return sign | 0x7C00;
+	if(exp <= 0){
+		// denormal or zero
+		if(exp < -10)
+			return sign;
+		mant |= 0x800000;
+		uint32 shift = 14 - exp;
+		uint32 h = mant >> shift;
+		uint32 rest = mant & ((1u<<shift)-1);
+		uint32 halfway = 1u<<(shift-1);
+		if(rest > halfway || (rest == halfway && (h & 1)))
+			h++;
+		return sign | h;
+	}
+	uint32 h = exp<<10 | mant>>13;
+	uint32 rest = mant & 0x1FFF;
+	// may carry into the exponent, which is correct
+	if(rest > 0x1000 || (rest == 0x1000 && (h & 1)))
+		h++;
+	return sign | h;
+}
+
+static float32
+halfToFloat(uint16 h)
+{
+	uint32 sign = (h & 0x8000) << 16;
+	uint32 exp = (h >> 10) & 0x1F;
+	uint32 mant = h & 0x3FF;
+	uint32 u;
+	if(exp == 0){
+		if(mant == 0)
+			u = sign;
+		else{
+			// normalize denormal
+			exp = 127 - 15 + 1;
+			while((mant & 0x400) == 0){
+				mant <<= 1;
+				exp--;
+			}
+			u = sign | exp<<23 | (mant&0x3FF)<<13;
+		}
+	}else if(exp == 31)
+		u = sign | 0x7F800000 | mant<<13;
+	else
+		u = sign | (exp + 127 - 15)<<23 | mant<<13;
+	float32 f;
+	memcpy(&f, &u, 4);
+	return f;
+}
+
+static int16
+toShort(float32 f)
+{
+	f = f < 0.0f ? f - 0.5f : f + 0.5f;
+	if(f >= 32767.0f) return 32767;
+	if(f <= -32768.0f) return -32768;
+	return (int16)f;
+}
+
+// [-1, 1] to normalized signed integer
+static int16
+toNormShort(float32 f)
+{
+	return toShort(f*32767.0f);
+}
+
+static int8
+toNormByte(float32 f)
+{
+	f *= 127.0f;
+	f = f < 0.0f ? f - 0.5f : f + 0.5f;
+	if(f >= 127.0f) return 127;
+	if(f <= -127.0f) return -127;
+	return (int8)f;
+}
+
+static float32
+fromNormShort(int16 i)
+{
+	float32 f = i/32767.0f;
+	return f < -1.0f ? -1.0f : f;
+}
+
+static float32
+fromNormByte(int8 i)
+{
+	float32 f = i/127.0f;
+	return f < -1.0f ? -1.0f : f;
+}
+
+static float32
+signNotZero(float32 f)
+{
+	return f < 0.0f ? -1.0f : 1.0f;
+}
+
+static void
+encodeOct(int16 *dst, const V3d *n)
+{
+	float32 l1 = fabsf(n->x) + fabsf(n->y) + fabsf(n->z);
+	if(l1 == 0.0f){
+		dst[0] = dst[1] = 0;
+		return;
+	}
+	float32 x = n->x/l1;
+	float32 y = n->y/l1;
+	if(n->z < 0.0f){
+		float32 ox = x;
+		x = (1.0f - fabsf(y))*signNotZero(ox);
+		y = (1.0f - fabsf(ox))*signNotZero(y);
+	}
+	dst[0] = toNormShort(x);
+	dst[1] = toNormShort(y);
+}
+
+static void
+decodeOct(V3d *n, const int16 *src)
+{
+	float32 x = fromNormShort(src[0]);
+	float32 y = fromNormShort(src[1]);
+	float32 z = 1.0f - fabsf(x) - fabsf(y);
+	if(z < 0.0f){
+		float32 ox = x;
+		x = (1.0f - fabsf(y))*signNotZero(ox);
+		y = (1.0f - fabsf(ox))*signNotZero(y);
+	}
+	*n = normalize(makeV3d(x, y, z));
+}
+
+static void
+instElement(int type, uint8 *dst, const float32 *f, int32 n)
+{
+	int32 i;
+	switch(type){
+	case VERT_BYTE2:
+	case VERT_BYTE3:
+		for(i = 0; i < n; i++)
+			((int8*)dst)[i] = toNormByte(f[i]);
+		break;
+	case VERT_SHORT2:
+	case VERT_SHORT3:
+		for(i = 0; i < n; i++)
+			((int16*)dst)[i] = toShort(f[i]);
+		break;
+	case VERT_NORMSHORT2:
+	case VERT_NORMSHORT3:
+		for(i = 0; i < n; i++)
+			((int16*)dst)[i] = toNormShort(f[i]);
+		break;
+	case VERT_HALF2:
+	case VERT_HALF3:
+		for(i = 0; i < n; i++)
+			((uint16*)dst)[i] = floatToHalf(f[i]);
+		break;
+	default:
+		assert(0 && "unsupported vertex type");
+	}
+}
+
+static void
+uninstElement(int type, float32 *f, const uint8 *src, int32 n)
+{
+	int32 i;
+	switch(type){
+	case VERT_BYTE2:
+	case VERT_BYTE3:
+		for(i = 0; i < n; i++)
+			f[i] = fromNormByte(((int8*)src)[i]);
+		break;
+	case VERT_SHORT2:
+	case VERT_SHORT3:
+		for(i = 0; i < n; i++)
+			f[i] = ((int16*)src)[i];
+		break;
+	case VERT_NORMSHORT2:
+	case VERT_NORMSHORT3:
+		for(i = 0; i < n; i++)
+			f[i] = fromNormShort(((int16*)src)[i]);
+		break;
+	case VERT_HALF2:
+	case VERT_HALF3:
+		for(i = 0; i < n; i++)
+			f[i] = halfToFloat(((uint16*)src)[i]);
+		break;
+	default:
+		assert(0 && "unsupported vertex type");
+	}
+}
+
 void
 instV3d(int type, uint8 *dst, V3d *src, uint32 numVertices, uint32 stride)
 {
@@ -92,9 +395,9 @@ instV3d(int type, uint8 *dst, V3d *src, uint32 numVertices, uint32 stride)
 				src++;
 			}
 		}
-		else if(type == VERT_COMPNORM)
+		else
 		{
-			assert(0 && "unsupported VERT_COMPNORM type");
+			assert(0 && "unsupported instV3d type without data");
 		}
 	} 
 	else 
@@ -113,6 +416,21 @@ instV3d(int type, uint8 *dst, V3d *src, uint32 numVertices, uint32 stride)
 				dst += stride;
 				src++;
 			}
+		else if(type == VERT_OCTNORM)
+			for(uint32 i = 0; i < numVertices; i++) {
+				int16 oct[2];
+				encodeOct(oct, src);
+				memcpy(dst, oct, 4);
+				dst += stride;
+				src++;
+			}
+		else if(type == VERT_BYTE3 || type == VERT_SHORT3 ||
+		        type == VERT_NORMSHORT3 || type == VERT_HALF3)
+			for(uint32 i = 0; i < numVertices; i++) {
+				instElement(type, dst, &src->x, 3);
+				dst += stride;
+				src++;
+			}
 		else
 			assert(0 && "unsupported instV3d type");
 	}
@@ -144,6 +462,21 @@ uninstV3d(int type, V3d *dst, uint8 *src, uint32 numVertices, uint32 stride)
 			src += stride;
 			dst++;
 		}
+	else if(type == VERT_OCTNORM)
+		for(uint32 i = 0; i < numVertices; i++){
+			int16 oct[2];
+			memcpy(oct, src, 4);
+			decodeOct(dst, oct);
+			src += stride;
+			dst++;
+		}
+	else if(type == VERT_BYTE3 || type == VERT_SHORT3 ||
+	        type == VERT_NORMSHORT3 || type == VERT_HALF3)
+		for(uint32 i = 0; i < numVertices; i++){
+			uninstElement(type, &dst->x, src, 3);
+			src += stride;
+			dst++;
+		}
 	else
 		assert(0 && "unsupported uninstV3d type");
 }
@@ -151,7 +484,16 @@ uninstV3d(int type, V3d *dst, uint8 *src, uint32 numVertices, uint32 stride)
 void
 instTexCoords(int type, uint8 *dst, TexCoords *src, uint32 numVertices, uint32 stride)
 {
-	assert(type == VERT_FLOAT2);
+	if(type != VERT_FLOAT2){
+		TexCoords zero = { 0.0f, 1.0f };
+		for(uint32 i = 0; i < numVertices; i++){
+			instElement(type, dst, src ? &src->u : &zero.u, 2);
+			dst += stride;
+			if(src)
+				src++;
+		}
+		return;
+	}
 	for(uint32 i = 0; i < numVertices; i++){
 		if (src != nullptr) 
 		{
@@ -171,7 +513,14 @@ instTexCoords(int type, uint8 *dst, TexCoords *src, uint32 numVertices, uint32 s
 void
 uninstTexCoords(int type, TexCoords *dst, uint8 *src, uint32 numVertices, uint32 stride)
 {
-	assert(type == VERT_FLOAT2);
+	if(type != VERT_FLOAT2){
+		for(uint32 i = 0; i < numVertices; i++){
+			uninstElement(type, &dst->u, src, 2);
+			src += stride;
+			dst++;
+		}
+		return;
+	}
 	for(uint32 i = 0; i < numVertices; i++){
 		memcpy(dst, src, 8);
 		src += stride;
@@ -37,26 +37,25 @@ BBox::addPoint(V3d *point)
 		this->sup.z = point->z;
 }
 
+// Written without branches so it compiles to SIMD min/max
 void
 BBox::calculate(V3d *points, int32 n)
 {
-	this->inf = points[0];
-	this->sup = points[0];
-	while(--n){
-		points++;
-		if(points->x < this->inf.x)
-			this->inf.x = points->x;
-		if(points->y < this->inf.y)
-			this->inf.y = points->y;
-		if(points->z < this->inf.z)
-			this->inf.z = points->z;
-		if(points->x > this->sup.x)
-			this->sup.x = points->x;
-		if(points->y > this->sup.y)
-			this->sup.y = points->y;
-		if(points->z > this->sup.z)
-			this->sup.z = points->z;
+	float32 minx = points[0].x, miny = points[0].y, minz = points[0].z;
+	float32 maxx = minx, maxy = miny, maxz = minz;
+	for(int32 i = 1; i < n; i++){
+		float32 x = points[i].x;
+		float32 y = points[i].y;
+		float32 z = points[i].z;
+		minx = x < minx ? x : minx;
+		miny = y < miny ? y : miny;
+		minz = z < minz ? z : minz;
+		maxx = x > maxx ? x : maxx;
+		maxy = y > maxy ? y : maxy;
+		maxz = z > maxz ? z : maxz;
 	}
+	this->inf.set(minx, miny, minz);
+	this->sup.set(maxx, maxy, maxz);
 }
 
 bool
@@ -898,6 +898,9 @@ objUninstance(rw::ObjPipeline *rwpipe, Atomic *atomic)
 		if(m == nil) m = defaultMatPipe;
 		if(m->preUninstCB) m->preUninstCB(m, geo);
 	}
+	VertexHash hash;
+	hash.init(geo->numVertices);
+	uninstanceHash = &hash;
 	geo->numVertices = 0;
 	for(uint32 i = 0; i < header->numMeshes; i++){
 		Mesh *mesh = &geo->meshHeader->getMeshes()[i];
@@ -915,6 +918,8 @@ objUninstance(rw::ObjPipeline *rwpipe, Atomic *atomic)
 		m->uninstanceCB(m, geo, flags, mesh, data);
 		rwFree(raw);
 	}
+	uninstanceHash = nil;
+	hash.deinit();
 	for(uint32 i = 0; i < header->numMeshes; i++){
 		Mesh *mesh = &geo->meshHeader->getMeshes()[i];
 		MatPipeline *m;
@@ -973,6 +978,62 @@ insertVertex(Geometry *geo, int32 i, uint32 mask, Vertex *v)
 		geo->texCoords[1][i] = v->t1;
 }
 
+VertexHash *uninstanceHash;
+
+static uint32
+hashPosition(const V3d *p)
+{
+	float32 f[3] = { p->x, p->y, p->z };
+	uint32 u[3];
+	// -0 and 0 compare equal, so they have to hash equally
+	for(int32 i = 0; i < 3; i++)
+		if(f[i] == 0.0f) f[i] = 0.0f;
+	memcpy(u, f, sizeof(u));
+	uint32 h = u[0]*73856093u ^ u[1]*19349663u ^ u[2]*83492791u;
+	return h ^ h>>15;
+}
+
+void
+VertexHash::init(int32 maxVerts)
+{
+	uint32 n = 16;
+	while(n < (uint32)maxVerts)
+		n <<= 1;
+	this->bucketMask = n-1;
+	this->buckets = rwNewT(int32, n + maxVerts, MEMDUR_FUNCTION | ID_GEOMETRY);
+	this->next = this->buckets + n;
+	memset(this->buckets, 0xFF, n*sizeof(int32));
+}
+
+void
+VertexHash::deinit(void)
+{
+	rwFree(this->buckets);
+	this->buckets = nil;
+	this->next = nil;
+}
+
+// Position is compared for every vertex, so looking up by it
+// gives the same result as a linear search.
+int32
+VertexHash::find(Geometry *g, uint32 flags[], uint32 mask, Vertex *v)
+{
+	int32 found = -1;
+	// chains are in descending order but we want the first match
+	for(int32 i = this->buckets[hashPosition(&v->p) & this->bucketMask]; i >= 0; i = this->next[i])
+		if(matchVertexSkin(g, i, flags ? flags[i] : ~0, mask, v))
+			found = i;
+	return found;
+}
+
+void
+VertexHash::insert(Vertex *v, int32 i)
+{
+	uint32 h = hashPosition(&v->p) & this->bucketMask;
+	this->next[i] = this->buckets[h];
+	this->buckets[h] = i;
+}
+
 void
 genericPreCB(MatPipeline *pipe, Geometry *geo)
 {
@@ -1048,9 +1109,14 @@ genericUninstanceCB(MatPipeline *pipe, Geometry *geo, uint32 flags[], Mesh *mesh
 				if(v.i[j]) v.i[j]--;
 				if(v.w[j] == 0.0f) v.i[j] = 0;
 			}
-		int32 idx = findVertexSkin(geo, flags, mask, &v);
-		if(idx < 0)
+		int32 idx = uninstanceHash ?
+			uninstanceHash->find(geo, flags, mask, &v) :
+			findVertexSkin(geo, flags, mask, &v);
+		if(idx < 0){
 			idx = geo->numVertices++;
+			if(uninstanceHash)
+				uninstanceHash->insert(&v, idx);
+		}
 		mesh->indices[i] = idx;
 		if(adc)
 			adc[i] = xyzw[3] != 0.0f;
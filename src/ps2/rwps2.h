@@ -191,6 +191,22 @@ struct Vertex {
 
 void insertVertex(Geometry *geo, int32 i, uint32 mask, Vertex *v);
 
+// Finds already uninstanced vertices by position.
+// Candidates are then compared like findVertexSkin does.
+struct VertexHash
+{
+	int32 *buckets;
+	int32 *next;	// chain of vertices with the same hash
+	uint32 bucketMask;
+
+	void init(int32 maxVerts);
+	void deinit(void);
+	int32 find(Geometry *g, uint32 flags[], uint32 mask, Vertex *v);
+	void insert(Vertex *v, int32 i);
+};
+// set up by objUninstance while uninstancing
+extern VertexHash *uninstanceHash;
+
 extern ObjPipeline *defaultObjPipe;
 extern MatPipeline *defaultMatPipe;
 
@@ -12,6 +12,7 @@ void initSkin(void);
 ObjPipeline *makeSkinPipeline(void);
 
 void insertVertexSkin(Geometry *geo, int32 i, uint32 mask, Vertex *v);
+bool32 matchVertexSkin(Geometry *g, int32 i, uint32 flag, uint32 mask, Vertex *v);
 int32 findVertexSkin(Geometry *g, uint32 flags[], uint32 mask, Vertex *v);
 
 Stream *readNativeSkin(Stream *stream, int32, void *object, int32 offset);
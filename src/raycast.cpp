@@ -0,0 +1,493 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <float.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+
+#define PLUGIN_ID ID_GEOMETRY
+
+/*
+ * Ray casts against atomic triangles.
+ *
+ * Every geometry lazily builds a BVH over the triangles of its
+ * first morph target. Leaves hold packets of four triangles in
+ * struct of arrays layout so the ray/triangle test (Moeller-Trumbore)
+ * runs over all four at once in loops the compiler can vectorize.
+ * Atomics intersect rays in object space, the world ray cast
+ * walks the world's atomic BVH front to back.
+ */
+
+namespace rw {
+
+enum { PACKETSIZE = 4, NUMBINS = 8 };
+
+struct TriPacket
+{
+	float32 v0[3][PACKETSIZE];
+	float32 e1[3][PACKETSIZE];
+	float32 e2[3][PACKETSIZE];
+	int32 tri[PACKETSIZE];	// -1 for unused slots
+};
+
+struct TriBVHNode
+{
+	BBox box;
+	int32 index;	// first child (second is index+1) or packet
+	int32 leaf;
+};
+
+struct TriangleBVH
+{
+	int32 depth;
+	int32 numNodes;
+	TriBVHNode *nodes;
+	int32 numPackets;
+	TriPacket *packets;
+};
+
+struct TriBuildData
+{
+	Geometry *geo;
+	TriangleBVH *bvh;
+	int32 *tris;
+	BBox *boxes;
+	V3d *centers;
+};
+
+static void
+makePacket(TriBuildData *bd, TriPacket *p, int32 *tris, int32 n)
+{
+	V3d *verts = bd->geo->morphTargets[0].vertices;
+	for(int32 i = 0; i < PACKETSIZE; i++){
+		V3d a, e1, e2;
+		if(i < n){
+			Geometry *geo = bd->geo;
+			a = verts[geo->getTriVertex(tris[i], 0)];
+			e1 = sub(verts[geo->getTriVertex(tris[i], 1)], a);
+			e2 = sub(verts[geo->getTriVertex(tris[i], 2)], a);
+			p->tri[i] = tris[i];
+		}else{
+			// degenerate, never hit
+			a.set(0.0f, 0.0f, 0.0f);
+			e1 = e2 = a;
+			p->tri[i] = -1;
+		}
+		p->v0[0][i] = a.x; p->v0[1][i] = a.y; p->v0[2][i] = a.z;
+		p->e1[0][i] = e1.x; p->e1[1][i] = e1.y; p->e1[2][i] = e1.z;
+		p->e2[0][i] = e2.x; p->e2[1][i] = e2.y; p->e2[2][i] = e2.z;
+	}
+}
+
+static void
+boundTris(TriBuildData *bd, int32 *tris, int32 n, BBox *box)
+{
+	*box = bd->boxes[tris[0]];
+	for(int32 i = 1; i < n; i++){
+		box->addPoint(&bd->boxes[tris[i]].inf);
+		box->addPoint(&bd->boxes[tris[i]].sup);
+	}
+}
+
+static float32
+halfArea(const BBox *b)
+{
+	V3d d = sub(b->sup, b->inf);
+	return d.x*d.y + d.y*d.z + d.z*d.x;
+}
+
+// Binned SAH split of tris, returns size of the left part
+static int32
+splitTris(TriBuildData *bd, int32 *tris, int32 n)
+{
+	int32 i;
+	BBox cb;
+	cb.initialize(&bd->centers[tris[0]]);
+	for(i = 1; i < n; i++)
+		cb.addPoint(&bd->centers[tris[i]]);
+	V3d ext = sub(cb.sup, cb.inf);
+	int32 axis = ext.x > ext.y ? (ext.x > ext.z ? 0 : 2) : (ext.y > ext.z ? 1 : 2);
+	float32 lo = (&cb.inf.x)[axis];
+	float32 width = (&ext.x)[axis];
+	if(width <= 0.0f)
+		return n/2;
+
+	BBox binBox[NUMBINS];
+	int32 binCount[NUMBINS];
+	for(i = 0; i < NUMBINS; i++)
+		binCount[i] = 0;
+	float32 k = NUMBINS*0.9999f/width;
+	for(i = 0; i < n; i++){
+		int32 bin = (int32)(((&bd->centers[tris[i]].x)[axis] - lo)*k);
+		BBox *b = &bd->boxes[tris[i]];
+		if(binCount[bin]++ == 0)
+			binBox[bin] = *b;
+		else{
+			binBox[bin].addPoint(&b->inf);
+			binBox[bin].addPoint(&b->sup);
+		}
+	}
+	float32 bestCost = FLT_MAX;
+	int32 bestSplit = -1;
+	for(int32 s = 0; s < NUMBINS-1; s++){
+		BBox l, r;
+		int32 nl = 0, nr = 0;
+		for(i = 0; i < NUMBINS; i++){
+			if(binCount[i] == 0)
+				continue;
+			BBox *dst = i <= s ? &l : &r;
+			int32 *cnt = i <= s ? &nl : &nr;
+			if(*cnt == 0)
+				*dst = binBox[i];
+			else{
+				dst->addPoint(&binBox[i].inf);
+				dst->addPoint(&binBox[i].sup);
+			}
+			*cnt += binCount[i];
+		}
+		if(nl == 0 || nr == 0)
+			continue;
+		float32 cost = nl*halfArea(&l) + nr*halfArea(&r);
+		if(cost < bestCost){
+			bestCost = cost;
+			bestSplit = s;
+		}
+	}
+	if(bestSplit < 0)
+		return n/2;
+	int32 left = 0, right = n-1;
+	while(left <= right){
+		int32 bin = (int32)(((&bd->centers[tris[left]].x)[axis] - lo)*k);
+		if(bin <= bestSplit)
+			left++;
+		else{
+			int32 tmp = tris[left];
+			tris[left] = tris[right];
+			tris[right--] = tmp;
+		}
+	}
+	return left == 0 || left == n ? n/2 : left;
+}
+
+static void
+buildNode(TriBuildData *bd, int32 node, int32 *tris, int32 n, int32 depth)
+{
+	TriangleBVH *bvh = bd->bvh;
+	TriBVHNode *nd = &bvh->nodes[node];
+	boundTris(bd, tris, n, &nd->box);
+	if(depth > bvh->depth)
+		bvh->depth = depth;
+	if(n <= PACKETSIZE){
+		nd->leaf = 1;
+		nd->index = bvh->numPackets++;
+		makePacket(bd, &bvh->packets[nd->index], tris, n);
+		return;
+	}
+	int32 mid = splitTris(bd, tris, n);
+	nd->leaf = 0;
+	nd->index = bvh->numNodes;
+	bvh->numNodes += 2;
+	buildNode(bd, nd->index, tris, mid, depth+1);
+	buildNode(bd, nd->index+1, tris+mid, n-mid, depth+1);
+}
+
+static TriangleBVH*
+buildTriangleBVH(Geometry *geo)
+{
+	int32 i;
+	int32 n = geo->numTriangles;
+	// at most one packet per triangle and 2n-1 nodes
+	TriangleBVH *bvh = (TriangleBVH*)rwNew(sizeof(TriangleBVH) +
+		2*n*sizeof(TriBVHNode) + n*sizeof(TriPacket), MEMDUR_EVENT | ID_GEOMETRY);
+	bvh->nodes = (TriBVHNode*)(bvh+1);
+	bvh->packets = (TriPacket*)(bvh->nodes + 2*n);
+	bvh->depth = 0;
+	bvh->numNodes = 1;
+	bvh->numPackets = 0;
+
+	TriBuildData bd;
+	bd.geo = geo;
+	bd.bvh = bvh;
+	bd.tris = rwNewT(int32, n, MEMDUR_FUNCTION | ID_GEOMETRY);
+	bd.boxes = rwNewT(BBox, n, MEMDUR_FUNCTION | ID_GEOMETRY);
+	bd.centers = rwNewT(V3d, n, MEMDUR_FUNCTION | ID_GEOMETRY);
+	V3d *verts = geo->morphTargets[0].vertices;
+	for(i = 0; i < n; i++){
+		V3d p[3];
+		p[0] = verts[geo->getTriVertex(i, 0)];
+		p[1] = verts[geo->getTriVertex(i, 1)];
+		p[2] = verts[geo->getTriVertex(i, 2)];
+		bd.boxes[i].calculate(p, 3);
+		bd.centers[i] = scale(add(bd.boxes[i].inf, bd.boxes[i].sup), 0.5f);
+		bd.tris[i] = i;
+	}
+	buildNode(&bd, 0, bd.tris, n, 0);
+	rwFree(bd.centers);
+	rwFree(bd.boxes);
+	rwFree(bd.tris);
+	return bvh;
+}
+
+TriangleBVH*
+Geometry::getTriangleBVH(void)
+{
+	if(this->triangleBVH == nil && this->numTriangles > 0 &&
+	   !(this->flags & NATIVE))
+		this->triangleBVH = buildTriangleBVH(this);
+	return this->triangleBVH;
+}
+
+void
+Geometry::removeTriangleBVH(void)
+{
+	rwFree(this->triangleBVH);
+	this->triangleBVH = nil;
+}
+
+//
+// Intersection
+//
+
+struct RaySetup
+{
+	V3d start;
+	V3d dir;
+	V3d invDir;
+};
+
+static void
+setupRay(RaySetup *r, V3d start, V3d dir)
+{
+	r->start = start;
+	r->dir = dir;
+	r->invDir.x = dir.x != 0.0f ? 1.0f/dir.x : FLT_MAX;
+	r->invDir.y = dir.y != 0.0f ? 1.0f/dir.y : FLT_MAX;
+	r->invDir.z = dir.z != 0.0f ? 1.0f/dir.z : FLT_MAX;
+}
+
+// Slab test, returns entry distance or -1 if missed within maxT
+static float32
+rayBox(const RaySetup *r, const BBox *b, float32 maxT)
+{
+	float32 t1 = (b->inf.x - r->start.x)*r->invDir.x;
+	float32 t2 = (b->sup.x - r->start.x)*r->invDir.x;
+	float32 tmin = t1 < t2 ? t1 : t2;
+	float32 tmax = t1 > t2 ? t1 : t2;
+	t1 = (b->inf.y - r->start.y)*r->invDir.y;
+	t2 = (b->sup.y - r->start.y)*r->invDir.y;
+	tmin = fmaxf(tmin, t1 < t2 ? t1 : t2);
+	tmax = fminf(tmax, t1 > t2 ? t1 : t2);
+	t1 = (b->inf.z - r->start.z)*r->invDir.z;
+	t2 = (b->sup.z - r->start.z)*r->invDir.z;
+	tmin = fmaxf(tmin, t1 < t2 ? t1 : t2);
+	tmax = fminf(tmax, t1 > t2 ? t1 : t2);
+	tmin = fmaxf(tmin, 0.0f);
+	return tmin <= tmax && tmin <= maxT ? tmin : -1.0f;
+}
+
+// Four triangles at once, both sides count.
+// Updates *bestT and returns the hit slot or -1.
+static int32
+rayPacket(const RaySetup *r, const TriPacket *p, float32 *bestT, float32 *bu, float32 *bv)
+{
+	float32 t[PACKETSIZE], u[PACKETSIZE], v[PACKETSIZE];
+	int32 i;
+	const float32 dx = r->dir.x, dy = r->dir.y, dz = r->dir.z;
+	for(i = 0; i < PACKETSIZE; i++){
+		float32 px = dy*p->e2[2][i] - dz*p->e2[1][i];
+		float32 py = dz*p->e2[0][i] - dx*p->e2[2][i];
+		float32 pz = dx*p->e2[1][i] - dy*p->e2[0][i];
+		float32 det = p->e1[0][i]*px + p->e1[1][i]*py + p->e1[2][i]*pz;
+		bool valid = fabsf(det) > 1.0e-20f;
+		float32 inv = valid ? 1.0f/det : 0.0f;
+		float32 tx = r->start.x - p->v0[0][i];
+		float32 ty = r->start.y - p->v0[1][i];
+		float32 tz = r->start.z - p->v0[2][i];
+		u[i] = (tx*px + ty*py + tz*pz)*inv;
+		float32 qx = ty*p->e1[2][i] - tz*p->e1[1][i];
+		float32 qy = tz*p->e1[0][i] - tx*p->e1[2][i];
+		float32 qz = tx*p->e1[1][i] - ty*p->e1[0][i];
+		v[i] = (dx*qx + dy*qy + dz*qz)*inv;
+		t[i] = (p->e2[0][i]*qx + p->e2[1][i]*qy + p->e2[2][i]*qz)*inv;
+		if(!valid)
+			t[i] = -1.0f;
+	}
+	int32 hit = -1;
+	for(i = 0; i < PACKETSIZE; i++)
+		if(t[i] >= 0.0f && t[i] <= *bestT && u[i] >= 0.0f && v[i] >= 0.0f && u[i]+v[i] <= 1.0f){
+			*bestT = t[i];
+			*bu = u[i];
+			*bv = v[i];
+			hit = i;
+		}
+	return hit;
+}
+
+// Depth first traversal never needs more than depth+1 entries,
+// only degenerate trees need the heap
+enum { STACKSIZE = 64 };
+
+struct TraversalStack
+{
+	int32 buf[STACKSIZE];
+	float32 distBuf[STACKSIZE];
+	int32 *nodes;
+	float32 *dist;
+
+	void init(int32 depth){
+		if(depth+2 <= STACKSIZE){
+			this->nodes = this->buf;
+			this->dist = this->distBuf;
+		}else{
+			this->nodes = rwNewT(int32, depth+2, MEMDUR_FUNCTION | ID_GEOMETRY);
+			this->dist = rwNewT(float32, depth+2, MEMDUR_FUNCTION | ID_GEOMETRY);
+		}
+	}
+	void deinit(void){
+		if(this->nodes != this->buf){
+			rwFree(this->nodes);
+			rwFree(this->dist);
+		}
+	}
+};
+
+// Closest hit with t in [0, *bestT], returns triangle or -1
+static int32
+intersectTriangleBVH(TriangleBVH *bvh, const RaySetup *r, float32 *bestT, float32 *u, float32 *v)
+{
+	TraversalStack st;
+	int32 *stack;
+	int32 sp = 0;
+	int32 tri = -1;
+	if(rayBox(r, &bvh->nodes[0].box, *bestT) < 0.0f)
+		return -1;
+	st.init(bvh->depth);
+	stack = st.nodes;
+	stack[sp++] = 0;
+	while(sp > 0){
+		TriBVHNode *n = &bvh->nodes[stack[--sp]];
+		if(n->leaf){
+			TriPacket *p = &bvh->packets[n->index];
+			int32 slot = rayPacket(r, p, bestT, u, v);
+			if(slot >= 0)
+				tri = p->tri[slot];
+			continue;
+		}
+		// push the far child first
+		float32 t0 = rayBox(r, &bvh->nodes[n->index].box, *bestT);
+		float32 t1 = rayBox(r, &bvh->nodes[n->index+1].box, *bestT);
+		int32 nearChild = n->index, farChild = n->index+1;
+		if(t1 >= 0.0f && (t0 < 0.0f || t1 < t0)){
+			int32 tmp = nearChild; nearChild = farChild; farChild = tmp;
+			float32 tt = t0; t0 = t1; t1 = tt;
+		}
+		if(t1 >= 0.0f)
+			stack[sp++] = farChild;
+		if(t0 >= 0.0f)
+			stack[sp++] = nearChild;
+	}
+	st.deinit();
+	return tri;
+}
+
+bool32
+Atomic::intersectRay(const Ray *ray, float32 maxDist, RayHit *hit)
+{
+	Geometry *geo = this->geometry;
+	if(geo == nil || this->getFrame() == nil)
+		return 0;
+	RaySetup r;
+	setupRay(&r, ray->start, ray->dir);
+	if(rayBox(&r, this->getWorldBoundingBox(), maxDist) < 0.0f)
+		return 0;
+	TriangleBVH *bvh = geo->getTriangleBVH();
+	if(bvh == nil)
+		return 0;
+
+	// object space segment, t in [0,1] scales to maxDist
+	Matrix inv;
+	Matrix::invert(&inv, this->getFrame()->getLTM());
+	V3d seg[2];
+	seg[0] = ray->start;
+	seg[1] = add(ray->start, scale(ray->dir, maxDist));
+	V3d::transformPoints(seg, seg, 2, &inv);
+	setupRay(&r, seg[0], sub(seg[1], seg[0]));
+	float32 t = 1.0f, u, v;
+	int32 tri = intersectTriangleBVH(bvh, &r, &t, &u, &v);
+	if(tri < 0)
+		return 0;
+	hit->atomic = this;
+	hit->triangle = tri;
+	int32 matId = geo->getTriMatId(tri);
+	hit->material = matId < geo->matList.numMaterials ? geo->matList.materials[matId] : nil;
+	hit->u = u;
+	hit->v = v;
+	hit->distance = t*maxDist;
+	hit->position = add(ray->start, scale(ray->dir, hit->distance));
+	return 1;
+}
+
+bool32
+World::rayCast(const Ray *ray, float32 maxDist, Atomic::RayFilter filter, void *data, RayHit *hit)
+{
+	DynamicBVH *tree = &this->bvh;
+	if(tree->root < 0)
+		return 0;
+	RaySetup r;
+	setupRay(&r, ray->start, ray->dir);
+	float32 best = maxDist;
+	bool32 found = 0;
+	int32 sp = 0;
+	float32 t = rayBox(&r, &tree->nodes[tree->root].box, best);
+	if(t < 0.0f)
+		return 0;
+	TraversalStack st;
+	st.init(tree->nodes[tree->root].height);
+	int32 *stack = st.nodes;
+	float32 *dist = st.dist;
+	stack[sp] = tree->root;
+	dist[sp++] = t;
+	while(sp > 0){
+		sp--;
+		// already have something closer
+		if(dist[sp] > best)
+			continue;
+		BVHNode *n = &tree->nodes[stack[sp]];
+		if(n->height == 0){
+			Atomic *a = (Atomic*)n->object;
+			if(filter && !filter(a, data))
+				continue;
+			if(a->intersectRay(ray, best, hit)){
+				best = hit->distance;
+				found = 1;
+			}
+			continue;
+		}
+		float32 t0 = rayBox(&r, &tree->nodes[n->child[0]].box, best);
+		float32 t1 = rayBox(&r, &tree->nodes[n->child[1]].box, best);
+		int32 nearChild = n->child[0], farChild = n->child[1];
+		if(t1 >= 0.0f && (t0 < 0.0f || t1 < t0)){
+			int32 tmp = nearChild; nearChild = farChild; farChild = tmp;
+			float32 tt = t0; t0 = t1; t1 = tt;
+		}
+		if(t1 >= 0.0f){
+			stack[sp] = farChild;
+			dist[sp++] = t1;
+		}
+		if(t0 >= 0.0f){
+			stack[sp] = nearChild;
+			dist[sp++] = t0;
+		}
+	}
+	st.deinit();
+	return found;
+}
+
+}
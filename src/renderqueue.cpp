@@ -0,0 +1,350 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+
+#define PLUGIN_ID ID_ATOMIC
+
+/*
+ * Sorted rendering.
+ *
+ * Key layout, most significant first:
+ *  opaque: 0 | pipeline:10 | raster:18 | material:12 | instanced:1 | geometry:12 | depth:10
+ *  alpha:  1 | inverted depth:31 | pipeline:12 | raster:20
+ * Pipelines, rasters, materials and geometries are hashed from their
+ * addresses, a collision only costs a state change or an instanced draw.
+ * Depth is the bit pattern of the positive view space distance,
+ * which sorts like the float itself.
+ * Having the geometry above depth puts atomics that can be
+ * instanced next to each other.
+ */
+
+namespace rw {
+
+enum {
+	PIPEBITS = 10, RASTERBITS = 18, MATBITS = 12, GEOBITS = 12, DEPTHBITS = 10,
+	ALPHAPIPEBITS = 12, ALPHARASTERBITS = 20
+};
+
+RenderQueue*
+RenderQueue::create(void)
+{
+	RenderQueue *queue = rwNewT(RenderQueue, 1, MEMDUR_EVENT | ID_ATOMIC);
+	queue->camera = nil;
+	queue->numItems = 0;
+	queue->maxItems = 0;
+	queue->items = nil;
+	queue->minInstances = 2;
+	queue->numStateChanges = 0;
+	queue->numUnsortedStateChanges = 0;
+	queue->numInstancedDraws = 0;
+	queue->numInstances = 0;
+	queue->instances = nil;
+	queue->maxInstances = 0;
+	queue->lightSets = nil;
+	queue->numLightSets = 0;
+	queue->maxLightSets = 0;
+	queue->draws = nil;
+	queue->maxDraws = 0;
+	return queue;
+}
+
+void
+RenderQueue::destroy(void)
+{
+	rwFree(this->items);
+	rwFree(this->instances);
+	rwFree(this->lightSets);
+	rwFree(this->draws);
+	rwFree(this);
+}
+
+void
+RenderQueue::begin(Camera *cam)
+{
+	this->camera = cam;
+	this->numItems = 0;
+	this->numLightSets = 0;
+}
+
+static uint32
+hashPointer(void *p, int32 bits)
+{
+	return (uint32)(((uintptr)p >> 4) * 2654435761u) >> (32 - bits);
+}
+
+static Material*
+itemMaterial(RenderQueue::Item *item)
+{
+	MeshHeader *mh = item->atomic->geometry->meshHeader;
+	if(mh == nil || mh->numMeshes == 0)
+		return nil;
+	return mh->getMeshes()[item->mesh < 0 ? 0 : item->mesh].material;
+}
+
+static Raster*
+itemRaster(RenderQueue::Item *item)
+{
+	Material *m = itemMaterial(item);
+	return m && m->texture ? m->texture->raster : nil;
+}
+
+static bool32
+materialHasAlpha(Material *m)
+{
+	if(m == nil)
+		return 0;
+	if(m->color.alpha != 0xFF)
+		return 1;
+	return m->texture && m->texture->raster &&
+		Raster::formatHasAlpha(m->texture->raster->format);
+}
+
+// material or instanced vertex colors
+static bool32
+meshHasAlpha(Atomic *atomic, int32 mesh)
+{
+	ObjPipeline *pipe = atomic->getPipeline();
+	Mesh *m = &atomic->geometry->meshHeader->getMeshes()[mesh];
+	return materialHasAlpha(m->material) ||
+		(pipe->impl.meshVertexAlpha && pipe->impl.meshVertexAlpha(pipe, atomic, mesh));
+}
+
+static bool32
+itemHasAlpha(RenderQueue::Item *item)
+{
+	int32 i;
+	MeshHeader *mh = item->atomic->geometry->meshHeader;
+	if(mh == nil || mh->numMeshes == 0)
+		return 0;
+	if(item->mesh >= 0)
+		return meshHasAlpha(item->atomic, item->mesh);
+	for(i = 0; i < mh->numMeshes; i++)
+		if(meshHasAlpha(item->atomic, i))
+			return 1;
+	return 0;
+}
+
+static uint64
+makeKey(RenderQueue::Item *item, uint32 depth)
+{
+	Material *m = itemMaterial(item);
+	ObjPipeline *pipe = item->atomic->getPipeline();
+	Raster *raster = itemRaster(item);
+	if(itemHasAlpha(item))
+		return 1ULL<<63 |
+			(uint64)(~depth & 0x7FFFFFFF) << (ALPHAPIPEBITS+ALPHARASTERBITS) |
+			(uint64)hashPointer(pipe, ALPHAPIPEBITS) << ALPHARASTERBITS |
+			hashPointer(raster, ALPHARASTERBITS);
+	return (uint64)hashPointer(pipe, PIPEBITS) << (RASTERBITS+MATBITS+1+GEOBITS+DEPTHBITS) |
+		(uint64)hashPointer(raster, RASTERBITS) << (MATBITS+1+GEOBITS+DEPTHBITS) |
+		(uint64)hashPointer(m, MATBITS) << (1+GEOBITS+DEPTHBITS) |
+		(uint64)(item->mesh == RenderQueue::INSTANCED) << (GEOBITS+DEPTHBITS) |
+		(uint64)hashPointer(item->atomic->geometry, GEOBITS) << DEPTHBITS |
+		depth >> (31-DEPTHBITS);
+}
+
+// Whether the pipeline may draw the atomic in pieces
+static bool32
+canQueue(Atomic *atomic)
+{
+	ObjPipeline *pipe = atomic->getPipeline();
+	return atomic->renderCB == Atomic::defaultRenderCB &&
+		(pipe->impl.canQueue == nil || pipe->impl.canQueue(pipe, atomic));
+}
+
+// Enumerates the lights of an atomic like the lighting callbacks do
+static int32
+addLightSet(RenderQueue *queue, Atomic *atomic)
+{
+	if(queue->numLightSets >= queue->maxLightSets){
+		queue->maxLightSets = queue->maxLightSets ? queue->maxLightSets*2 : 64;
+		queue->lightSets = rwResizeT(RenderQueue::LightSet, queue->lightSets,
+			queue->maxLightSets, MEMDUR_EVENT | ID_ATOMIC);
+	}
+	RenderQueue::LightSet *set = &queue->lightSets[queue->numLightSets];
+	World *world = (World*)engine->currentWorld;
+	if(world && atomic->geometry->flags & Geometry::LIGHT){
+		// pointers into the set are fixed up when it is used
+		set->lights.directionals = set->directionals;
+		set->lights.numDirectionals = RenderQueue::MAXLIGHTS;
+		set->lights.locals = set->locals;
+		set->lights.numLocals = RenderQueue::MAXLIGHTS;
+		world->enumerateLights(atomic, &set->lights);
+	}else
+		memset(&set->lights, 0, sizeof(set->lights));
+	return queue->numLightSets++;
+}
+
+static WorldLights*
+getLightSet(RenderQueue *queue, int32 i)
+{
+	RenderQueue::LightSet *set = &queue->lightSets[i];
+	set->lights.directionals = set->directionals;
+	set->lights.locals = set->locals;
+	return &set->lights;
+}
+
+// Instanced atomics have to look the same apart from their transformation
+static bool32
+canInstance(RenderQueue *queue, Atomic *atomic, WorldLights *lights)
+{
+	int32 i;
+	Geometry *geo = atomic->geometry;
+	if(queue->minInstances == 0 ||
+	   atomic->getPipeline()->impl.renderInstanced == nil ||
+	   geo->numMorphTargets != 1 ||
+	   geo->meshHeader == nil || geo->meshHeader->numMeshes == 0)
+		return 0;
+	for(i = 0; i < geo->meshHeader->numMeshes; i++)
+		if(meshHasAlpha(atomic, i))
+			return 0;
+	// only ambient and directional lights are shared by all instances
+	return lights->numLocals == 0;
+}
+
+void
+RenderQueue::addAtomic(Atomic *atomic)
+{
+	int32 i;
+	Geometry *geo = atomic->geometry;
+	if(geo == nil)
+		return;
+
+	// depth of the bounding sphere center
+	uint32 depth = 0;
+	if(this->camera){
+		Matrix *ltm = this->camera->getFrame()->getLTM();
+		float32 z = dot(sub(atomic->getWorldBoundingSphere()->center, ltm->pos), ltm->at);
+		if(z > 0.0f)
+			memcpy(&depth, &z, 4);
+	}
+
+	int32 n = 1;
+	int32 firstMesh = ATOMIC;
+	int32 lights = -1;
+	if(canQueue(atomic)){
+		lights = addLightSet(this, atomic);
+		if(canInstance(this, atomic, getLightSet(this, lights)))
+			firstMesh = INSTANCED;
+		else if(atomic->getPipeline()->impl.renderMeshes &&
+		   geo->meshHeader && geo->meshHeader->numMeshes > 0){
+			n = geo->meshHeader->numMeshes;
+			firstMesh = 0;
+		}
+	}
+	if(this->numItems + n > this->maxItems){
+		this->maxItems = (this->numItems + n)*2;
+		this->items = rwResizeT(Item, this->items, this->maxItems, MEMDUR_EVENT | ID_ATOMIC);
+	}
+	for(i = 0; i < n; i++){
+		Item *item = &this->items[this->numItems];
+		item->atomic = atomic;
+		item->mesh = firstMesh < 0 ? firstMesh : firstMesh + i;
+		item->order = this->numItems++;
+		item->lights = lights;
+		item->key = makeKey(item, depth);
+	}
+}
+
+static int
+cmpItem(const void *a, const void *b)
+{
+	const RenderQueue::Item *ia = (const RenderQueue::Item*)a;
+	const RenderQueue::Item *ib = (const RenderQueue::Item*)b;
+	if(ia->key != ib->key)
+		return ia->key < ib->key ? -1 : 1;
+	return ia->order - ib->order;
+}
+
+static int32
+countStateChanges(RenderQueue *queue)
+{
+	int32 i;
+	int32 n = 0;
+	ObjPipeline *pipe = nil;
+	Raster *raster = nil;
+	for(i = 0; i < queue->numItems; i++){
+		RenderQueue::Item *item = &queue->items[i];
+		ObjPipeline *p = item->atomic->getPipeline();
+		Raster *r = itemRaster(item);
+		n += (i == 0 || p != pipe) + (i == 0 || r != raster);
+		pipe = p;
+		raster = r;
+	}
+	return n;
+}
+
+void
+RenderQueue::end(void)
+{
+	int32 i, j, k;
+	this->numUnsortedStateChanges = countStateChanges(this);
+	qsort(this->items, this->numItems, sizeof(Item), cmpItem);
+	this->numStateChanges = countStateChanges(this);
+
+	this->numInstancedDraws = 0;
+	this->numInstances = 0;
+	for(i = 0; i < this->numItems; i = j){
+		Item *item = &this->items[i];
+		j = i+1;
+		if(item->mesh >= 0){
+			// consecutive meshes of one pipeline in one call
+			ObjPipeline *pipe = item->atomic->getPipeline();
+			while(j < this->numItems &&
+			      this->items[j].mesh >= 0 &&
+			      this->items[j].atomic->getPipeline() == pipe)
+				j++;
+			int32 n = j-i;
+			if(n > this->maxDraws){
+				this->maxDraws = n;
+				this->draws = rwResizeT(MeshDraw, this->draws, n, MEMDUR_EVENT | ID_ATOMIC);
+			}
+			for(k = 0; k < n; k++){
+				Item *it = &this->items[i+k];
+				this->draws[k].atomic = it->atomic;
+				this->draws[k].mesh = it->mesh;
+				this->draws[k].lights = getLightSet(this, it->lights);
+			}
+			pipe->renderMeshes(this->draws, n);
+			continue;
+		}
+		if(item->mesh == ATOMIC){
+			item->atomic->render();
+			continue;
+		}
+
+		ObjPipeline *pipe = item->atomic->getPipeline();
+		Geometry *geo = item->atomic->geometry;
+		while(j < this->numItems &&
+		      this->items[j].mesh == INSTANCED &&
+		      this->items[j].atomic->geometry == geo &&
+		      this->items[j].atomic->getPipeline() == pipe)
+			j++;
+		int32 n = j-i;
+		if(n < this->minInstances){
+			for(k = i; k < j; k++)
+				this->items[k].atomic->render();
+			continue;
+		}
+		if(n > this->maxInstances){
+			this->maxInstances = n;
+			this->instances = rwResizeT(Atomic*, this->instances, n, MEMDUR_EVENT | ID_ATOMIC);
+		}
+		for(k = 0; k < n; k++)
+			this->instances[k] = this->items[i+k].atomic;
+		pipe->renderInstanced(this->instances, n, getLightSet(this, item->lights));
+		this->numInstancedDraws++;
+		this->numInstances += n;
+	}
+	this->numItems = 0;
+}
+
+}
@@ -400,6 +400,12 @@ struct Line
 	V3d end;
 };
 
+struct Ray
+{
+	V3d start;
+	V3d dir;	// normalized
+};
+
 struct Rect
 {
 	int32 x, y;
@@ -573,7 +579,9 @@ enum VendorID
 	// Used for rasters (platform-specific)
 	VEND_RASTER         = 10,
 	// Used for driver/device allocation tags
-	VEND_DRIVER         = 11
+	VEND_DRIVER         = 11,
+	// librw extensions to the file format
+	VEND_LIBRW          = 12
 };
 
 // TODO: modules (VEND_CRITERIONINT)
@@ -605,8 +613,11 @@ enum PluginID
 	ID_UVANIMDICT    = MAKEPLUGINID(VEND_CORE, 0x2B),
 
 	// Toolkit
+	ID_MORPH         = MAKEPLUGINID(VEND_CRITERIONTK, 0x05),
 	ID_SKYMIPMAP     = MAKEPLUGINID(VEND_CRITERIONTK, 0x10),
+	ID_LODATOMIC     = MAKEPLUGINID(VEND_CRITERIONTK, 0x12),
 	ID_SKIN          = MAKEPLUGINID(VEND_CRITERIONTK, 0x16),
+	ID_COLLISION     = MAKEPLUGINID(VEND_CRITERIONTK, 0x1D),
 	ID_HANIM         = MAKEPLUGINID(VEND_CRITERIONTK, 0x1E),
 	ID_USERDATA      = MAKEPLUGINID(VEND_CRITERIONTK, 0x1F),
 	ID_MATFX         = MAKEPLUGINID(VEND_CRITERIONTK, 0x20),
@@ -620,6 +631,13 @@ enum PluginID
 	ID_NATIVEDATA    = MAKEPLUGINID(VEND_CRITERIONWORLD, 0x10),
 	ID_VERTEXFMT     = MAKEPLUGINID(VEND_CRITERIONWORLD, 0x11),
 
+	// librw
+	ID_TRIANGLES32   = MAKEPLUGINID(VEND_LIBRW, 0x01),
+	ID_MESHLETS      = MAKEPLUGINID(VEND_LIBRW, 0x02),
+	ID_TANGENTS      = MAKEPLUGINID(VEND_LIBRW, 0x03),
+	ID_STATICBATCH   = MAKEPLUGINID(VEND_LIBRW, 0x04),
+	ID_COLLTREE      = MAKEPLUGINID(VEND_LIBRW, 0x05),
+
 	// custom native raster
 	ID_RASTERGL      = MAKEPLUGINID(VEND_RASTER, PLATFORM_GL),
 	ID_RASTERPS2     = MAKEPLUGINID(VEND_RASTER, PLATFORM_PS2),
@@ -455,8 +455,12 @@ void registerMaterialRightsPlugin(void);
 struct Mesh
 {
 	uint16 *indices;
+	uint32 *indices32;	// used instead of indices with MeshHeader::index32
 	uint32 numIndices;
 	Material *material;
+
+	uint32 getIndex(uint32 i) { return indices32 ? indices32[i] : indices[i]; }
+	void setIndex(uint32 i, uint32 v) { if(indices32) indices32[i] = v; else indices[i] = (uint16)v; }
 };
 
 struct MeshHeader
@@ -468,7 +472,7 @@ struct MeshHeader
 	uint16 numMeshes;
 	uint16 serialNum;
 	uint32 totalIndices;
-	uint32 pad;	// needed for alignment of Meshes
+	uint32 index32;	// also needed for alignment of Meshes
 	// after this the meshes
 
 	Mesh *getMeshes(void) { return (Mesh*)(this+1); }
@@ -482,10 +486,13 @@ struct MorphTarget
 {
 	Geometry *parent;
 	Sphere boundingSphere;
+	BBox boundingBox;
 	V3d *vertices;
 	V3d *normals;
 
 	Sphere calculateBoundingSphere(void) const;
+	// from the sphere if there are no vertices
+	BBox calculateBoundingBox(void) const;
 };
 
 struct InstanceDataHeader
@@ -499,6 +506,14 @@ struct Triangle
 	uint16 matId;
 };
 
+// for Geometry::INDEX32
+struct Triangle32
+{
+	uint32 v[3];
+	uint16 matId;
+	uint16 pad;
+};
+
 struct MaterialList
 {
 	Material **materials;
@@ -514,6 +529,17 @@ struct MaterialList
 	uint32 streamGetSize(void);
 };
 
+// filled in by Geometry::buildTristrips
+struct TristripStats
+{
+	int32 numTriangles;
+	int32 numStrips;
+	int32 numLoneTriangles;	// triangles not in any strip
+	int32 numSearches;	// tunnel searches
+	int32 numTunnels;	// successful tunnel operations
+	uint32 numIndices;
+};
+
 struct Geometry
 {
 	PLUGINBASE
@@ -527,6 +553,7 @@ struct Geometry
 	int32 numTexCoordSets;
 
 	Triangle *triangles;
+	Triangle32 *triangles32;	// instead of triangles with INDEX32
 	RGBA *colors;
 	TexCoords *texCoords[8];
 
@@ -535,6 +562,8 @@ struct Geometry
 
 	MeshHeader *meshHeader;
 	InstanceDataHeader *instData;
+	struct GeometryShareEntry *shareEntry;
+	struct TriangleBVH *triangleBVH;	// for ray casts, built on demand
 
 	int32 refCount;
 
@@ -550,14 +579,41 @@ struct Geometry
 	bool32 hasColoredMaterial(void);
 	void allocateData(void);
 	MeshHeader *allocateMeshes(int32 numMeshes, uint32 numIndices, bool32 noIndices);
+	// triangle access independent of index size
+	uint32 getTriVertex(int32 i, int32 j) { return triangles32 ? triangles32[i].v[j] : triangles[i].v[j]; }
+	uint16 getTriMatId(int32 i) { return triangles32 ? triangles32[i].matId : triangles[i].matId; }
+	void setTriangle(int32 i, uint32 v0, uint32 v1, uint32 v2, uint16 matId);
+	void setTriMatId(int32 i, uint16 matId) { if(triangles32) triangles32[i].matId = matId; else triangles[i].matId = matId; }
 	void generateTriangles(int8 *adc = nil);
 	void buildMeshes(void);
-	void buildTristrips(void);	// private, used by buildMeshes
+	void buildTristrips(TristripStats *stats = nil);	// private, used by buildMeshes
+	// TRISTRIPFAST gives up tunneling after maxTunnelSearches
+	static void setTristripMode(int32 mode, int32 maxTunnelSearches = 1000);
 	void correctTristripWinding(void);
 	void removeUnusedMaterials(void);
+	void optimizeVertexCache(void);	// reorder triangles of trilist meshes
+	void optimizeVertexFetch(void);	// reorder vertices by first use
+	float32 calculateACMR(int32 cacheSize = 16);
+	// New geometry with at most targetTriangles if the error stays
+	// below maxError (relative to the bounding radius)
+	Geometry *simplify(int32 targetTriangles, float32 maxError, float32 *resultError = nil);
+	// do both optimizations in buildMeshes
+	static void setVertexCacheOptimization(bool32);	// default: false
+	// over the triangles of morph target 0, freed when locked
+	struct TriangleBVH *getTriangleBVH(void);
+	void removeTriangleBVH(void);
+	static bool32 getVertexCacheOptimization(void);
 	static Geometry *streamRead(Stream *stream);
 	bool streamWrite(Stream *stream);
 	uint32 streamGetSize(void);
+	// Like streamRead but returns a new reference to an identical
+	// geometry read before if sharing is enabled.
+	// length is that of the GEOMETRY chunk.
+	static Geometry *streamReadShared(Stream *stream, uint32 length);
+	// stop handing out this geometry, e.g. before modifying it
+	void unshare(void);
+	static void setSharing(bool32);	// default: false
+	static bool32 getSharing(void);
 
 	enum Flags
 	{
@@ -578,7 +634,17 @@ struct Geometry
 		// to prevent rendering when executing a pipeline,
 		// so only instancing will occur.
 		// librw's pipelines are different so it's unused here.
-		NATIVEINSTANCE = 0x02000000
+		NATIVEINSTANCE = 0x02000000,
+		// librw extension: triangles32 and 32 bit mesh indices
+		// are used. Set automatically for more than 65535 vertices.
+		// Not part of the streamed flags.
+		INDEX32        = 0x04000000
+	};
+
+	enum TristripMode
+	{
+		TRISTRIPSEARCH = 0,	// default, slow on big meshes
+		TRISTRIPFAST
 	};
 
 	enum LockFlags
@@ -608,17 +674,33 @@ void registerNativeDataPlugin(void);
 
 struct Clump;
 struct World;
+struct SectorTie;
+struct Atomic;
+
+// closest hit of a ray cast
+struct RayHit
+{
+	Atomic *atomic;
+	int32 triangle;
+	Material *material;
+	float32 u, v;	// barycentrics of the triangle's second and third vertex
+	float32 distance;
+	V3d position;
+};
 
 struct Atomic
 {
 	PLUGINBASE
 	typedef void (*RenderCB)(Atomic *atomic);
 	typedef void (*BeginUpdateCB)(Atomic* atomic);
+	typedef Atomic *(*Callback)(Atomic *a, void *data);
+	typedef bool32 (*RayFilter)(Atomic *a, void *data);
 	enum { ID = 1 };
 	enum {
 	// flags
 		COLLISIONTEST = 0x01,	// unused here
 		RENDER = 0x04,
+		OCCLUDER = 0x10,	// drawn into a world's occlusion buffer
 	// private flags
 		WORLDBOUNDDIRTY = 0x01,
 	// for setGeometry
@@ -629,6 +711,8 @@ struct Atomic
 	Geometry *geometry;
 	Sphere boundingSphere;
 	Sphere worldBoundingSphere;
+	BBox boundingBox;
+	BBox worldBoundingBox;
 	Clump *clump;
 	LLLink inClump;
 	ObjPipeline *pipeline;
@@ -637,6 +721,9 @@ struct Atomic
 
 	World *world;
 	ObjectWithFrame::Sync originalSync;
+	SectorTie *ties;	// sectors this atomic is linked into
+	uint32 worldSerial;	// to visit atomics only once
+	int32 bvhLeaf;
 
 	static int32 numAllocated;
 
@@ -652,6 +739,9 @@ struct Atomic
 		return LLLinkGetData(lnk, Atomic, inClump); }
 	void setGeometry(Geometry *geo, uint32 flags);
 	Sphere *getWorldBoundingSphere(void);
+	BBox *getWorldBoundingBox(void);
+	// closest triangle hit up to maxDist
+	bool32 intersectRay(const Ray *ray, float32 maxDist, RayHit *hit);
 	ObjPipeline *getPipeline(void);
 	void instance(void);
 	void uninstance(void);
@@ -692,6 +782,8 @@ struct Light
 	// world extension
 	World *world;
 	ObjectWithFrame::Sync originalSync;
+	SectorTie *ties;	// only local lights
+	uint32 worldSerial;
 
 	int32 sunLight;
 
@@ -707,6 +799,7 @@ struct Light
 		return LLLinkGetData(lnk, Light, inWorld); }
 	void setAngle(float32 angle);
 	float32 getAngle(void);
+	void setRadius(float32 radius);
 	void setColor(float32 r, float32 g, float32 b);
 	int32 getType(void){ return this->object.object.subType; }
 	void setFlags(uint32 flags) { this->object.object.flags = flags; }
@@ -748,6 +841,8 @@ struct Camera
 	enum { CLEARIMAGE = 0x1, CLEARZ = 0x2, CLEARSTENCIL = 0x4 };
 	// return value of frustumTestSphere
 	enum { SPHEREOUTSIDE, SPHEREBOUNDARY, SPHEREINSIDE };
+	// return value of frustumTestBox
+	enum { BOXOUTSIDE, BOXBOUNDARY, BOXINSIDE };
 
 	ObjectWithFrame object;
 	void (*beginUpdateCB)(Camera*);
@@ -803,6 +898,9 @@ struct Camera
 	void setViewOffset(const V2d *offset);
 	void setProjection(int32 proj);
 	int32 frustumTestSphere(const Sphere *s) const;
+	int32 frustumTestBox(const BBox *box) const;
+	// sets visible[i] to 0 for spheres outside, returns number visible
+	int32 frustumTestSpheres(const Sphere *s, int32 n, uint8 *visible) const;
 	static Camera *streamRead(Stream *stream);
 	bool streamWrite(Stream *stream);
 	uint32 streamGetSize(void);
@@ -811,6 +909,83 @@ struct Camera
 	void setFOV(float32 fov, float32 ratio);
 };
 
+// counted by Clump::render and World::render when culling against the current camera
+struct CullStats
+{
+	int32 numTested;
+	int32 numCulled;
+	int32 numSectorsTested;
+	int32 numSectorsCulled;
+	int32 numOccluders;	// drawn into the occlusion buffer
+	int32 numOccluded;
+};
+extern CullStats cullStats;
+
+// used by enumerateLights for lighting callback
+struct WorldLights
+{
+	int32 numAmbients;
+	RGBAf ambient;	// all ambients added
+	int32 numDirectionals;
+	Light **directionals;	// only directionals
+	int32 numLocals;
+	Light **locals;	// points, (soft)spots
+};
+
+// Collects atomics and renders them sorted by a 64 bit state key:
+// opaque before alpha, opaque grouped by pipeline, texture and material
+// and front to back, alpha back to front.
+// Meshes are queued separately if the pipeline has impl.renderMeshes
+// and both the atomic and the pipeline use their default render callbacks,
+// otherwise the atomic is a single item, alpha if any of its meshes is.
+// The lights of an atomic are enumerated once, when it is added.
+// Opaque atomics sharing a geometry are drawn instanced if the pipeline
+// has impl.renderInstanced, they must not be morphed or lit by local lights.
+struct RenderQueue
+{
+	enum { ATOMIC = -1, INSTANCED = -2, MAXLIGHTS = 8 };
+	struct Item
+	{
+		uint64 key;
+		Atomic *atomic;
+		int32 mesh;	// or ATOMIC, INSTANCED
+		int32 order;	// of submission, keeps the sort stable
+		int32 lights;	// index of the atomic's LightSet
+	};
+	// lights of an atomic, enumerated once per frame
+	struct LightSet
+	{
+		WorldLights lights;
+		Light *directionals[MAXLIGHTS];
+		Light *locals[MAXLIGHTS];
+	};
+	Camera *camera;
+	int32 numItems;
+	int32 maxItems;
+	Item *items;
+	int32 minInstances;	// fewer atomics are not instanced, 0 to disable; default: 2
+	// pipeline and texture changes of the last end
+	int32 numStateChanges;
+	int32 numUnsortedStateChanges;	// in submission order
+	int32 numInstancedDraws;	// renderInstanced calls
+	int32 numInstances;
+
+	// private
+	Atomic **instances;
+	int32 maxInstances;
+	LightSet *lightSets;
+	int32 numLightSets;
+	int32 maxLightSets;
+	MeshDraw *draws;
+	int32 maxDraws;
+
+	static RenderQueue *create(void);
+	void destroy(void);
+	void begin(Camera *cam);	// camera may be nil, depth is ignored then
+	void addAtomic(Atomic *atomic);
+	void end(void);	// sorts and renders
+};
+
 struct Clump
 {
 	PLUGINBASE
@@ -848,17 +1023,37 @@ struct Clump
 	uint32 streamGetSize(void);
 	void render(void);
 	void beginUpdate(void);
+
+	static void setFrustumCulling(bool32);	// default: true
+	static bool32 getFrustumCulling(void);
+	static void getCullStats(CullStats *stats);
+	static void resetCullStats(void);
 };
 
-// used by enumerateLights for lighting callback
-struct WorldLights
+// Static atomics merged in world space, one geometry per
+// pipeline and vertex layout (as far as maxVertices allows)
+// with one mesh per material.
+struct StaticBatch
 {
-	int32 numAmbients;
-	RGBAf ambient;	// all ambients added
-	int32 numDirectionals;
-	Light **directionals;	// only directionals
-	int32 numLocals;
-	Light **locals;	// points, (soft)spots
+	// where a merged triangle came from
+	struct Remap {
+		int32 source;	// index into the atomics passed to create
+		int32 triangle;
+	};
+
+	Clump *clump;
+	int32 numAtomics;
+	Atomic **atomics;
+	Remap **remaps;	// per atomic, one per triangle
+	int32 numSources;
+
+	static StaticBatch *create(Atomic **atomics, int32 numAtomics, int32 maxVertices = 0xFFFF);
+	void destroy(void);
+	void render(void) { this->clump->render(); }
+	bool32 getSource(Atomic *atomic, int32 triangle, int32 *source, int32 *sourceTriangle);
+	static StaticBatch *streamRead(Stream *stream);
+	bool streamWrite(Stream *stream);
+	uint32 streamGetSize(void);
 };
 
 struct LightData
@@ -874,20 +1069,191 @@ struct LightData
 	RGBAf color;
 };
 
-// A bit of a stub right now
+struct WorldSector
+{
+	BBox box;
+	LinkList atomics;	// SectorTies
+	LinkList lights;
+};
+
+// Links an atomic or light to one sector it overlaps
+struct SectorTie
+{
+	void *object;
+	WorldSector *sector;
+	SectorTie *next;	// next tie of the same object
+	LLLink inSector;
+
+	static SectorTie *fromSector(LLLink *lnk){
+		return LLLinkGetData(lnk, SectorTie, inSector); }
+};
+
+struct BVHNode
+{
+	BBox box;	// fattened for leaves
+	void *object;	// leaves only
+	int32 parent;	// next free node when unused
+	int32 child[2];
+	int32 height;	// 0 for leaves, -1 when unused
+};
+
+// Dynamic AABB tree, see bvh.cpp
+struct DynamicBVH
+{
+	BVHNode *nodes;
+	int32 numNodes;
+	int32 maxNodes;
+	int32 root;
+	int32 freeList;
+	int32 numLeaves;
+
+	void init(void);
+	void deinit(void);
+	int32 insert(const BBox *box, void *object);	// returns leaf
+	void remove(int32 leaf);
+	bool32 move(int32 leaf, const BBox *box);	// true if reinserted
+	void build(void);	// rebuild with SAH from the current leaves
+	float32 getCost(void);	// SAH cost relative to the root
+
+	// private
+	int32 allocNode(void);
+	void freeNode(int32 i);
+	void rotate(int32 i);
+	void refit(int32 i);
+	void insertLeaf(int32 leaf);
+	void removeLeaf(int32 leaf);
+	int32 buildRecursive(int32 *leaves, int32 n);
+};
+
+// Local lights assigned to the clusters of a camera's view frustum:
+// tiles over the view window (x left to right, y top to bottom)
+// times depth slices from the near to the far plane.
+// The slice of camera space depth z is
+// floor(log(z)*depthScale + depthBias) for perspective and
+// floor(z*depthScale + depthBias) for parallel cameras.
+// The lights of cluster c are
+// lights[lightIndices[clusterOffsets[c] .. clusterOffsets[c+1]-1]].
+struct LightGrid
+{
+	int32 dims[3];	// tiles in x and y, depth slices
+	int32 numClusters;
+	float32 depthScale, depthBias;
+	Camera *camera;	// last built for
+
+	// all local lights touching the view frustum
+	int32 numLights;
+	Light **lights;
+	uint32 *clusterOffsets;	// numClusters+1
+	int32 numIndices;
+	uint16 *lightIndices;
+
+	// private
+	int32 maxLights, maxIndices;
+	int32 *pairs;	// cluster and light while building
+	float32 *bounds;	// camera space cluster boxes, six arrays
+	V2d viewWindow, viewOffset;	// bounds are for these
+	float32 nearPlane, farPlane;
+	int32 projection;
+
+	static LightGrid *create(int32 tilesX = 16, int32 tilesY = 8, int32 numSlices = 24);
+	void destroy(void);
+	void build(World *world, Camera *cam);
+	// for lights that are not rw Lights, lights[] stays nil then.
+	// addSphere returns the light's index in the grid, -1 if it's not in view
+	void begin(Camera *cam);
+	int32 addSphere(const Sphere *s);
+	void end(void);
+	int32 getCluster(int32 x, int32 y, int32 z) { return (z*this->dims[1] + y)*this->dims[0] + x; }
+	// cluster range of a world space sphere, 0 if it's not completely in view
+	bool32 getClusterRange(const Sphere *s, int32 *lo, int32 *hi);
+};
+
+// Low resolution software depth buffer of occluder atomics
+// used to skip atomics completely hidden behind them.
+// Depth is stored as 1/z, 0 where no occluder was drawn.
+// Only perspective cameras are supported.
+struct OcclusionBuffer
+{
+	enum { TILESIZE = 8 };
+	int32 width, height;	// multiples of TILESIZE
+	int32 tilesX, tilesY;
+	float32 *depth;
+	float32 *tileDepth;	// farthest depth of every tile
+	Camera *camera;	// nil if not usable
+
+	// private
+	V3d *verts;	// transformed vertices
+	int32 maxVerts;
+
+	static OcclusionBuffer *create(int32 width = 256, int32 height = 128);
+	void destroy(void);
+	void begin(Camera *cam);
+	// geometry of the first morph target, both sides
+	void drawAtomic(Atomic *atomic);
+	void end(void);
+	// only true if the whole world space box is hidden
+	bool32 isBoxOccluded(const BBox *box);
+	bool32 isAtomicOccluded(Atomic *atomic) { return this->isBoxOccluded(atomic->getWorldBoundingBox()); }
+};
+
+// Atomics and local lights are linked into a uniform grid
+// of sectors over the bounding box given to create.
+// Anything outside the grid or covering too many sectors
+// goes into one extra sector that is always visited.
+// Atomics are also kept in a dynamic BVH for queries, worlds
+// without a bounding box use it for rendering.
+// A light grid is rebuilt whenever one of the world's cameras
+// begins an update and used to light atomics completely in view.
+// With an occlusion buffer, rendering first draws the OCCLUDER
+// atomics in the frustum into it and skips atomics hidden by them.
+// With a render queue, visible atomics are sorted before rendering.
 struct World
 {
 	PLUGINBASE
 	enum { ID = 7 };
+	enum { MAXSECTORSPERAXIS = 64, MAXTIES = 32 };
 	Object object;
 	LinkList localLights;	// these have positions (type >= 0x80)
 	LinkList globalLights;	// these do not (type < 0x80)
 	LinkList clumps;
 
+	BBox boundingBox;
+	int32 numSectors[3];
+	V3d invSectorSize;
+	WorldSector *sectors;	// x varies fastest
+	WorldSector outsideSector;
+	uint32 atomicSerial;	// to visit atomics and lights only once
+	uint32 lightSerial;
+	SectorTie *freeTies;
+	DynamicBVH bvh;
+	LightGrid *lightGrid;	// not owned
+	OcclusionBuffer *occlusion;	// not owned
+	RenderQueue *renderQueue;	// not owned
+
 	static int32 numAllocated;
 
-	static World *create(BBox *bbox = nil);	// TODO: should probably make this non-optional
+	// sectorSize 0 divides the longest side into 16 sectors
+	static World *create(BBox *bbox = nil, float32 sectorSize = 0.0f);	// TODO: should probably make this non-optional
 	void destroy(void);
+	int32 getNumSectors(void) { return this->numSectors[0]*this->numSectors[1]*this->numSectors[2]; }
+	void updateAtomic(Atomic *atomic);	// relink into sectors and BVH
+	void updateLight(Light *light);
+	void buildBVH(void);
+	void setLightGrid(LightGrid *grid) { this->lightGrid = grid; }	// default: nil
+	LightGrid *getLightGrid(void) { return this->lightGrid; }
+	void setOcclusionBuffer(OcclusionBuffer *occ) { this->occlusion = occ; }	// default: nil
+	OcclusionBuffer *getOcclusionBuffer(void) { return this->occlusion; }
+	void setRenderQueue(RenderQueue *queue) { this->renderQueue = queue; }	// default: nil
+	RenderQueue *getRenderQueue(void) { return this->renderQueue; }
+	// callbacks return nil to stop
+	void forAllAtomicsInFrustum(Camera *cam, Atomic::Callback cb, void *data);
+	void forAllAtomicsInSphere(Sphere *sphere, Atomic::Callback cb, void *data);
+	void forAllAtomicsInBox(BBox *box, Atomic::Callback cb, void *data);
+	// one traversal for up to 32 cameras, views has bit i set if cams[i] sees the atomic
+	typedef Atomic *(*ViewCallback)(Atomic *a, uint32 views, void *data);
+	void forAllAtomicsInFrustums(Camera **cams, int32 numCams, ViewCallback cb, void *data);
+	// closest hit of all atomics the filter (if any) accepts
+	bool32 rayCast(const Ray *ray, float32 maxDist, Atomic::RayFilter filter, void *data, RayHit *hit);
 	void addLight(Light *light);
 	void removeLight(Light* light);
 	void removeLights();
@@ -902,6 +1268,34 @@ struct World
 	void enumerateLights(WorldLights *lightData);
 };
 
+// Visibility of several cameras looking at the same world,
+// e.g. split screen, cube map faces or shadow cascades.
+// update syncs frames once and finds the visible atomics of all views
+// in one BVH traversal, render draws one view's list like World::render
+// and has to be called between beginUpdate and endUpdate of its camera.
+// The lists are only valid until atomics are removed from the world.
+struct MultiView
+{
+	enum { MAXVIEWS = 32 };
+	struct View
+	{
+		Camera *camera;
+		int32 numAtomics;
+		int32 maxAtomics;
+		Atomic **atomics;
+	};
+	World *world;
+	int32 numViews;
+	View views[MAXVIEWS];
+
+	static MultiView *create(World *world);
+	void destroy(void);
+	int32 addCamera(Camera *cam);	// returns the view index, -1 if full
+	void removeCameras(void);
+	void update(void);
+	void render(int32 view);
+};
+
 struct TexDictionary
 {
 	PLUGINBASE
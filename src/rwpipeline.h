@@ -1,6 +1,17 @@
 namespace rw {
 
 struct Atomic;
+struct Geometry;
+struct InstanceDataHeader;
+struct WorldLights;
+
+// one mesh of a RenderQueue
+struct MeshDraw
+{
+	Atomic *atomic;
+	int32 mesh;
+	WorldLights *lights;	// found by the queue, nil to look them up
+};
 
 class Pipeline
 {
@@ -30,15 +41,44 @@ public:
 		void (*uninstance)(ObjPipeline *pipe, Atomic *atomic);
 		void (*render)(ObjPipeline* pipe, Atomic* atomic);
 		void (*beginUpdate)(ObjPipeline* pipe, Atomic* atomic);
+		// optional, false when RenderQueue has to call render,
+		// e.g. because the render callback was replaced
+		bool32 (*canQueue)(ObjPipeline *pipe, Atomic *atomic);
+		// optional, whether the instanced vertex colors of a mesh have alpha
+		bool32 (*meshVertexAlpha)(ObjPipeline *pipe, Atomic *atomic, int32 mesh);
+		// optional, renders consecutive meshes for RenderQueue
+		void (*renderMeshes)(ObjPipeline *pipe, MeshDraw *draws, int32 n);
+		// optional, renders atomics sharing one geometry in one draw per mesh,
+		// lit by the lights of the first one (nil to look them up)
+		void (*renderInstanced)(ObjPipeline *pipe, Atomic **atomics, int32 n, WorldLights *lights);
+		// optional, the CPU work of instance without any graphics API calls,
+		// returns new instance data for uploadInstance or nil
+		InstanceDataHeader *(*prepareInstance)(ObjPipeline *pipe, Atomic *atomic);
+		// render thread, makes prepared instance data the geometry's and
+		// uploads it, or frees it if the geometry was instanced meanwhile
+		void (*uploadInstance)(ObjPipeline *pipe, Geometry *geo, InstanceDataHeader *header);
 	} impl;
 	// just for convenience
 	void instance(Atomic *atomic) { this->impl.instance(this, atomic); }
 	void uninstance(Atomic *atomic) { this->impl.uninstance(this, atomic); }
 	void render(Atomic *atomic) { this->impl.render(this, atomic); }
 	void beginUpdate(Atomic* atomic) { this->impl.beginUpdate(this, atomic); }
+	void renderMeshes(MeshDraw *draws, int32 n) { this->impl.renderMeshes(this, draws, n); }
+	void renderInstanced(Atomic **atomics, int32 n, WorldLights *lights) { this->impl.renderInstanced(this, atomics, n, lights); }
+	// Instance ahead of time, e.g. while streaming, to avoid a hitch on first render.
+	// Can run on a worker thread as long as nothing else uses the geometry
+	// and the memory functions are thread safe; atomics sharing a geometry
+	// must be prepared by the same thread. The result is queued, the geometry
+	// only gets it when the render thread uploads the queue.
+	// Locks made after this are reinstanced by the next instance().
+	void prepareInstance(Atomic *atomic);
+	// Render thread, uploads everything prepared so far.
+	// Camera::beginUpdate calls it.
+	static void uploadPrepared(void);
 };
 
 void findMinVertAndNumVertices(uint16 *indices, uint32 numIndices, uint32 *minVert, int32 *numVertices);
+void findMinVertAndNumVertices(uint32 *indices, uint32 numIndices, uint32 *minVert, int32 *numVertices);
 
 // everything xbox, d3d8 and d3d9 may want to use
 enum {
@@ -54,9 +94,16 @@ enum {
 	VERT_ARGB,
 	VERT_RGBA,
 	VERT_BARG,
-	VERT_COMPNORM
+	VERT_COMPNORM,
+	// librw extensions
+	VERT_HALF2,
+	VERT_HALF3,
+	VERT_OCTNORM	// octahedral unit vector in two normalized shorts
 };
 
+// size in bytes of one element written by the inst functions
+int32 vertFormatSize(int type);
+
 void instV4d(int type, uint8 *dst, V4d *src, uint32 numVertices, uint32 stride);
 void instV3d(int type, uint8 *dst, V3d *src, uint32 numVertices, uint32 stride);
 void uninstV3d(int type, V3d *dst, uint8 *src, uint32 numVertices, uint32 stride);
@@ -249,4 +249,288 @@ Stream *writeSkinSplitData(Stream *stream, Skin *skin);
 int32 skinSplitDataSize(Skin *skin);
 void registerSkinPlugin(void);
 
+
+/*
+ * Meshlets
+ */
+
+// A run of at most MAXTRIANGLES triangles using at most
+// MAXVERTICES vertices in a triangle list mesh.
+struct Meshlet
+{
+	Sphere boundingSphere;
+	V3d coneAxis;		// average triangle normal
+	float32 coneCos;	// cos of the normal cone's half angle, <= 0 if useless
+	uint32 firstIndex;	// into the mesh's indices
+	uint16 meshIndex;
+	uint8 numVertices;
+	uint8 numTriangles;
+
+	bool32 isBackfacing(const V3d *eye);	// eye in object space
+};
+
+struct MeshletGlobals
+{
+	int32 geoOffset;
+	bool32 culling;
+	uint8 *visible;	// scratch for renderers
+	int32 maxVisible;
+};
+extern MeshletGlobals meshletGlobals;
+
+struct Meshlets
+{
+	enum {
+		MAXVERTICES = 64,
+		MAXTRIANGLES = 124
+	};
+	int32 numMeshes;
+	int32 numMeshlets;
+	Meshlet *meshlets;
+	int32 *meshStart;	// first meshlet of every mesh, numMeshes+1 entries
+	uint16 serialNum;	// of the MeshHeader the meshlets were built for
+
+	// only for triangle list meshes
+	static Meshlets *build(Geometry *geo);
+	static void remove(Geometry *geo);
+	// nil if there are none or the meshes changed since
+	static Meshlets *get(Geometry *geo);
+	// fills in one byte per meshlet, returns number of visible meshlets.
+	// Backfacing meshlets are only culled with cullBack,
+	// i.e. when the renderer culls back faces.
+	int32 cull(Atomic *atomic, Camera *cam, bool32 cullBack, uint8 *visible);
+	// space for the visible flags of n meshlets, valid until the next call
+	static uint8 *getVisibleBuffer(int32 n);
+
+	// let the renderer cull meshlets
+	static void setCulling(bool32 b) { meshletGlobals.culling = b; }	// default: false
+	static bool32 getCulling(void) { return meshletGlobals.culling; }
+};
+void registerMeshletPlugin(void);
+
+
+/*
+ * LOD Atomic
+ */
+
+struct LODAtomicGlobals
+{
+	int32 atomicOffset;
+	float32 bias;
+	float32 hysteresis;
+};
+extern LODAtomicGlobals lodAtomicGlobals;
+
+// A chain of geometries for an atomic, picked at render time
+// by the projected size of the atomic's bounding sphere.
+// The size is scaled by the global bias before it is compared,
+// and has to pass a threshold by the hysteresis fraction
+// to switch away from the LOD rendered last.
+// Only one LOD is remembered per atomic, so hysteresis only applies
+// while the atomic is rendered by the same camera it was last rendered by;
+// an atomic alternating between views picks its LOD without it.
+struct LODAtomic
+{
+	enum { MAXLODS = 10 };
+	Geometry *geometry[MAXLODS];	// LOD 0 is the atomic's own geometry
+	float32 minSize[MAXLODS];	// projected diameter relative to view height
+	int32 numLods;
+	int32 currentLod;	// last one rendered
+	Camera *camera;	// that currentLod was picked for
+	Atomic::RenderCB renderCB;	// the hooked callback
+
+	static LODAtomic *get(Atomic *atomic){
+		return PLUGINOFFSET(LODAtomic, atomic, lodAtomicGlobals.atomicOffset);
+	}
+	static void setGeometry(Atomic *atomic, int32 lod, Geometry *geo);
+	static Geometry *getGeometry(Atomic *atomic, int32 lod);
+	static void setMinSize(Atomic *atomic, int32 lod, float32 size);
+	// Simplify the atomic's geometry into numLods-1 levels,
+	// each with ratio times the triangles of the previous one.
+	// Returns the number of levels including LOD 0.
+	static int32 generate(Atomic *atomic, int32 numLods, float32 ratio, float32 maxError);
+	static float32 getProjectedSize(Atomic *atomic, Camera *cam);
+	static int32 selectLod(Atomic *atomic, Camera *cam);
+	static void hookRender(Atomic *atomic);
+	static void unhookRender(Atomic *atomic);
+
+	// > 1 for more detail
+	static void setBias(float32 bias) { lodAtomicGlobals.bias = bias; }	// default: 1.0
+	static float32 getBias(void) { return lodAtomicGlobals.bias; }
+	static void setHysteresis(float32 h) { lodAtomicGlobals.hysteresis = h; }	// default: 0.1
+	static float32 getHysteresis(void) { return lodAtomicGlobals.hysteresis; }
+	// MAXLODS counts of the LODs rendered since the last reset.
+	// Counted per render, an atomic seen by several views counts once per view.
+	static void getHistogram(int32 *counts);
+	static void resetHistogram(void);
+};
+void registerLODAtomicPlugin(void);
+
+
+/*
+ * Tangents
+ */
+
+struct TangentGlobals
+{
+	int32 geoOffset;
+};
+extern TangentGlobals tangentGlobals;
+
+// Per vertex tangent space for normal mapping
+struct Tangents
+{
+	int32 numVertices;
+	V4d *tangents;	// xyz tangent, w sign of the bitangent
+	uint16 serialNum;	// of the MeshHeader, vertex reorders keep it up to date
+
+	// from the first set of texture coordinates
+	static Tangents *generate(Geometry *geo);
+	static void remove(Geometry *geo);
+	// nil if there are none or the vertices or meshes changed since
+	static Tangents *get(Geometry *geo);
+};
+void registerTangentPlugin(void);
+
+
+/*
+ * Morph
+ */
+
+struct MorphKeyFrame
+{
+	MorphKeyFrame *prev;
+	float32        time;
+	int32          target;	// morph target index
+};
+
+struct MorphInterpFrame
+{
+	MorphKeyFrame *keyFrame1;
+	MorphKeyFrame *keyFrame2;
+	int32          startTarget;
+	int32          endTarget;
+	float32        t;
+};
+
+struct MorphGlobals
+{
+	int32 atomicOffset;
+	uint32 serial;
+};
+extern MorphGlobals morphGlobals;
+
+// Atomic plugin
+struct MorphAtomic
+{
+	AnimInterpolator *interp;
+	int32 startTarget;
+	int32 endTarget;
+	float32 t;
+	uint32 serial;	// 0 when showing morph target 0
+	// blended data, only allocated when needed
+	int32 numVertices;
+	V3d *vertices;
+	V3d *normals;
+	uint32 blendedSerial;
+};
+
+// GL3, D3D9 and Vulkan upload the blended positions and normals when
+// an atomic is instanced. Atomics sharing a geometry share that buffer,
+// Vulkan draws them all with the blend uploaded last in a frame, and its
+// ray tracing acceleration structures keep morph target 0.
+struct Morph
+{
+	enum { INTERPID = 0x105 };
+
+	static MorphAtomic *get(Atomic *atomic){
+		return PLUGINOFFSET(MorphAtomic, atomic, morphGlobals.atomicOffset);
+	}
+	// one node animation of MorphKeyFrames
+	static Animation *createAnimation(int32 numFrames, float32 duration);
+	static bool32 setAnimation(Atomic *atomic, Animation *anim);
+	static void addTime(Atomic *atomic, float32 t);
+	// blend from start to end target, also updates the atomic's bounds
+	static void setInterpolation(Atomic *atomic, int32 start, int32 end, float32 t);
+	static bool32 isMorphing(Atomic *atomic);
+	// interpolated data, may point into a morph target
+	static V3d *getVertices(Atomic *atomic);
+	static V3d *getNormals(Atomic *atomic);
+	// dst = a + (b-a)*t
+	static void blend(V3d *dst, V3d *a, V3d *b, int32 n, float32 t);
+	static void blendStrided(uint8 *dst, int32 stride, V3d *a, V3d *b, int32 n, float32 t);
+};
+void registerMorphPlugin(void);
+
+
+/*
+ * Collision
+ */
+
+struct CollisionGlobals
+{
+	int32 geoOffset;
+	bool32 buildOnLoad;
+};
+extern CollisionGlobals collisionGlobals;
+
+struct CollisionTriangle
+{
+	uint32 v[3];
+	int32 index;	// of the geometry's triangle
+	int32 matId;
+};
+
+struct CollisionNode
+{
+	BBox box;
+	int32 index;	// first child (second is index+1) or triangle
+	int32 count;	// number of triangles, 0 for inner nodes
+};
+
+struct CollisionContact
+{
+	V3d point;	// on the triangle
+	V3d normal;	// away from the triangle towards the query shape
+	float32 distance;	// penetration depth, distance along ray for rays
+	int32 triangle;
+	int32 matId;
+};
+
+// AABB tree over a copy of the first morph target's triangles
+struct CollisionTree
+{
+	int32 numVertices;
+	int32 numTriangles;
+	int32 numNodes;
+	int32 depth;
+	V3d *vertices;
+	CollisionTriangle *triangles;
+	CollisionNode *nodes;
+
+	// not updated when the geometry changes, build again then
+	static CollisionTree *build(Geometry *geo);
+	static void remove(Geometry *geo);
+	static CollisionTree *get(Geometry *geo);
+
+	// Object space. Return the number of contacts,
+	// the deepest ones are kept if there are more than maxContacts.
+	int32 collideSphere(const Sphere *s, CollisionContact *contacts, int32 maxContacts);
+	int32 collideCapsule(const V3d *a, const V3d *b, float32 radius,
+		CollisionContact *contacts, int32 maxContacts);
+	// closest hit at start + dir*distance, distance <= maxDist
+	bool32 collideRay(const Ray *ray, float32 maxDist, CollisionContact *contact);
+
+	// World space against an atomic, its frame may only scale uniformly
+	static int32 collideSphere(Atomic *atomic, const Sphere *s, CollisionContact *contacts, int32 maxContacts);
+	static int32 collideCapsule(Atomic *atomic, const V3d *a, const V3d *b, float32 radius,
+		CollisionContact *contacts, int32 maxContacts);
+	static bool32 collideRay(Atomic *atomic, const Ray *ray, float32 maxDist, CollisionContact *contact);
+
+	// build trees for all geometry read without one
+	static void setBuildOnLoad(bool32 b) { collisionGlobals.buildOnLoad = b; }	// default: false
+	static bool32 getBuildOnLoad(void) { return collisionGlobals.buildOnLoad; }
+};
+void registerCollisionPlugin(void);
+
 }
@@ -0,0 +1,638 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+#include "rwanim.h"
+#include "rwplugins.h"
+
+#define PLUGIN_ID ID_GEOMETRY
+
+/*
+ * Mesh simplification by quadric error metrics (Garland & Heckbert).
+ *
+ * Only half edge collapses are done, i.e. a vertex is merged into
+ * one of its neighbours. No new vertices are created so all vertex
+ * attributes including skin weights stay exact.
+ * Vertices on material boundaries, on UV/normal seams
+ * (split vertices at the same position) and on non-manifold
+ * edges are never removed. Vertices on open borders
+ * can only slide along the border.
+ */
+
+namespace rw {
+
+enum {
+	KIND_MANIFOLD,
+	KIND_BORDER,
+	KIND_LOCKED
+};
+
+// open borders count this much more than faces
+#define BORDERWEIGHT 10.0f
+
+struct Quadric
+{
+	float32 a00, a11, a22;
+	float32 a10, a20, a21;
+	float32 b0, b1, b2;
+	float32 c;
+	float32 w;
+};
+
+static void
+addPlane(Quadric *q, V3d n, float32 d, float32 w)
+{
+	q->a00 += w*n.x*n.x;
+	q->a11 += w*n.y*n.y;
+	q->a22 += w*n.z*n.z;
+	q->a10 += w*n.y*n.x;
+	q->a20 += w*n.z*n.x;
+	q->a21 += w*n.z*n.y;
+	q->b0 += w*n.x*d;
+	q->b1 += w*n.y*d;
+	q->b2 += w*n.z*d;
+	q->c += w*d*d;
+	q->w += w;
+}
+
+static void
+addQuadric(Quadric *dst, const Quadric *src)
+{
+	float32 *d = &dst->a00;
+	const float32 *s = &src->a00;
+	for(int32 i = 0; i < 11; i++)
+		d[i] += s[i];
+}
+
+// mean squared distance of p to the planes in a+b
+static float32
+quadricError(const Quadric *a, const Quadric *b, const V3d *p)
+{
+	Quadric q = *a;
+	addQuadric(&q, b);
+	float32 x = p->x, y = p->y, z = p->z;
+	float32 e = q.a00*x*x + q.a11*y*y + q.a22*z*z +
+		2.0f*(q.a10*x*y + q.a20*x*z + q.a21*y*z) +
+		2.0f*(q.b0*x + q.b1*y + q.b2*z) + q.c;
+	if(q.w <= 0.0f)
+		return 0.0f;
+	e /= q.w;
+	return e < 0.0f ? 0.0f : e;
+}
+
+static uint32
+hashPosition(const V3d *p)
+{
+	float32 f[3] = { p->x, p->y, p->z };
+	uint32 u[3];
+	for(int32 i = 0; i < 3; i++)
+		if(f[i] == 0.0f) f[i] = 0.0f;
+	memcpy(u, f, sizeof(u));
+	uint32 h = u[0]*73856093u ^ u[1]*19349663u ^ u[2]*83492791u;
+	return h ^ h>>15;
+}
+
+static uint64
+edgeKey(uint32 a, uint32 b)
+{
+	return a < b ? (uint64)a<<32 | b : (uint64)b<<32 | a;
+}
+
+static int
+cmpEdgeKey(const void *a, const void *b)
+{
+	uint64 x = *(const uint64*)a;
+	uint64 y = *(const uint64*)b;
+	return x < y ? -1 : x > y;
+}
+
+struct Collapse
+{
+	uint32 v0, v1;	// v0 is merged into v1
+	float32 error;
+};
+
+static int
+cmpCollapse(const void *a, const void *b)
+{
+	float32 x = ((const Collapse*)a)->error;
+	float32 y = ((const Collapse*)b)->error;
+	return x < y ? -1 : x > y;
+}
+
+struct Simplifier
+{
+	int32 numVertices;
+	int32 numTriangles;	// alive
+	uint32 *indices;	// 3 per triangle
+	V3d *positions;
+	uint8 *locked;
+	uint8 *kind;
+	Quadric *quadrics;
+	uint64 *edges;		// sorted border edges after findBorders
+	int32 numBorderEdges;
+	uint8 *numBorders;
+
+	// vertex -> triangle adjacency, rebuilt every pass
+	int32 *adjStart;
+	int32 *adjTris;
+
+	bool32 isBorderEdge(uint32 a, uint32 b);
+	void lockVertices(uint16 *matIds);
+	void findBorders(void);
+	void calculateQuadrics(void);
+	void buildAdjacency(void);
+	bool32 checkLink(uint32 a, uint32 b);
+	bool32 checkFlip(uint32 a, uint32 b);
+	void collapse(uint32 a, uint32 b, uint8 *touched);
+	void compact(void);
+};
+
+bool32
+Simplifier::isBorderEdge(uint32 a, uint32 b)
+{
+	uint64 key = edgeKey(a, b);
+	int32 lo = 0, hi = this->numBorderEdges;
+	while(lo < hi){
+		int32 mid = (lo+hi)/2;
+		if(this->edges[mid] < key)
+			lo = mid+1;
+		else
+			hi = mid;
+	}
+	return lo < this->numBorderEdges && this->edges[lo] == key;
+}
+
+// Seams and material boundaries don't change while simplifying
+void
+Simplifier::lockVertices(uint16 *matIds)
+{
+	int32 i, j;
+	int32 nv = this->numVertices;
+	uint32 *idx = this->indices;
+
+	memset(this->locked, 0, nv);
+
+	// seams: more than one vertex at a position
+	uint32 numBuckets = 16;
+	while(numBuckets < (uint32)nv)
+		numBuckets <<= 1;
+	int32 *buckets = rwNewT(int32, numBuckets + nv, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 *next = buckets + numBuckets;
+	memset(buckets, 0xFF, numBuckets*sizeof(int32));
+	for(i = 0; i < nv; i++){
+		uint32 h = hashPosition(&this->positions[i]) & (numBuckets-1);
+		for(j = buckets[h]; j >= 0; j = next[j])
+			if(equal(this->positions[i], this->positions[j])){
+				this->locked[i] = 1;
+				this->locked[j] = 1;
+			}
+		next[i] = buckets[h];
+		buckets[h] = i;
+	}
+	rwFree(buckets);
+
+	// material boundaries
+	uint16 *vertMat = rwNewT(uint16, nv, MEMDUR_FUNCTION | ID_GEOMETRY);
+	memset(vertMat, 0xFF, nv*sizeof(uint16));
+	for(i = 0; i < this->numTriangles*3; i++){
+		uint32 v = idx[i];
+		if(vertMat[v] == 0xFFFF)
+			vertMat[v] = matIds[i/3];
+		else if(vertMat[v] != matIds[i/3])
+			this->locked[v] = 1;
+	}
+	rwFree(vertMat);
+}
+
+// Find open and non-manifold edges and classify the vertices.
+void
+Simplifier::findBorders(void)
+{
+	int32 i, j;
+	int32 nv = this->numVertices;
+	int32 ni = this->numTriangles*3;
+	uint32 *idx = this->indices;
+	uint64 *edges = this->edges;
+
+	for(i = 0; i < nv; i++)
+		this->kind[i] = this->locked[i] ? KIND_LOCKED : KIND_MANIFOLD;
+
+	for(i = 0; i < ni; i += 3)
+		for(j = 0; j < 3; j++)
+			edges[i+j] = edgeKey(idx[i+j], idx[i+(j+1)%3]);
+	qsort(edges, ni, sizeof(uint64), cmpEdgeKey);
+	uint8 *numBorders = this->numBorders;
+	memset(numBorders, 0, nv);
+	this->numBorderEdges = 0;
+	for(i = 0; i < ni; i = j){
+		for(j = i+1; j < ni && edges[j] == edges[i]; j++);
+		uint32 a = edges[i]>>32;
+		uint32 b = edges[i]&0xFFFFFFFF;
+		if(j-i == 1){
+			// compacted in place, we're always behind i
+			edges[this->numBorderEdges++] = edges[i];
+			if(numBorders[a] < 255) numBorders[a]++;
+			if(numBorders[b] < 255) numBorders[b]++;
+		}else if(j-i > 2){
+			this->kind[a] = KIND_LOCKED;
+			this->kind[b] = KIND_LOCKED;
+		}
+	}
+	for(i = 0; i < nv; i++)
+		if(numBorders[i] && this->kind[i] != KIND_LOCKED)
+			// more than one border through a vertex is too complicated
+			this->kind[i] = numBorders[i] == 2 ? KIND_BORDER : KIND_LOCKED;
+}
+
+void
+Simplifier::calculateQuadrics(void)
+{
+	int32 i, j;
+	memset(this->quadrics, 0, this->numVertices*sizeof(Quadric));
+	for(i = 0; i < this->numTriangles; i++){
+		uint32 *t = &this->indices[i*3];
+		V3d *p0 = &this->positions[t[0]];
+		V3d *p1 = &this->positions[t[1]];
+		V3d *p2 = &this->positions[t[2]];
+		V3d n = cross(sub(*p1, *p0), sub(*p2, *p0));
+		float32 len = length(n);
+		if(len == 0.0f)
+			continue;
+		n = scale(n, 1.0f/len);
+		float32 area = len*0.5f;
+		Quadric q;
+		memset(&q, 0, sizeof(q));
+		addPlane(&q, n, -dot(n, *p0), area);
+		for(j = 0; j < 3; j++)
+			addQuadric(&this->quadrics[t[j]], &q);
+
+		// keep borders in place with a plane perpendicular to the face
+		for(j = 0; j < 3; j++){
+			uint32 a = t[j];
+			uint32 b = t[(j+1)%3];
+			if(!this->isBorderEdge(a, b))
+				continue;
+			V3d e = sub(this->positions[b], this->positions[a]);
+			V3d bn = cross(e, n);
+			float32 blen = length(bn);
+			if(blen == 0.0f)
+				continue;
+			bn = scale(bn, 1.0f/blen);
+			memset(&q, 0, sizeof(q));
+			addPlane(&q, bn, -dot(bn, this->positions[a]), dot(e, e)*BORDERWEIGHT);
+			addQuadric(&this->quadrics[a], &q);
+			addQuadric(&this->quadrics[b], &q);
+		}
+	}
+}
+
+void
+Simplifier::buildAdjacency(void)
+{
+	int32 i;
+	int32 nv = this->numVertices;
+	memset(this->adjStart, 0, (nv+1)*sizeof(int32));
+	for(i = 0; i < this->numTriangles*3; i++)
+		this->adjStart[this->indices[i]+1]++;
+	for(i = 0; i < nv; i++)
+		this->adjStart[i+1] += this->adjStart[i];
+	for(i = 0; i < this->numTriangles*3; i++){
+		uint32 v = this->indices[i];
+		this->adjTris[this->adjStart[v]++] = i/3;
+	}
+	for(i = nv; i > 0; i--)
+		this->adjStart[i] = this->adjStart[i-1];
+	this->adjStart[0] = 0;
+}
+
+static bool32
+hasVertex(uint32 *t, uint32 v)
+{
+	return t[0] == v || t[1] == v || t[2] == v;
+}
+
+// The vertices adjacent to both a and b have to be exactly
+// the opposite corners of the triangles on edge ab,
+// otherwise the collapse makes the mesh non-manifold.
+bool32
+Simplifier::checkLink(uint32 a, uint32 b)
+{
+	int32 i, j, k;
+	int32 numShared = 0;
+	int32 numCommon = 0;
+	uint32 common[64];
+	for(i = this->adjStart[a]; i < this->adjStart[a+1]; i++){
+		uint32 *t = &this->indices[this->adjTris[i]*3];
+		if(t[0] == t[1])
+			continue;	// dead
+		if(hasVertex(t, b)){
+			numShared++;
+			continue;
+		}
+		for(j = 0; j < 3; j++){
+			uint32 w = t[j];
+			if(w == a)
+				continue;
+			for(k = 0; k < numCommon; k++)
+				if(common[k] == w)
+					break;
+			if(k < numCommon)
+				continue;
+			for(k = this->adjStart[b]; k < this->adjStart[b+1]; k++){
+				uint32 *tb = &this->indices[this->adjTris[k]*3];
+				if(tb[0] != tb[1] && hasVertex(tb, w)){
+					if(numCommon == 64)
+						return 0;
+					common[numCommon++] = w;
+					break;
+				}
+			}
+		}
+	}
+	// the opposite corners of shared triangles are not counted above
+	// as neighbours so any common one is too many,
+	// unless it is the opposite corner of a shared triangle
+	for(k = 0; k < numCommon; k++){
+		bool32 opposite = 0;
+		for(i = this->adjStart[a]; i < this->adjStart[a+1]; i++){
+			uint32 *t = &this->indices[this->adjTris[i]*3];
+			if(t[0] != t[1] && hasVertex(t, b) && hasVertex(t, common[k]))
+				opposite = 1;
+		}
+		if(!opposite)
+			return 0;
+	}
+	return numShared > 0;
+}
+
+// Don't let any remaining triangle around a turn over
+bool32
+Simplifier::checkFlip(uint32 a, uint32 b)
+{
+	int32 i, j;
+	V3d *p = this->positions;
+	for(i = this->adjStart[a]; i < this->adjStart[a+1]; i++){
+		uint32 *t = &this->indices[this->adjTris[i]*3];
+		if(t[0] == t[1] || hasVertex(t, b))
+			continue;
+		V3d v[3];
+		for(j = 0; j < 3; j++)
+			v[j] = p[t[j]];
+		V3d n0 = cross(sub(v[1], v[0]), sub(v[2], v[0]));
+		for(j = 0; j < 3; j++)
+			if(t[j] == a)
+				v[j] = p[b];
+		V3d n1 = cross(sub(v[1], v[0]), sub(v[2], v[0]));
+		// also reject slivers that turn too far
+		if(dot(n0, n1) < 0.25f*length(n0)*length(n1) || dot(n0, n1) <= 0.0f)
+			return 0;
+	}
+	return 1;
+}
+
+void
+Simplifier::collapse(uint32 a, uint32 b, uint8 *touched)
+{
+	int32 i, j;
+	for(i = this->adjStart[a]; i < this->adjStart[a+1]; i++){
+		uint32 *t = &this->indices[this->adjTris[i]*3];
+		if(t[0] == t[1])
+			continue;
+		for(j = 0; j < 3; j++)
+			touched[t[j]] = 1;
+		if(hasVertex(t, b)){
+			// mark dead
+			t[0] = t[1] = t[2] = b;
+			continue;
+		}
+		for(j = 0; j < 3; j++)
+			if(t[j] == a)
+				t[j] = b;
+	}
+	addQuadric(&this->quadrics[b], &this->quadrics[a]);
+}
+
+void
+Simplifier::compact(void)
+{
+	int32 i, n;
+	n = 0;
+	for(i = 0; i < this->numTriangles; i++){
+		uint32 *t = &this->indices[i*3];
+		if(t[0] == t[1])
+			continue;
+		this->indices[n*3+0] = t[0];
+		this->indices[n*3+1] = t[1];
+		this->indices[n*3+2] = t[2];
+		n++;
+	}
+	this->numTriangles = n;
+}
+
+Geometry*
+Geometry::simplify(int32 targetTriangles, float32 maxError, float32 *resultError)
+{
+	int32 i, j;
+	if(this->flags & NATIVE || this->numTriangles == 0 || this->numVertices == 0)
+		return nil;
+
+	Simplifier s;
+	int32 nv = this->numVertices;
+	s.numVertices = nv;
+	s.numTriangles = 0;
+	// work in a unit sphere so errors are relative and floats are precise enough
+	Sphere sphere = this->morphTargets[0].calculateBoundingSphere();
+	if(sphere.radius <= 0.0f)
+		sphere.radius = 1.0f;
+	s.positions = rwNewT(V3d, nv, MEMDUR_FUNCTION | ID_GEOMETRY);
+	for(i = 0; i < nv; i++)
+		s.positions[i] = scale(sub(this->morphTargets[0].vertices[i], sphere.center), 1.0f/sphere.radius);
+	s.indices = rwNewT(uint32, this->numTriangles*3, MEMDUR_FUNCTION | ID_GEOMETRY);
+	uint16 *matIds = rwNewT(uint16, this->numTriangles, MEMDUR_FUNCTION | ID_GEOMETRY);
+	for(i = 0; i < this->numTriangles; i++){
+		uint32 v0 = this->getTriVertex(i, 0);
+		uint32 v1 = this->getTriVertex(i, 1);
+		uint32 v2 = this->getTriVertex(i, 2);
+		// drop degenerate triangles right away
+		if(v0 == v1 || v1 == v2 || v2 == v0)
+			continue;
+		s.indices[s.numTriangles*3+0] = v0;
+		s.indices[s.numTriangles*3+1] = v1;
+		s.indices[s.numTriangles*3+2] = v2;
+		matIds[s.numTriangles] = this->getTriMatId(i);
+		s.numTriangles++;
+	}
+	s.locked = rwNewT(uint8, nv*3, MEMDUR_FUNCTION | ID_GEOMETRY);
+	s.kind = s.locked + nv;
+	s.numBorders = s.kind + nv;
+	s.quadrics = rwNewT(Quadric, nv, MEMDUR_FUNCTION | ID_GEOMETRY);
+	s.edges = rwNewT(uint64, s.numTriangles*3, MEMDUR_FUNCTION | ID_GEOMETRY);
+	s.adjStart = rwNewT(int32, nv+1, MEMDUR_FUNCTION | ID_GEOMETRY);
+	s.adjTris = rwNewT(int32, s.numTriangles*3, MEMDUR_FUNCTION | ID_GEOMETRY);
+	// every edge in both directions at most
+	Collapse *collapses = rwNewT(Collapse, s.numTriangles*6, MEMDUR_FUNCTION | ID_GEOMETRY);
+	uint8 *touched = rwNewT(uint8, nv, MEMDUR_FUNCTION | ID_GEOMETRY);
+
+	s.lockVertices(matIds);
+	s.findBorders();
+	s.calculateQuadrics();
+
+	float32 maxError2 = maxError*maxError;
+	float32 error2 = 0.0f;
+
+	while(s.numTriangles > targetTriangles){
+		s.buildAdjacency();
+
+		int32 numCollapses = 0;
+		for(i = 0; i < s.numTriangles; i++)
+			for(j = 0; j < 3; j++){
+				uint32 a = s.indices[i*3+j];
+				uint32 b = s.indices[i*3+(j+1)%3];
+				// each edge is seen from both sides, so only
+				// consider a->b here and b->a from the other side
+				// (or here again for border edges)
+				for(int32 k = 0; k < 2; k++){
+					uint32 v0 = k ? b : a;
+					uint32 v1 = k ? a : b;
+					if(s.kind[v0] == KIND_LOCKED)
+						continue;
+					if(s.kind[v0] == KIND_BORDER &&
+					   (s.kind[v1] == KIND_MANIFOLD || !s.isBorderEdge(v0, v1)))
+						continue;
+					// interior edges are visited twice, only take one
+					if(k == 1 && !s.isBorderEdge(v0, v1))
+						continue;
+					Collapse *c = &collapses[numCollapses++];
+					c->v0 = v0;
+					c->v1 = v1;
+					c->error = quadricError(&s.quadrics[v0], &s.quadrics[v1], &s.positions[v1]);
+				}
+			}
+		if(numCollapses == 0)
+			break;
+		qsort(collapses, numCollapses, sizeof(Collapse), cmpCollapse);
+
+		memset(touched, 0, nv);
+		int32 numTris = s.numTriangles;
+		int32 numDone = 0;
+		for(i = 0; i < numCollapses && numTris > targetTriangles; i++){
+			Collapse *c = &collapses[i];
+			if(c->error > maxError2)
+				break;
+			if(touched[c->v0] || touched[c->v1])
+				continue;
+			if(!s.checkLink(c->v0, c->v1) || !s.checkFlip(c->v0, c->v1))
+				continue;
+			for(j = s.adjStart[c->v0]; j < s.adjStart[c->v0+1]; j++){
+				uint32 *t = &s.indices[s.adjTris[j]*3];
+				if(t[0] != t[1] && hasVertex(t, c->v1))
+					numTris--;
+			}
+			s.collapse(c->v0, c->v1, touched);
+			if(c->error > error2)
+				error2 = c->error;
+			numDone++;
+		}
+		if(numDone == 0)
+			break;
+
+		// compact triangles together with their materials
+		int32 n = 0;
+		for(i = 0; i < s.numTriangles; i++){
+			uint32 *t = &s.indices[i*3];
+			if(t[0] == t[1])
+				continue;
+			matIds[n] = matIds[i];
+			n++;
+		}
+		s.compact();
+		assert(s.numTriangles == n);
+		s.findBorders();
+	}
+
+	// build the new geometry from the used vertices
+	int32 *remap = s.adjStart;	// no longer needed
+	memset(remap, 0xFF, nv*sizeof(int32));
+	for(i = 0; i < s.numTriangles*3; i++)
+		remap[s.indices[i]] = 0;
+	int32 numVerts = 0;
+	for(i = 0; i < nv; i++)
+		if(remap[i] == 0)
+			remap[i] = numVerts++;
+
+	Geometry *geo = Geometry::create(numVerts, s.numTriangles,
+		(this->flags & 0xFF00FFFF) | this->numTexCoordSets<<16);
+	if(geo == nil)
+		goto out;
+	if(this->numMorphTargets > 1)
+		geo->addMorphTargets(this->numMorphTargets-1);
+	for(i = 0; i < nv; i++){
+		int32 v = remap[i];
+		if(v < 0)
+			continue;
+		if(geo->colors)
+			geo->colors[v] = this->colors[i];
+		for(j = 0; j < geo->numTexCoordSets; j++)
+			geo->texCoords[j][v] = this->texCoords[j][i];
+		for(j = 0; j < geo->numMorphTargets; j++){
+			MorphTarget *dst = &geo->morphTargets[j];
+			MorphTarget *src = &this->morphTargets[j];
+			dst->vertices[v] = src->vertices[i];
+			if(dst->normals)
+				dst->normals[v] = src->normals[i];
+		}
+	}
+	for(i = 0; i < s.numTriangles; i++)
+		geo->setTriangle(i, remap[s.indices[i*3+0]], remap[s.indices[i*3+1]],
+			remap[s.indices[i*3+2]], matIds[i]);
+	for(i = 0; i < this->matList.numMaterials; i++)
+		geo->matList.appendMaterial(this->matList.materials[i]);
+
+	if(skinGlobals.geoOffset && Skin::get(this)){
+		Skin *src = Skin::get(this);
+		Skin *skin = rwNewT(Skin, 1, MEMDUR_EVENT | ID_SKIN);
+		skin->init(src->numBones, src->numUsedBones, numVerts);
+		skin->numWeights = src->numWeights;
+		if(src->numUsedBones)
+			memcpy(skin->usedBones, src->usedBones, src->numUsedBones);
+		if(src->numBones)
+			memcpy(skin->inverseMatrices, src->inverseMatrices, src->numBones*64);
+		for(i = 0; i < nv; i++){
+			int32 v = remap[i];
+			if(v < 0)
+				continue;
+			memcpy(&skin->indices[v*4], &src->indices[i*4], 4);
+			memcpy(&skin->weights[v*4], &src->weights[i*4], 16);
+		}
+		Skin::set(geo, skin);
+	}
+
+	geo->calculateBoundingSphere();
+	geo->buildMeshes();
+	if(resultError)
+		*resultError = sqrtf(error2);
+
+out:
+	rwFree(touched);
+	rwFree(collapses);
+	rwFree(s.adjTris);
+	rwFree(s.adjStart);
+	rwFree(s.edges);
+	rwFree(s.quadrics);
+	rwFree(s.locked);
+	rwFree(matIds);
+	rwFree(s.indices);
+	rwFree(s.positions);
+	return geo;
+}
+
+}
@@ -0,0 +1,360 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+#include "rwanim.h"
+#include "rwplugins.h"
+
+#define PLUGIN_ID ID_TANGENTS
+
+/*
+ * Per vertex tangents for normal/bump mapping, computed from
+ * the first texture coordinate set like MikkTSpace does:
+ * per corner tangents and bitangents are projected into the
+ * plane of the vertex normal and weighted by the corner angle.
+ * Vertices are already split at UV seams in RW geometry so
+ * no additional splitting is done.
+ * Each mesh is an independent job writing only its own
+ * accumulation buffers, the results are summed up at the end.
+ */
+
+namespace rw {
+
+TangentGlobals tangentGlobals = { 0 };
+
+#define GETTANGENTS(geo) (*PLUGINOFFSET(Tangents*, geo, tangentGlobals.geoOffset))
+
+static Tangents*
+allocTangents(int32 numVertices)
+{
+	Tangents *t = (Tangents*)rwNew(sizeof(Tangents) + numVertices*sizeof(V4d), MEMDUR_EVENT | ID_TANGENTS);
+	t->numVertices = numVertices;
+	t->tangents = (V4d*)(t+1);
+	t->serialNum = 0;
+	return t;
+}
+
+static uint16
+meshSerial(Geometry *geo)
+{
+	return geo->meshHeader ? geo->meshHeader->serialNum : 0;
+}
+
+struct TangentJob
+{
+	Geometry *geo;
+	Mesh *mesh;	// nil to use the geometry's triangles
+	bool32 strip;
+	V3d *normals;
+	uint32 minVert;
+	int32 numVertices;
+	V3d *tan;	// accumulators relative to minVert
+	V3d *bitan;
+};
+
+static V3d
+projectNormalized(V3d v, V3d n)
+{
+	v = sub(v, scale(n, dot(n, v)));
+	float32 len = length(v);
+	return len > 0.0f ? scale(v, 1.0f/len) : v;
+}
+
+static float32
+cornerAngle(V3d p, V3d a, V3d b)
+{
+	V3d e1 = sub(a, p);
+	V3d e2 = sub(b, p);
+	float32 l = length(e1)*length(e2);
+	if(l == 0.0f)
+		return 0.0f;
+	float32 c = dot(e1, e2)/l;
+	return acosf(c < -1.0f ? -1.0f : c > 1.0f ? 1.0f : c);
+}
+
+static void
+addTriangle(TangentJob *job, uint32 *v)
+{
+	V3d *pos = job->geo->morphTargets[0].vertices;
+	TexCoords *tc = job->geo->texCoords[0];
+	V3d p[3];
+	int32 i;
+
+	for(i = 0; i < 3; i++)
+		p[i] = pos[v[i]];
+	V3d e1 = sub(p[1], p[0]);
+	V3d e2 = sub(p[2], p[0]);
+	float32 du1 = tc[v[1]].u - tc[v[0]].u;
+	float32 dv1 = tc[v[1]].v - tc[v[0]].v;
+	float32 du2 = tc[v[2]].u - tc[v[0]].u;
+	float32 dv2 = tc[v[2]].v - tc[v[0]].v;
+	float32 det = du1*dv2 - du2*dv1;
+	// no usable UV mapping on this face
+	if(fabsf(det) < 1.0e-12f)
+		return;
+	V3d t = scale(sub(scale(e1, dv2), scale(e2, dv1)), 1.0f/det);
+	V3d b = scale(sub(scale(e2, du1), scale(e1, du2)), 1.0f/det);
+
+	for(i = 0; i < 3; i++){
+		V3d n = job->normals[v[i]];
+		float32 w = cornerAngle(p[i], p[(i+1)%3], p[(i+2)%3]);
+		uint32 j = v[i] - job->minVert;
+		job->tan[j] = add(job->tan[j], scale(projectNormalized(t, n), w));
+		job->bitan[j] = add(job->bitan[j], scale(projectNormalized(b, n), w));
+	}
+}
+
+static void
+tangentJob(TangentJob *job)
+{
+	uint32 v[3];
+	uint32 i;
+	memset(job->tan, 0, job->numVertices*sizeof(V3d));
+	memset(job->bitan, 0, job->numVertices*sizeof(V3d));
+	if(job->mesh == nil){
+		Geometry *geo = job->geo;
+		for(int32 j = 0; j < geo->numTriangles; j++){
+			v[0] = geo->getTriVertex(j, 0);
+			v[1] = geo->getTriVertex(j, 1);
+			v[2] = geo->getTriVertex(j, 2);
+			addTriangle(job, v);
+		}
+	}else if(job->strip){
+		Mesh *m = job->mesh;
+		for(i = 0; i+2 < m->numIndices; i++){
+			v[0] = m->getIndex(i);
+			v[1] = m->getIndex(i + 1 + (i&1));
+			v[2] = m->getIndex(i + 2 - (i&1));
+			if(v[0] == v[1] || v[1] == v[2] || v[2] == v[0])
+				continue;
+			addTriangle(job, v);
+		}
+	}else{
+		Mesh *m = job->mesh;
+		for(i = 0; i+2 < m->numIndices; i += 3){
+			v[0] = m->getIndex(i);
+			v[1] = m->getIndex(i+1);
+			v[2] = m->getIndex(i+2);
+			addTriangle(job, v);
+		}
+	}
+}
+
+// Vertex normals from the faces if the geometry has none
+static V3d*
+calculateNormals(Geometry *geo)
+{
+	V3d *pos = geo->morphTargets[0].vertices;
+	V3d *normals = rwNewT(V3d, geo->numVertices, MEMDUR_FUNCTION | ID_TANGENTS);
+	memset(normals, 0, geo->numVertices*sizeof(V3d));
+	for(int32 i = 0; i < geo->numTriangles; i++){
+		uint32 a = geo->getTriVertex(i, 0);
+		uint32 b = geo->getTriVertex(i, 1);
+		uint32 c = geo->getTriVertex(i, 2);
+		V3d n = cross(sub(pos[b], pos[a]), sub(pos[c], pos[a]));
+		normals[a] = add(normals[a], n);
+		normals[b] = add(normals[b], n);
+		normals[c] = add(normals[c], n);
+	}
+	for(int32 i = 0; i < geo->numVertices; i++)
+		if(length(normals[i]) > 0.0f)
+			normals[i] = normalize(normals[i]);
+	return normals;
+}
+
+Tangents*
+Tangents::generate(Geometry *geo)
+{
+	int32 i, j;
+	Tangents::remove(geo);
+	if(geo->flags & Geometry::NATIVE || geo->numTexCoordSets == 0 ||
+	   geo->numVertices == 0)
+		return nil;
+
+	V3d *normals = geo->morphTargets[0].normals;
+	V3d *tmpNormals = nil;
+	if(normals == nil)
+		normals = tmpNormals = calculateNormals(geo);
+
+	// one job per mesh or just one for the triangles
+	MeshHeader *mh = geo->meshHeader;
+	bool32 useMeshes = mh && mh->numMeshes &&
+		(mh->getMeshes()[0].indices || mh->getMeshes()[0].indices32);
+	int32 numJobs = useMeshes ? mh->numMeshes : 1;
+	TangentJob *jobs = rwNewT(TangentJob, numJobs, MEMDUR_FUNCTION | ID_TANGENTS);
+	int32 totalVerts = 0;
+	for(i = 0; i < numJobs; i++){
+		TangentJob *job = &jobs[i];
+		job->geo = geo;
+		job->normals = normals;
+		if(useMeshes){
+			Mesh *m = &mh->getMeshes()[i];
+			job->mesh = m;
+			job->strip = mh->flags == MeshHeader::TRISTRIP;
+			if(m->indices32)
+				findMinVertAndNumVertices(m->indices32, m->numIndices,
+				                          &job->minVert, &job->numVertices);
+			else
+				findMinVertAndNumVertices(m->indices, m->numIndices,
+				                          &job->minVert, &job->numVertices);
+		}else{
+			job->mesh = nil;
+			job->strip = 0;
+			job->minVert = 0;
+			job->numVertices = geo->numVertices;
+		}
+		totalVerts += job->numVertices;
+	}
+	V3d *acc = rwNewT(V3d, 2*totalVerts, MEMDUR_FUNCTION | ID_TANGENTS);
+	V3d *p = acc;
+	for(i = 0; i < numJobs; i++){
+		jobs[i].tan = p;
+		jobs[i].bitan = p + jobs[i].numVertices;
+		p += 2*jobs[i].numVertices;
+	}
+
+	// each job only writes its own accumulators
+	for(i = 0; i < numJobs; i++)
+		tangentJob(&jobs[i]);
+
+	Tangents *t = allocTangents(geo->numVertices);
+	V3d *tan = rwNewT(V3d, 2*geo->numVertices, MEMDUR_FUNCTION | ID_TANGENTS);
+	V3d *bitan = tan + geo->numVertices;
+	memset(tan, 0, 2*geo->numVertices*sizeof(V3d));
+	for(i = 0; i < numJobs; i++)
+		for(j = 0; j < jobs[i].numVertices; j++){
+			uint32 v = jobs[i].minVert + j;
+			tan[v] = add(tan[v], jobs[i].tan[j]);
+			bitan[v] = add(bitan[v], jobs[i].bitan[j]);
+		}
+	for(i = 0; i < geo->numVertices; i++){
+		V3d n = normals[i];
+		V3d tv = projectNormalized(tan[i], n);
+		if(length(tv) == 0.0f){
+			// no UV gradient, any vector in the plane will do
+			V3d axis = fabsf(n.x) < 0.9f ? makeV3d(1.0f, 0.0f, 0.0f) : makeV3d(0.0f, 1.0f, 0.0f);
+			tv = projectNormalized(axis, n);
+		}
+		V4d *dst = &t->tangents[i];
+		dst->x = tv.x;
+		dst->y = tv.y;
+		dst->z = tv.z;
+		dst->w = dot(cross(n, tv), bitan[i]) < 0.0f ? -1.0f : 1.0f;
+	}
+
+	rwFree(tan);
+	rwFree(acc);
+	rwFree(jobs);
+	rwFree(tmpNormals);
+
+	t->serialNum = meshSerial(geo);
+	GETTANGENTS(geo) = t;
+	return t;
+}
+
+void
+Tangents::remove(Geometry *geo)
+{
+	if(tangentGlobals.geoOffset == 0)
+		return;
+	rwFree(GETTANGENTS(geo));
+	GETTANGENTS(geo) = nil;
+}
+
+Tangents*
+Tangents::get(Geometry *geo)
+{
+	if(tangentGlobals.geoOffset == 0)
+		return nil;
+	Tangents *t = GETTANGENTS(geo);
+	if(t == nil || t->numVertices != geo->numVertices ||
+	   t->serialNum != meshSerial(geo))
+		return nil;
+	return t;
+}
+
+static void*
+createTangents(void *object, int32 offset, int32)
+{
+	*PLUGINOFFSET(Tangents*, object, offset) = nil;
+	return object;
+}
+
+static void*
+destroyTangents(void *object, int32 offset, int32)
+{
+	rwFree(*PLUGINOFFSET(Tangents*, object, offset));
+	*PLUGINOFFSET(Tangents*, object, offset) = nil;
+	return object;
+}
+
+static void*
+copyTangents(void *dst, void *src, int32 offset, int32)
+{
+	Tangents *srct = *PLUGINOFFSET(Tangents*, src, offset);
+	if(srct == nil)
+		return dst;
+	Tangents *dstt = allocTangents(srct->numVertices);
+	memcpy(dstt->tangents, srct->tangents, srct->numVertices*sizeof(V4d));
+	dstt->serialNum = srct->serialNum;
+	*PLUGINOFFSET(Tangents*, dst, offset) = dstt;
+	return dst;
+}
+
+static Stream*
+readTangents(Stream *stream, int32, void *object, int32 offset, int32)
+{
+	int32 numVertices = stream->readI32();
+	Tangents *t = allocTangents(numVertices);
+	stream->read32(t->tangents, numVertices*sizeof(V4d));
+	rwFree(*PLUGINOFFSET(Tangents*, object, offset));
+	*PLUGINOFFSET(Tangents*, object, offset) = t;
+	return stream;
+}
+
+static Stream*
+writeTangents(Stream *stream, int32, void *object, int32 offset, int32)
+{
+	Tangents *t = *PLUGINOFFSET(Tangents*, object, offset);
+	stream->writeI32(t->numVertices);
+	stream->write32(t->tangents, t->numVertices*sizeof(V4d));
+	return stream;
+}
+
+static int32
+getSizeTangents(void *object, int32, int32)
+{
+	Tangents *t = Tangents::get((Geometry*)object);
+	if(t == nil)
+		return 0;
+	return 4 + t->numVertices*sizeof(V4d);
+}
+
+// The mesh header may be read after us
+static void
+tangentsAlways(void *object, int32 offset, int32)
+{
+	Geometry *geo = (Geometry*)object;
+	Tangents *t = *PLUGINOFFSET(Tangents*, object, offset);
+	if(t)
+		t->serialNum = meshSerial(geo);
+}
+
+void
+registerTangentPlugin(void)
+{
+	tangentGlobals.geoOffset = Geometry::registerPlugin(sizeof(Tangents*), ID_TANGENTS,
+		createTangents, destroyTangents, copyTangents);
+	Geometry::registerPluginStream(ID_TANGENTS, readTangents, writeTangents, getSizeTangents);
+	Geometry::setStreamAlwaysCallback(ID_TANGENTS, tangentsAlways);
+}
+
+}
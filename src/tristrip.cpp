@@ -15,6 +15,16 @@
 
 namespace rw {
 
+static int32 tristripMode = Geometry::TRISTRIPSEARCH;
+static int32 tristripMaxSearches = 1000;
+
+void
+Geometry::setTristripMode(int32 mode, int32 maxTunnelSearches)
+{
+	tristripMode = mode;
+	tristripMaxSearches = maxTunnelSearches;
+}
+
 struct GraphEdge
 {
 	int32 node;	/* index of the connected node */
@@ -30,6 +40,7 @@ struct StripNode
 	uint8 visited : 1;	/* visited in breadth first search */
 	uint8 stripVisited : 1;	/* strip starting at this node was visited during search */
 	uint8 isEnd : 1;	/* is in end list */
+	uint8 tried : 1;	/* tunnel search failed from here (fast mode) */
 	GraphEdge e[3];
 	int32 stripId;	/* index of start node */
 	LLLink inlist;
@@ -41,6 +52,10 @@ struct StripMesh
 	StripNode *nodes;
 	LinkList loneNodes;	/* nodes not connected to any others */
 	LinkList endNodes;	/* strip start/end nodes */
+	/* nodes visited by findTunnel, so we don't have to reset everything.
+	 * only used in fast mode */
+	int32 *touched;
+	int32 numTouched;
 };
 
 //#define trace(...) printf(__VA_ARGS__)
@@ -113,6 +128,7 @@ collectFaces(Geometry *geo, StripMesh *sm, uint16 m)
 			n->visited = 0;
 			n->stripVisited = 0;
 			n->isEnd = 0;
+			n->tried = 0;
 			n->stripId = -1;
 			n->inlist.init();
 		}
@@ -176,6 +192,64 @@ connectNodesPreserve(StripMesh *sm)
 	}
 }
 
+static uint32
+edgeHash(int32 a, int32 b)
+{
+	return (uint32)a*0x9E3779B1u ^ (uint32)b*0x85EBCA77u;
+}
+
+/* Same as connectNodesPreserve but finds edges with a hash table
+ * instead of searching all nodes for every edge. */
+static void
+connectNodesHashed(StripMesh *sm)
+{
+	StripNode *n, *nn;
+	int32 numEdges = sm->numNodes*3;
+	uint32 numBuckets = 16;
+	while(numBuckets < (uint32)numEdges)
+		numBuckets <<= 1;
+	int32 *buckets = rwNewT(int32, numBuckets + numEdges, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 *next = buckets + numBuckets;
+	memset(buckets, 0xFF, numBuckets*sizeof(int32));
+	/* Insert backwards so chains are in node order
+	 * and we find the same edge findEdge would. */
+	for(int32 i = numEdges-1; i >= 0; i--){
+		n = &sm->nodes[i/3];
+		int32 j = i%3;
+		uint32 h = edgeHash(n->v[j], n->v[(j+1) % 3]) & (numBuckets-1);
+		next[i] = buckets[h];
+		buckets[h] = i;
+	}
+	for(int32 i = 0; i < sm->numNodes; i++){
+		n = &sm->nodes[i];
+		for(int32 j = 0; j < 3; j++){
+			if(n->e[j].isConnected)
+				continue;
+			/* flip edge and search for node */
+			int32 e0 = n->v[(j+1) % 3];
+			int32 e1 = n->v[j];
+			uint32 h = edgeHash(e0, e1) & (numBuckets-1);
+			for(int32 k = buckets[h]; k >= 0; k = next[k]){
+				nn = &sm->nodes[k/3];
+				int32 jj = k%3;
+				if(nn->e[jj].isConnected ||
+				   nn->v[jj] != e0 || nn->v[(jj+1) % 3] != e1)
+					continue;
+				n->e[j].node = k/3;
+				n->e[j].isConnected = 1;
+				n->e[j].otherEdge = jj;
+				n->e[j].isStrip = 0;
+				nn->e[jj].node = i;
+				nn->e[jj].isConnected = 1;
+				nn->e[jj].otherEdge = j;
+				nn->e[jj].isStrip = 0;
+				break;
+			}
+		}
+	}
+	rwFree(buckets);
+}
+
 static int32
 numConnections(StripNode *n)
 {
@@ -254,17 +328,97 @@ buildStrips(StripMesh *sm)
 	}
 }
 
+static int32
+numFreeNeighbours(StripMesh *sm, StripNode *n)
+{
+	int32 num = 0;
+	for(int32 i = 0; i < 3; i++)
+		if(n->e[i].isConnected &&
+		   sm->nodes[n->e[i].node].stripId < 0)
+			num++;
+	return num;
+}
+
+/* Like extendStrip but always continue to the neighbour
+ * that has the fewest free neighbours itself,
+ * so we don't leave lonely triangles behind. */
+static void
+extendStripGreedy(StripMesh *sm, StripNode *start)
+{
+	StripNode *n, *nn, *best;
+	int32 bestEdge, bestFree, f;
+	n = start;
+	if(numConnections(n) == 0){
+		sm->loneNodes.append(&n->inlist);
+		return;
+	}
+	sm->endNodes.append(&n->inlist);
+	n->isEnd = 1;
+	for(;;){
+		best = nil;
+		bestEdge = -1;
+		bestFree = 4;
+		for(int32 i = 0; i < 3; i++){
+			if(!n->e[i].isConnected)
+				continue;
+			nn = &sm->nodes[n->e[i].node];
+			if(nn->stripId >= 0)
+				continue;
+			f = numFreeNeighbours(sm, nn);
+			if(f < bestFree){
+				best = nn;
+				bestEdge = i;
+				bestFree = f;
+			}
+		}
+		if(best == nil)
+			break;
+		best->stripId = n->stripId;
+		complementEdge(sm, &n->e[bestEdge]);
+		n = best;
+	}
+	if(n != start){
+		sm->endNodes.append(&n->inlist);
+		n->isEnd = 1;
+	}
+}
+
+/* Start strips at the nodes with the fewest connections first */
+static void
+buildStripsGreedy(StripMesh *sm)
+{
+	StripNode *n;
+	for(int32 c = 0; c <= 3; c++)
+		for(int32 i = 0; i < sm->numNodes; i++){
+			n = &sm->nodes[i];
+			if(n->stripId >= 0 || numConnections(n) != c)
+				continue;
+			n->stripId = i;
+			extendStripGreedy(sm, n);
+		}
+}
+
+#define TOUCH(sm, n) if((sm)->touched) (sm)->touched[(sm)->numTouched++] = (n) - (sm)->nodes
+
 static StripNode*
 findTunnel(StripMesh *sm, StripNode *n)
 {
 	LinkList searchNodes;
-	StripNode *nn;
+	StripNode *start, *nn;
 	int edgetype;
 	int isEnd;
 
 	searchNodes.init();
-	edgetype = 0;
+	/* Don't come back to where we started */
+	start = n;
+	start->visited = 1;
+	sm->nodes[start->stripId].stripVisited = 1;
+	TOUCH(sm, start);
+	TOUCH(sm, &sm->nodes[start->stripId]);
 	for(;;){
+		/* Edges have to alternate along the path,
+		 * the start node continues with a non-strip edge. */
+		edgetype = n == start ? 0 : !n->e[n->parent].isStrip;
 		for(int32 i = 0; i < 3; i++){
 			/* Find a node connected by the right edgetype */
 			if(!n->e[i].isConnected ||
@@ -277,12 +431,12 @@ findTunnel(StripMesh *sm, StripNode *n)
 			if(nn->visited)
 				continue;
 
-			/* Don't allow non-strip edge between nodes of the same
-			 * strip to prevent loops.
-			 * Actually these edges are allowed under certain
+			/* Don't enter a strip we've been in already to prevent loops.
+			 * This also excludes non-strip edges between nodes of the same strip.
+			 * Actually these are allowed under certain
 			 * circumstances, but they require complex checks. */
 			if(edgetype == 0 &&
-			   n->stripId == nn->stripId)
+			   sm->nodes[nn->stripId].stripVisited)
 				continue;
 
 			isEnd = IsEnd(nn);
@@ -294,6 +448,8 @@ findTunnel(StripMesh *sm, StripNode *n)
 			nn->parent = n->e[i].otherEdge;
 			nn->visited = 1;
 			sm->nodes[nn->stripId].stripVisited = 1;
+			TOUCH(sm, nn);
+			TOUCH(sm, &sm->nodes[nn->stripId]);
 
 			/* Search complete. */
 			if(isEnd && edgetype == 0)
@@ -306,7 +462,6 @@ findTunnel(StripMesh *sm, StripNode *n)
 			return nil;
 		n = LLLinkGetData(searchNodes.link.next, StripNode, inlist);
 		n->inlist.remove();
-		edgetype = !edgetype;
 	}
 }
 
@@ -314,6 +469,15 @@ static void
 resetGraph(StripMesh *sm)
 {
 	StripNode *n;
+	if(sm->touched){
+		for(int32 i = 0; i < sm->numTouched; i++){
+			n = &sm->nodes[sm->touched[i]];
+			n->visited = 0;
+			n->stripVisited = 0;
+		}
+		sm->numTouched = 0;
+		return;
+	}
 	for(int32 i = 0; i < sm->numNodes; i++){
 		n = &sm->nodes[i];
 		n->visited = 0;
@@ -425,6 +589,36 @@ again:
 	trace("tunneling done!\n");
 }
 
+/* Like tunnel but don't search again from nodes that
+ * have failed before and stop after maxSearches searches. */
+static void
+tunnelBounded(StripMesh *sm, int32 maxSearches, TristripStats *stats)
+{
+	StripNode *n, *nn;
+	int32 numSearches = 0;
+
+again:
+	FORLIST(lnk, sm->endNodes){
+		n = LLLinkGetData(lnk, StripNode, inlist);
+		if(n->tried)
+			continue;
+		if(numSearches >= maxSearches)
+			break;
+		numSearches++;
+		nn = findTunnel(sm, n);
+		resetGraph(sm);
+		if(nn){
+			applyTunnel(sm, nn, n);
+			if(stats)
+				stats->numTunnels++;
+			goto again;
+		}
+		n->tried = 1;
+	}
+	if(stats)
+		stats->numSearches += numSearches;
+}
+
 /* Get next edge in strip.
  * Last is the edge index whence we came lest we go back. */
 static int
@@ -558,28 +752,49 @@ static void verifyMesh(Geometry *geo);
  * 1. build dual graph (collectFaces, connectNodes)
  * 2. make some simple strip (buildStrips)
  * 3. apply tunnel operator (tunnel)
+ *
+ * TRISTRIPFAST uses a hash table to build the graph,
+ * builds strips greedily and tunnels for a limited number of searches.
  */
 void
-Geometry::buildTristrips(void)
+Geometry::buildTristrips(TristripStats *stats)
 {
 	int32 i;
 	uint16 *indices;
 	MeshHeader *header;
 	Mesh *ms, *md;
 	StripMesh smesh;
+	bool32 fast = tristripMode == TRISTRIPFAST;
 
 //	trace("%ld\n", sizeof(StripNode));
 
+	// buildMeshes makes triangle lists for these
+	assert(!(this->flags & INDEX32) && "can't tristrip 32 bit indices");
+
+	if(stats)
+		memset(stats, 0, sizeof(TristripStats));
+
 	this->allocateMeshes(matList.numMaterials, 0, 1);
 
 	smesh.nodes = rwNewT(StripNode, this->numTriangles, MEMDUR_FUNCTION | ID_GEOMETRY);
+	smesh.touched = nil;
+	smesh.numTouched = 0;
+	if(fast)
+		smesh.touched = rwNewT(int32, (this->numTriangles+1)*2, MEMDUR_FUNCTION | ID_GEOMETRY);
 	ms = this->meshHeader->getMeshes();
 	for(int32 i = 0; i < this->matList.numMaterials; i++){
 		smesh.loneNodes.init();
 		smesh.endNodes.init();
 		collectFaces(this, &smesh, i);
-		connectNodesPreserve(&smesh);
-		buildStrips(&smesh);
+		if(fast){
+			connectNodesHashed(&smesh);
+			buildStripsGreedy(&smesh);
+			if(tristripMaxSearches > 0)
+				tunnelBounded(&smesh, tristripMaxSearches, stats);
+		}else{
+			connectNodesPreserve(&smesh);
+			buildStrips(&smesh);
+		}
 printSmesh(&smesh);
 //trace("-------\n");
 //printLone(&smesh);
@@ -594,7 +809,20 @@ printSmesh(&smesh);
 		ms[i].material = this->matList.materials[i];
 		makeMesh(&smesh, &ms[i]);
 		this->meshHeader->totalIndices += ms[i].numIndices;
+
+		if(stats){
+			stats->numTriangles += smesh.numNodes;
+			FORLIST(lnk, smesh.endNodes){
+				StripNode *n = LLLinkGetData(lnk, StripNode, inlist);
+				if(numStripEdges(n) == 0)
+					stats->numLoneTriangles++;
+				else if(n->stripId == (n - smesh.nodes))
+					stats->numStrips++;
+			}
+			stats->numLoneTriangles += smesh.loneNodes.count();
+		}
 	}
+	rwFree(smesh.touched);
 	rwFree(smesh.nodes);
 
 	/* Now re-allocate and copy data */
@@ -613,30 +841,68 @@ printSmesh(&smesh);
 		rwFree(ms[i].indices);
 	}
 	rwFree(header);
+	if(stats)
+		stats->numIndices = this->meshHeader->totalIndices;
 
 	verifyMesh(this);
 }
 
+/* Triangle as material and vertices rotated so the smallest comes first.
+ * Two triangles are the same if these are equal. */
+struct VerifyTri
+{
+	int32 m, a, b, c;
+};
+
+static void
+makeVerifyTri(VerifyTri *t, int32 m, int32 a, int32 b, int32 c)
+{
+	t->m = m;
+	if(a <= b && a <= c){
+		t->a = a; t->b = b; t->c = c;
+	}else if(b <= a && b <= c){
+		t->a = b; t->b = c; t->c = a;
+	}else{
+		t->a = c; t->b = a; t->c = b;
+	}
+}
+
+static int
+cmpVerifyTri(const void *a, const void *b)
+{
+	const VerifyTri *ta = (const VerifyTri*)a;
+	const VerifyTri *tb = (const VerifyTri*)b;
+	if(ta->m != tb->m) return ta->m < tb->m ? -1 : 1;
+	if(ta->a != tb->a) return ta->a < tb->a ? -1 : 1;
+	if(ta->b != tb->b) return ta->b < tb->b ? -1 : 1;
+	if(ta->c != tb->c) return ta->c < tb->c ? -1 : 1;
+	return 0;
+}
+
 /* Check that tristripped mesh and geometry triangles are actually the same. */
 static void
 verifyMesh(Geometry *geo)
 {
-	int32 i, k;
+	int32 i, n;
 	uint32 j;
 	int32 x;
 	int32 a, b, c, m;
 	Mesh *mesh;
-	Triangle *t;
-	uint8 *seen;
+	VerifyTri *geotris, *striptris;
 
-	seen = rwNewT(uint8, geo->numTriangles, MEMDUR_FUNCTION | ID_GEOMETRY);
-	memset(seen, 0, geo->numTriangles);
+	geotris = rwNewT(VerifyTri, geo->numTriangles, MEMDUR_FUNCTION | ID_GEOMETRY);
+	striptris = rwNewT(VerifyTri, geo->numTriangles, MEMDUR_FUNCTION | ID_GEOMETRY);
+	for(i = 0; i < geo->numTriangles; i++){
+		Triangle *t = &geo->triangles[i];
+		makeVerifyTri(&geotris[i], t->matId, t->v[0], t->v[1], t->v[2]);
+	}
 
+	n = 0;
 	mesh = geo->meshHeader->getMeshes();
 	for(i = 0; i < geo->meshHeader->numMeshes; i++){
 		m = geo->matList.findIndex(mesh->material);
 		x = 0;
-		for(j = 0; j < mesh->numIndices-2; j++){
+		for(j = 0; j+2 < mesh->numIndices; j++){
 			a = mesh->indices[j+x];
 			x = !x;
 			b = mesh->indices[j+x];
@@ -650,33 +916,28 @@ verifyMesh(Geometry *geo)
 			if(a == b || a == c || b == c)
 				continue;
 trace("%d %d %d\n", a, b, c);
-
-			/* now that we have a triangle, try to find it */
-			for(k = 0; k < geo->numTriangles; k++){
-				t = &geo->triangles[k];
-				if(seen[k] || t->matId != m) continue;
-				if((t->v[0] == a && t->v[1] == b && t->v[2] == c) ||
-				   (t->v[1] == a && t->v[2] == b && t->v[0] == c) ||
-				   (t->v[2] == a && t->v[0] == b && t->v[1] == c)){
-					seen[k] = 1;
-					goto found;
-				}
-			}
-			goto loss;
-		found:	;
+			/* more triangles than the geometry has */
+			if(n >= geo->numTriangles)
+				goto loss;
+			makeVerifyTri(&striptris[n++], m, a, b, c);
 		}
 		mesh++;
 	}
 
-	/* Also check that all triangles are in the mesh */
-	for(i = 0; i < geo->numTriangles; i++)
-		if(!seen[i]){
+	/* Both sets of triangles have to be the same */
+	if(n != geo->numTriangles)
+		goto loss;
+	qsort(geotris, n, sizeof(VerifyTri), cmpVerifyTri);
+	qsort(striptris, n, sizeof(VerifyTri), cmpVerifyTri);
+	for(i = 0; i < n; i++)
+		if(cmpVerifyTri(&geotris[i], &striptris[i]) != 0){
 	loss:
 			fprintf(stderr, "TRISTRIP verify failed\n");
 			exit(1);
 		}
 
-	rwFree(seen);
+	rwFree(geotris);
+	rwFree(striptris);
 }
 
 }
@@ -0,0 +1,364 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "rwbase.h"
+#include "rwerror.h"
+#include "rwplg.h"
+#include "rwpipeline.h"
+#include "rwobjects.h"
+#include "rwengine.h"
+#include "rwanim.h"
+#include "rwplugins.h"
+
+#define PLUGIN_ID ID_GEOMETRY
+
+/*
+ * Post-transform vertex cache and vertex fetch optimization.
+ *
+ * Triangle order is optimized with Tom Forsyth's
+ * "Linear-Speed Vertex Cache Optimisation".
+ * Vertices are then reordered by first use so the
+ * vertex buffer is read mostly linearly.
+ */
+
+namespace rw {
+
+static bool32 vertexCacheOptimization;
+
+void Geometry::setVertexCacheOptimization(bool32 b) { vertexCacheOptimization = b; }
+bool32 Geometry::getVertexCacheOptimization(void) { return vertexCacheOptimization; }
+
+enum {
+	CACHESIZE = 32,		// simulated LRU cache
+	MAXVALENCE = 32		// higher valences get the same score
+};
+
+static float32 cachePosScore[CACHESIZE];
+static float32 valenceScore[MAXVALENCE];
+
+static void
+initScoreTables(void)
+{
+	static bool32 initialized;
+	if(initialized)
+		return;
+	// the last triangle's vertices get a fixed score so
+	// we don't prefer to just continue in the same direction
+	for(int32 i = 0; i < CACHESIZE; i++)
+		cachePosScore[i] = i < 3 ? 0.75f :
+			powf(1.0f - (i-3)/(float32)(CACHESIZE-3), 1.5f);
+	// boost vertices with few triangles left so we get rid of them
+	valenceScore[0] = 0.0f;
+	for(int32 i = 1; i < MAXVALENCE; i++)
+		valenceScore[i] = 2.0f/sqrtf((float32)i);
+	initialized = 1;
+}
+
+static float32
+vertexScore(int32 cachePos, int32 numActive)
+{
+	if(numActive == 0)
+		return -1.0f;
+	float32 score = cachePos < 0 ? 0.0f : cachePosScore[cachePos];
+	return score + valenceScore[numActive < MAXVALENCE ? numActive : MAXVALENCE-1];
+}
+
+/* Reorder the triangles of a triangle list mesh.
+ * numVertices is the range of the indices. */
+static void
+optimizeTriList(Mesh *m, int32 numVertices)
+{
+	int32 numTris = m->numIndices/3;
+	if(numTris < 2)
+		return;
+	initScoreTables();
+
+	// per vertex: triangles that still use it
+	int32 *numActive = rwNewT(int32, numVertices, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 *triOffset = rwNewT(int32, numVertices+1, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 *cachePos = rwNewT(int32, numVertices, MEMDUR_FUNCTION | ID_GEOMETRY);
+	float32 *vertScore = rwNewT(float32, numVertices, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 *vertTris = rwNewT(int32, numTris*3, MEMDUR_FUNCTION | ID_GEOMETRY);
+	// per triangle
+	float32 *triScore = rwNewT(float32, numTris, MEMDUR_FUNCTION | ID_GEOMETRY);
+	uint8 *triAdded = rwNewT(uint8, numTris, MEMDUR_FUNCTION | ID_GEOMETRY);
+	uint32 *indices = rwNewT(uint32, numTris*3, MEMDUR_FUNCTION | ID_GEOMETRY);
+	uint32 *out = rwNewT(uint32, numTris*3, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 cache[CACHESIZE+3];
+	int32 cacheSize;
+	int32 i, j, k;
+
+	for(i = 0; i < numTris*3; i++)
+		indices[i] = m->getIndex(i);
+
+	memset(numActive, 0, numVertices*sizeof(int32));
+	for(i = 0; i < numTris*3; i++)
+		numActive[indices[i]]++;
+	triOffset[0] = 0;
+	for(i = 0; i < numVertices; i++){
+		triOffset[i+1] = triOffset[i] + numActive[i];
+		numActive[i] = 0;
+		cachePos[i] = -1;
+	}
+	for(i = 0; i < numTris*3; i++){
+		int32 v = indices[i];
+		vertTris[triOffset[v] + numActive[v]++] = i/3;
+	}
+	for(i = 0; i < numVertices; i++)
+		vertScore[i] = vertexScore(-1, numActive[i]);
+	int32 bestTri = -1;
+	float32 bestScore = -1.0f;
+	for(i = 0; i < numTris; i++){
+		triAdded[i] = 0;
+		triScore[i] = vertScore[indices[i*3+0]] +
+			vertScore[indices[i*3+1]] +
+			vertScore[indices[i*3+2]];
+		if(triScore[i] > bestScore){
+			bestScore = triScore[i];
+			bestTri = i;
+		}
+	}
+
+	cacheSize = 0;
+	int32 nextTri = 0;	// fallback when the cache gives us nothing
+	for(int32 n = 0; n < numTris; n++){
+		if(bestTri < 0){
+			while(triAdded[nextTri])
+				nextTri++;
+			bestTri = nextTri;
+		}
+		uint32 *tri = &indices[bestTri*3];
+		out[n*3+0] = tri[0];
+		out[n*3+1] = tri[1];
+		out[n*3+2] = tri[2];
+		triAdded[bestTri] = 1;
+
+		// new cache: the triangle's vertices in front, then the old contents
+		int32 newCache[CACHESIZE+3];
+		int32 newSize = 0;
+		for(j = 0; j < 3; j++){
+			int32 v = tri[j];
+			// take triangle out of vertex's active list
+			int32 *vt = &vertTris[triOffset[v]];
+			for(k = 0; k < numActive[v]; k++)
+				if(vt[k] == bestTri){
+					vt[k] = vt[--numActive[v]];
+					break;
+				}
+			for(k = 0; k < newSize; k++)
+				if(newCache[k] == v)
+					break;
+			if(k == newSize)
+				newCache[newSize++] = v;
+		}
+		for(j = 0; j < cacheSize; j++){
+			int32 v = cache[j];
+			for(k = 0; k < newSize; k++)
+				if(newCache[k] == v)
+					break;
+			if(k == newSize)
+				newCache[newSize++] = v;
+		}
+		// update scores of everything that was or is in the cache
+		for(j = 0; j < newSize; j++){
+			int32 v = newCache[j];
+			cachePos[v] = j < CACHESIZE ? j : -1;
+			vertScore[v] = vertexScore(cachePos[v], numActive[v]);
+		}
+		bestTri = -1;
+		bestScore = -1.0f;
+		for(j = 0; j < newSize; j++){
+			int32 v = newCache[j];
+			int32 *vt = &vertTris[triOffset[v]];
+			for(k = 0; k < numActive[v]; k++){
+				int32 t = vt[k];
+				uint32 *tv = &indices[t*3];
+				triScore[t] = vertScore[tv[0]] + vertScore[tv[1]] + vertScore[tv[2]];
+				if(triScore[t] > bestScore){
+					bestScore = triScore[t];
+					bestTri = t;
+				}
+			}
+		}
+		cacheSize = newSize < CACHESIZE ? newSize : CACHESIZE;
+		memcpy(cache, newCache, cacheSize*sizeof(int32));
+	}
+	for(i = 0; i < numTris*3; i++)
+		m->setIndex(i, out[i]);
+
+	rwFree(numActive);
+	rwFree(triOffset);
+	rwFree(cachePos);
+	rwFree(vertScore);
+	rwFree(vertTris);
+	rwFree(triScore);
+	rwFree(triAdded);
+	rwFree(indices);
+	rwFree(out);
+}
+
+// Tangents belong to the vertices and stay valid for the new meshes.
+// Not Tangents::get, buildMeshes has already changed the mesh serial.
+static Tangents*
+getTangents(Geometry *geo)
+{
+	if(tangentGlobals.geoOffset == 0)
+		return nil;
+	Tangents *t = *PLUGINOFFSET(Tangents*, geo, tangentGlobals.geoOffset);
+	return t && t->numVertices == geo->numVertices ? t : nil;
+}
+
+// Optimize the triangle order of all triangle list meshes
+void
+Geometry::optimizeVertexCache(void)
+{
+	MeshHeader *mh = this->meshHeader;
+	if(this->flags & NATIVE || mh == nil ||
+	   mh->flags == MeshHeader::TRISTRIP)
+		return;
+	Mesh *m = mh->getMeshes();
+	if(m->indices == nil && m->indices32 == nil)
+		return;
+	for(uint32 i = 0; i < mh->numMeshes; i++)
+		optimizeTriList(&m[i], this->numVertices);
+	Tangents *tangents = getTangents(this);
+	// get a new serial number so instance data gets rebuilt
+	this->allocateMeshes(mh->numMeshes, mh->totalIndices, 0);
+	if(tangents)
+		tangents->serialNum = this->meshHeader->serialNum;
+}
+
+// Reorder vertices by their first use in the meshes.
+// Vertices that aren't used by any mesh go to the end.
+void
+Geometry::optimizeVertexFetch(void)
+{
+	MeshHeader *mh = this->meshHeader;
+	if(this->flags & NATIVE || mh == nil || this->numVertices == 0)
+		return;
+	Mesh *m = mh->getMeshes();
+	if(m->indices == nil && m->indices32 == nil)
+		return;
+
+	int32 *remap = rwNewT(int32, this->numVertices, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 *order = rwNewT(int32, this->numVertices, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 n = 0;
+	int32 i;
+	memset(remap, 0xFF, this->numVertices*sizeof(int32));
+	for(uint32 j = 0; j < mh->numMeshes; j++)
+		for(uint32 k = 0; k < m[j].numIndices; k++){
+			uint32 v = m[j].getIndex(k);
+			if(remap[v] < 0){
+				order[n] = v;
+				remap[v] = n++;
+			}
+		}
+	for(i = 0; i < this->numVertices; i++)
+		if(remap[i] < 0){
+			order[n] = i;
+			remap[i] = n++;
+		}
+
+	// Nothing to do, don't cause a reinstance
+	for(i = 0; i < this->numVertices; i++)
+		if(order[i] != i)
+			break;
+	if(i == this->numVertices){
+		rwFree(remap);
+		rwFree(order);
+		return;
+	}
+
+	for(uint32 j = 0; j < mh->numMeshes; j++)
+		for(uint32 k = 0; k < m[j].numIndices; k++)
+			m[j].setIndex(k, remap[m[j].getIndex(k)]);
+	for(i = 0; i < this->numTriangles; i++)
+		this->setTriangle(i,
+			remap[this->getTriVertex(i, 0)],
+			remap[this->getTriVertex(i, 1)],
+			remap[this->getTriVertex(i, 2)],
+			this->getTriMatId(i));
+
+	// Move the vertex data. Use one scratch buffer large enough for everything.
+	int32 nv = this->numVertices;
+	uint8 *tmp = rwNewT(uint8, nv*16, MEMDUR_FUNCTION | ID_GEOMETRY);
+#define REORDER(type, data) { \
+	type *d_ = (type*)(data); \
+	memcpy(tmp, d_, nv*sizeof(type)); \
+	for(i = 0; i < nv; i++) \
+		d_[i] = ((type*)tmp)[order[i]]; }
+
+	for(int32 j = 0; j < this->numMorphTargets; j++){
+		MorphTarget *mt = &this->morphTargets[j];
+		if(mt->vertices) REORDER(V3d, mt->vertices);
+		if(mt->normals) REORDER(V3d, mt->normals);
+	}
+	if(this->colors) REORDER(RGBA, this->colors);
+	for(int32 j = 0; j < this->numTexCoordSets; j++)
+		if(this->texCoords[j]) REORDER(TexCoords, this->texCoords[j]);
+	Skin *skin = skinGlobals.geoOffset ? Skin::get(this) : nil;
+	if(skin && skin->weights){
+		// 4 weights and 4 indices per vertex
+		struct W { float32 w[4]; };
+		struct I { uint8 i[4]; };
+		REORDER(W, skin->weights);
+		REORDER(I, skin->indices);
+	}
+	Tangents *tangents = getTangents(this);
+	if(tangents)
+		REORDER(V4d, tangents->tangents);
+#undef REORDER
+
+	rwFree(tmp);
+	rwFree(remap);
+	rwFree(order);
+	this->lockedSinceInst |= LOCKALL;
+	// get a new serial number so instance data gets rebuilt
+	this->allocateMeshes(mh->numMeshes, mh->totalIndices, 0);
+	if(tangents)
+		tangents->serialNum = this->meshHeader->serialNum;
+}
+
+// Average cache miss ratio: transformed vertices per triangle
+// with a FIFO cache of cacheSize entries.
+// 0.5 is ideal for large regular meshes, 3 is the worst.
+float32
+Geometry::calculateACMR(int32 cacheSize)
+{
+	MeshHeader *mh = this->meshHeader;
+	if(mh == nil || this->numVertices == 0)
+		return 0.0f;
+	Mesh *m = mh->getMeshes();
+	if(m->indices == nil && m->indices32 == nil)
+		return 0.0f;
+
+	// a vertex is in the cache if it was added less than cacheSize misses ago
+	int32 *timestamp = rwNewT(int32, this->numVertices, MEMDUR_FUNCTION | ID_GEOMETRY);
+	int32 misses = 0;
+	int32 numTris = 0;
+	for(int32 i = 0; i < this->numVertices; i++)
+		timestamp[i] = -cacheSize-1;
+	for(uint32 j = 0; j < mh->numMeshes; j++){
+		uint32 idx[3] = { 0, 0, 0 };	// last three indices
+		for(uint32 k = 0; k < m[j].numIndices; k++){
+			idx[2] = idx[1];
+			idx[1] = idx[0];
+			idx[0] = m[j].getIndex(k);
+			if(misses - timestamp[idx[0]] > cacheSize)
+				timestamp[idx[0]] = misses++;
+			if(mh->flags == MeshHeader::TRISTRIP){
+				if(k >= 2 && idx[0] != idx[1] &&
+				   idx[0] != idx[2] && idx[1] != idx[2])
+					numTris++;
+			}else if(k%3 == 2)
+				numTris++;
+		}
+	}
+	rwFree(timestamp);
+	return numTris ? (float32)misses/numTris : 0.0f;
+}
+
+}
@@ -30,6 +30,7 @@ namespace rw
 {
 	constexpr static int32_t MAX_OBJECT_SIZE = 4096;
 	constexpr static int32_t MAX_LIGHTS = 32;
+	constexpr static int32_t INDEX32_OFFSET = 0x40000000;	// flag in the index offset, see Common.glsl
 
 	struct EngineOpenParams
 	{
@@ -71,6 +72,7 @@ namespace rw
 			ATTRIB_TEXCOORDS5,
 			ATTRIB_TEXCOORDS6,
 			ATTRIB_TEXCOORDS7,
+			ATTRIB_TANGENT,
 		};
 
 		// default uniform indices
@@ -93,6 +95,7 @@ namespace rw
 			uint32      serialNumber;
 			uint32      numMeshes;
 			uint16* indexBuffer;
+			uint32* indexBuffer32;        // instead of indexBuffer for more than 64k vertices
 			maple::DrawType primType;
 			uint8* vertexBuffer;
 			int32       numAttribs;
@@ -102,6 +105,7 @@ namespace rw
 
 			maple::VertexBuffer* vertexBufferGPU;
 			maple::IndexBuffer* indexBufferGPU;
+			uint32      morphSerial;        // of the morph blend in the vertex buffer
 
 			InstanceData* inst;
 			uint32    meshId;
@@ -303,7 +307,7 @@ namespace rw
 
 		// per Object
 		void  setWorldMatrix(Matrix*);
-		int32 setLights(WorldLights* lightData, const std::vector<LightData> & lights);
+		int32 setLights(WorldLights* lightData, const LightData* lights, int32 numLights);
 
 
 		// per Mesh
@@ -375,11 +379,17 @@ namespace rw
 
 			void (*instanceCB)(Geometry* geo, InstanceDataHeader* header, bool32 reinstance);
 			void (*uninstanceCB)(Geometry* geo, InstanceDataHeader* header);
+			// instanceCB split for prepareInstance: the CPU part
+			// and the buffer creation on the render thread; optional
+			void (*packCB)(Geometry* geo, InstanceDataHeader* header, bool32 reinstance);
+			void (*uploadCB)(Geometry* geo, InstanceDataHeader* header, bool32 reinstance);
 			void (*renderCB)(Atomic* atomic, InstanceDataHeader* header);
 			void (*beginUpdate)(Atomic* atomic, InstanceDataHeader* header);
 		};
 
 		void  defaultInstanceCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance);
+		void  defaultPackCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance);
+		void  defaultUploadCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance);
 		void  defaultUninstanceCB(Geometry* geo, InstanceDataHeader* header);
 		void  defaultRenderCB(Atomic* atomic, InstanceDataHeader* header);
 		void  defaultUpdateCB(Atomic* atomic, InstanceDataHeader* header);
@@ -9,6 +9,8 @@ namespace rw
 		void         initSkin(void);
 		ObjPipeline *makeSkinPipeline(void);
 		void         skinInstanceCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance);
+		void         skinPackCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance);
+		void         skinUploadCB(Geometry *geo, InstanceDataHeader *header, bool32 reinstance);
 		void         skinRenderCB(Atomic *atomic, InstanceDataHeader *header);
 		void         uploadSkinMatrices(Atomic *atomic);
 
@@ -20,17 +20,27 @@ Vertex getVertex(uint meshIdx, uint vertexIdx)
     return Vertices[nonuniformEXT(meshIdx)].data[vertexIdx];
 }
 
+uint getIndex(uint instanceId, uint i, bool index32)
+{
+    if(index32)
+        return (uint(Indices[nonuniformEXT(instanceId)].data[2 * i]) & 0xFFFFu) |
+            (uint(Indices[nonuniformEXT(instanceId)].data[2 * i + 1]) << 16);
+    // the buffers are declared signed
+    return uint(Indices[nonuniformEXT(instanceId)].data[i]) & 0xFFFFu;
+}
+
 Triangle getTriangle(in Object transform, uint instanceId, in HitInfo hitInfo)
 {
     Triangle tri;
 
-    uint primitiveId = hitInfo.primitiveId * 3 + hitInfo.primitiveOffset;
+    bool index32 = (hitInfo.primitiveOffset & INDEX32_OFFSET) != 0u;
+    uint primitiveId = hitInfo.primitiveId * 3 + (hitInfo.primitiveOffset & ~INDEX32_OFFSET);
 
     uvec3 idx = uvec3
     (
-        Indices[nonuniformEXT(instanceId)].data[primitiveId], 
-        Indices[nonuniformEXT(instanceId)].data[primitiveId + 1],
-        Indices[nonuniformEXT(instanceId)].data[primitiveId + 2]
+        getIndex(instanceId, primitiveId, index32),
+        getIndex(instanceId, primitiveId + 1, index32),
+        getIndex(instanceId, primitiveId + 2, index32)
     );
 
     tri.v0 = getVertex(instanceId, idx.x);
@@ -15,12 +15,17 @@
 
 #define MAX_LIGHTS 32
 
+// set in Object.u_offsets.x if the mesh has 32 bit indices,
+// they are read as pairs from the int16_t index buffers then
+#define INDEX32_OFFSET 0x40000000u
+
 struct Vertex
 {
     vec3 position;
     vec3 normal;
     vec4 color;
     vec2 texCoord;
+    vec4 tangent;	// xyz tangent, w bitangent sign
 };
 
 
@@ -89,6 +94,7 @@ Vertex interpolatedVertex(in Triangle tri, in vec3 barycentrics)
     o.color = tri.v0.color * barycentrics.x + tri.v1.color * barycentrics.y + tri.v2.color * barycentrics.z;
     o.texCoord.xy = tri.v0.texCoord.xy * barycentrics.x + tri.v1.texCoord.xy * barycentrics.y + tri.v2.texCoord.xy * barycentrics.z;
     o.normal.xyz = normalize(tri.v0.normal.xyz * barycentrics.x + tri.v1.normal.xyz * barycentrics.y + tri.v2.normal.xyz * barycentrics.z);
+    o.tangent = vec4(tri.v0.tangent.xyz * barycentrics.x + tri.v1.tangent.xyz * barycentrics.y + tri.v2.tangent.xyz * barycentrics.z, tri.v0.tangent.w);
     return o;
 }
 
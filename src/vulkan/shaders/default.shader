@@ -5,6 +5,7 @@ layout(location = 0) in vec3 in_pos;
 layout(location = 1) in vec3 in_normal;
 layout(location = 2) in vec4 in_color;
 layout(location = 3) in vec2 in_tex0;
+layout(location = 4) in vec4 in_tangent;	// only read by the matfx bump shader
 
 layout(location = 0) out vec4 v_color;
 layout(location = 1) out vec2 v_tex0;
@@ -5,6 +5,7 @@ layout(location = 0) in vec3 in_pos;
 layout(location = 1) in vec3 in_normal;
 layout(location = 2) in vec4 in_color;
 layout(location = 3) in vec2 in_tex0;
+layout(location = 4) in vec4 in_tangent;
 
 layout(location = 0) out vec4 v_color;
 layout(location = 1) out vec2 v_tex0;
@@ -56,6 +57,7 @@ layout(set = 3, binding = 0, std140) uniform MatfxUniform
 	mat4 u_texMatrix;
 	vec4 u_colorClamp;
 	vec4 u_envColor;
+	vec4 u_bumpLight;	// light direction, shift per unit of tangent space
 };
 
 
@@ -74,7 +76,15 @@ void main(void)
 	vec3 Normal = mat3(u_world) * in_normal;
 
 	v_tex0 = in_tex0;
+#ifdef BUMPMAP
+	// second height lookup is shifted towards the light in tangent space
+	vec3 Tangent = mat3(u_world) * in_tangent.xyz;
+	vec3 Bitangent = cross(Normal, Tangent) * in_tangent.w;
+	vec3 L = -u_bumpLight.xyz;
+	v_tex1 = in_tex0 + vec2(dot(L, Tangent), dot(L, Bitangent))*u_bumpLight.w;
+#else
 	v_tex1 = (u_texMatrix * vec4(Normal, 1.0)).xy;
+#endif
 	v_color = in_color;
 	v_color = clamp(v_color, 0.0, 1.0);
 	v_fog = DoFog(gl_Position.w);
@@ -108,6 +118,7 @@ layout(set = 3, binding = 0, std140) uniform MatfxUniform
 	mat4 u_texMatrix;
 	vec4 u_colorClamp;
 	vec4 u_envColor;
+	vec4 u_bumpLight;	// light direction, shift per unit of tangent space
 };
 
 #define shininess (u_fxparams.x)
@@ -288,6 +299,15 @@ void main(void)
 	vec3 F0 = mix(vec3(0.03), lightColor.xyz, surfDiffuse);
 	lightColor.rgb = DoDynamicLight(v_fragPos, v_gbuffer.xyz, lightColor.xyz, 1 - surfSpecular, F0, surfDiffuse);
 
+#ifdef BUMPMAP
+	// emboss: slopes facing the light get brighter
+	vec3 lum = vec3(0.299, 0.587, 0.114);
+	float h0 = dot(texture(tex1, vec2(v_tex0.x, 1.0-v_tex0.y)).rgb, lum);
+	float h1 = dot(texture(tex1, vec2(v_tex1.x, 1.0-v_tex1.y)).rgb, lum);
+	vec4 color = lightColor;
+	color.rgb *= clamp(1.0 + 2.0*(h0 - h1), 0.0, 2.0);
+	color.rgb = mix(u_fogColor.rgb, color.rgb, v_fog);
+#else
 	vec4 v_envColor = max(lightColor, u_colorClamp) * u_envColor;
 
 	vec4 pass1 = lightColor;
@@ -300,6 +320,7 @@ void main(void)
 	vec4 color;
 	color.rgb = pass1.rgb * pass1.a + pass2.rgb * fba;
 	color.a = pass1.a;
+#endif
 
 	DoAlphaTest(color.a);
 
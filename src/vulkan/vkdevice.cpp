@@ -822,7 +822,7 @@ namespace rw
 			objectDirty = 1;
 		}
 
-		int32 setLights(WorldLights* lightData, const std::vector<LightData>& lights)
+		int32 setLights(WorldLights* lightData, const LightData* lights, int32 numLights)
 		{
 			PROFILE_FUNCTION();
 			int i, n;
@@ -882,8 +882,9 @@ namespace rw
 				}
 			}
 
-			for (auto& points : lights)
+			for (i = 0; i < numLights; i++)
 			{
+				const LightData& points = lights[i];
 				uniformObject.lightParams[n].type = points.type;
 				uniformObject.lightParams[n].radius = points.radius;
 				uniformObject.lightColor[n] = points.color;
@@ -1713,6 +1714,7 @@ namespace rw
 		{
 			closeIm3D();
 			closeIm2D();
+			lighting::destroy();
 
 			defaultShader->destroy();
 			defaultShader = nil;
@@ -35,6 +35,15 @@ namespace rw
 	static maple::StorageBuffer::Ptr lightBufferSSBO;
 	static int32_t lightCount = 0;
 
+	// the local lights of lightBuffer in the current camera's clusters,
+	// rebuilt when the lights or the camera change
+	static LightGrid* lightGrid;
+	static int32_t gridSources[MAX_LIGHT_SIZE];	// grid light to lightBuffer index
+	static uint32_t gridStamps[MAX_LIGHT_SIZE];
+	static uint32_t gridStamp;
+	static bool gridDirty = true;
+	static Matrix gridCameraMatrix;
+
 	static maple::TweakFloat Intensity = { "Lighting:Intensity", 1.5, 0, 10 };
 
 
@@ -53,6 +62,7 @@ namespace rw
 
 		lightCount = 0;
 		lightBuffer.count = 0;
+		gridDirty = true;
 
 		FORLIST(lnk, ((World*)engine->currentWorld)->globalLights) {
 			Light* l = Light::fromWorld(lnk);
@@ -80,6 +90,7 @@ namespace rw
 		std::sort(lightBuffer.lights + 1, lightBuffer.lights + lightBuffer.count, [](const LightData& left, const LightData& right) {
 			return left.distance < right.distance;
 			});
+		gridDirty = true;
 
 		auto bufferPtr = lightBufferSSBO->mapPointer<LightBuffer>();
 		memcpy(bufferPtr, &lightBuffer, sizeof(LightBuffer));
@@ -103,40 +114,108 @@ namespace rw
 			memcpy(&lightBuffer.lights[lightCount].position, &coors, sizeof(rw::V3d));
 			memcpy(&lightBuffer.lights[lightCount].direction, &dir, sizeof(rw::V3d));
 			lightBuffer.count = ++lightCount;
+			gridDirty = true;
 		}
 	}
 
-	std::vector<LightData> lighting::enumerateLights(Atomic* atomic, WorldLights& worldLights)
+	static void updateGrid(Camera* cam)
 	{
-		if (worldLights.numLocals >= MAX_LIGHT_SIZE)
-			return {};
+		if (lightGrid == nullptr)
+			lightGrid = LightGrid::create();
+		if (cam == nullptr || cam->getFrame() == nullptr)
+		{
+			lightGrid->camera = nullptr;
+			return;
+		}
+		Matrix* ltm = cam->getFrame()->getLTM();
+		if (!gridDirty && lightGrid->camera == cam && memcmp(&gridCameraMatrix, ltm, sizeof(Matrix)) == 0)
+			return;
+		gridDirty = false;
+		gridCameraMatrix = *ltm;
+
+		lightGrid->begin(cam);
+		for (int32_t i = 1; i < lightBuffer.count; i++)
+		{
+			Sphere s;
+			s.center = lightBuffer.lights[i].position;
+			s.radius = lightBuffer.lights[i].radius;
+			int32_t li = lightGrid->addSphere(&s);
+			if (li >= 0)
+				gridSources[li] = i;
+		}
+		lightGrid->end();
+	}
 
-		std::vector<LightData> ret;
+	static int32_t addLocalLight(const LightData& light, const Sphere* atomsphere, LightData* found, int32_t n)
+	{
+		V3d dist = sub(light.position, atomsphere->center);
+		float radius = atomsphere->radius + light.radius;
+		if (dot(dist, dist) < radius * radius)
+		{
+			found[n] = light;
+			found[n].distance = length(dist);
+			n++;
+		}
+		return n;
+	}
 
-		for (uint32_t i = 1; i < lightBuffer.count; i++)
+	void lighting::destroy()
+	{
+		if (lightGrid)
+			lightGrid->destroy();
+		lightGrid = nullptr;
+		gridDirty = true;
+	}
+
+	int32_t lighting::enumerateLights(Atomic* atomic, WorldLights& worldLights, LightData* lights, int32_t maxLights)
+	{
+		if (worldLights.numLocals >= MAX_LIGHT_SIZE || maxLights <= 0)
+			return 0;
+
+		LightData found[MAX_LIGHT_SIZE];
+		int32_t n = 0;
+
+		// the grid has all lights that touch the view, enough when the atomic is in view
+		Sphere* atomsphere = atomic->getWorldBoundingSphere();
+		int32 lo[3], hi[3];
+		updateGrid((Camera*)engine->currentCamera);
+		if (lightGrid->camera && lightGrid->getClusterRange(atomsphere, lo, hi))
 		{
-			Sphere* atomsphere = atomic->getWorldBoundingSphere();
-			V3d dist = sub(lightBuffer.lights[i].position, atomsphere->center);
-			float distance = length(dist);
-			if (length(dist) < atomsphere->radius + lightBuffer.lights[i].radius)
+			gridStamp++;
+			for (int32 z = lo[2]; z <= hi[2]; z++)
+			for (int32 y = lo[1]; y <= hi[1]; y++)
 			{
-				ret.push_back(lightBuffer.lights[i]);
-				ret.back().distance = distance;
+				int32 c = lightGrid->getCluster(lo[0], y, z);
+				int32 end = lightGrid->clusterOffsets[lightGrid->getCluster(hi[0], y, z) + 1];
+				for (int32 i = lightGrid->clusterOffsets[c]; i < end; i++)
+				{
+					int32 li = lightGrid->lightIndices[i];
+					if (gridStamps[li] == gridStamp)
+						continue;
+					gridStamps[li] = gridStamp;
+					n = addLocalLight(lightBuffer.lights[gridSources[li]], atomsphere, found, n);
+				}
 			}
 		}
+		else
+		{
+			for (int32_t i = 1; i < lightBuffer.count; i++)
+				n = addLocalLight(lightBuffer.lights[i], atomsphere, found, n);
+		}
 
-		std::sort(ret.begin(), ret.end(), [](const LightData& left, const LightData& right) {
+		// shadow casters first, each group by distance
+		std::sort(found, found + n, [](const LightData& left, const LightData& right) {
+			if (left.castShadow != right.castShadow)
+				return left.castShadow > right.castShadow;
 			return left.distance < right.distance;
 		});
 
-
-		std::sort(ret.begin(), ret.end(), [](const LightData& left, const LightData& right) {
-			return left.castShadow > right.castShadow;
-		});
-
-		ret.push_back(lightBuffer.lights[0]);
-
-		return ret;
+		// keep room for the directional light
+		if (n > maxLights - 1)
+			n = maxLights - 1;
+		memcpy(lights, found, n * sizeof(LightData));
+		lights[n++] = lightBuffer.lights[0];
+		return n;
 	}
 
 	std::vector<rw::LightData> lighting::enumerateLights()
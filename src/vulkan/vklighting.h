@@ -22,7 +22,10 @@ namespace rw
 		void prepareBuffer();
 		std::shared_ptr<maple::StorageBuffer> getLightBuffer(const rw::V3d& cameraPos);
 		void addLight(uint8_t type, const rw::V3d& coors, const rw::V3d& dir, float radius, float red, float green, float blue, bool castShadow);
-		std::vector<LightData> enumerateLights(Atomic * atomic, WorldLights & );
+		// fills lights with at most maxLights lights touching the atomic,
+		// the directional light last, and returns how many there are
+		int32_t enumerateLights(Atomic * atomic, WorldLights &, LightData * lights, int32_t maxLights);
 		std::vector<LightData> enumerateLights();
+		void destroy();
 	}
 }
\ No newline at end of file
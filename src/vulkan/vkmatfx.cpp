@@ -56,6 +56,7 @@ namespace rw
 			float texMatrix[16];
 			float colorClamp[4];
 			float envColor[4];
+			float bumpLight[4];
 		};
 
 		static int32_t MATFX_INIT_SIZE = 1000;
@@ -63,6 +64,8 @@ namespace rw
 		static std::unordered_map<rw::Texture*, maple::DescriptorSet::Ptr> matFXSets;
 		static Shader* envShader, * envShader_noAT;
 		static Shader* envShader_fullLight, * envShader_fullLight_noAT;
+		static Shader* bumpShader, * bumpShader_noAT;
+		static Shader* bumpShader_fullLight, * bumpShader_fullLight_noAT;
 		static maple::UniformBuffer::Ptr uniformBuffer;
 		static maple::DescriptorSet::Ptr uniformSet;
 		static uint32_t alignedSize = 0;
@@ -240,6 +243,71 @@ namespace rw
 			objectIndex++;
 		}
 
+		// Emboss style bump mapping: the bump texture is read as a height map
+		// twice, the second time shifted towards the light in tangent space.
+		void matfxBumpRender(InstanceDataHeader* header, InstanceData* inst, int32 vsBits, uint32 flags, MatFX::Bump* bump, int32_t objectId, int32_t instanceId)
+		{
+			newFrameCheck();
+
+			Material* m;
+			m = inst->material;
+
+			if (bump->tex == nil || bump->coefficient == 0.0f) {
+				matfxDefaultRender(header, inst, vsBits, flags, objectId, instanceId);
+				return;
+			}
+
+			const auto prevColor = m->color;
+
+			if (flags & Geometry::MODULATE)
+			{
+				m->color = { 255,255,255,255 };
+			}
+
+			auto sets = getMatFXSet(bump->tex);
+
+			setTextureBlend(m->texture);//set blend mode
+
+			// the light shines along the frame's at vector, the camera's by default
+			Frame* frame = bump->frame;
+			if (frame == nil)
+				frame = engine->currentCamera->getFrame();
+			V3d* at = &frame->getLTM()->at;
+
+			MatfxUniform matfxUniform;
+			memset(&matfxUniform, 0, sizeof(MatfxUniform));
+			matfxUniform.bumpLight[0] = at->x;
+			matfxUniform.bumpLight[1] = at->y;
+			matfxUniform.bumpLight[2] = at->z;
+			matfxUniform.bumpLight[3] = bump->coefficient / 128.0f;	// about a texel of a 128 map
+
+			uniformBuffer->setDynamicData(sizeof(MatfxUniform), &matfxUniform, alignedSize * objectIndex);
+			uniformSet->setDynamicOffset(alignedSize * objectIndex);
+
+			MAPLE_ASSERT(objectIndex < MATFX_INIT_SIZE, "TODO.........");//resize it later if we need
+
+			rw::SetRenderState(VERTEXALPHA, inst->vertexAlpha || m->color.alpha != 0xFF);
+
+			if ((vsBits & VSLIGHT_MASK) == 0) {
+				if (getAlphaTest())
+					bumpShader->use();
+				else
+					bumpShader_noAT->use();
+			}
+			else {
+				if (getAlphaTest())
+					bumpShader_fullLight->use();
+				else
+					bumpShader_fullLight_noAT->use();
+			}
+
+			drawInst(header, inst, sets, uniformSet, objectId, instanceId);
+
+			m->color = prevColor;
+
+			objectIndex++;
+		}
+
 		void matfxUpdateCB(Atomic* atomic, InstanceDataHeader* header) 
 		{
 			InstanceData* inst = header->inst;
@@ -251,6 +319,10 @@ namespace rw
 				{
 					getMatFXSet(matfx->fx[0].env.tex);
 				}
+				else if (matfx != nullptr && matfx->type == MatFX::BUMPMAP && matfx->fx[0].bump.tex)
+				{
+					getMatFXSet(matfx->fx[0].bump.tex);
+				}
 				else 
 				{
 					auto textureSet = getTextureDescriptorSet(inst->material);
@@ -262,6 +334,8 @@ namespace rw
 		void matfxRenderCB(Atomic* atomic, InstanceDataHeader* header)
 		{
 			uint32 flags = atomic->geometry->flags;
+			// without tangents the vertex buffer holds zeros, nothing to bump
+			bool32 hasTangents = Tangents::get(atomic->geometry) != nil;
 			setWorldMatrix(atomic->getFrame()->getLTM());
 			int32 vsBits = lightingCB(atomic);
 
@@ -283,6 +357,12 @@ namespace rw
 				case MatFX::ENVMAP:
 					matfxEnvRender(header, inst, vsBits, flags, &matfx->fx[0].env, customId++, instanceId);
 					break;
+				case MatFX::BUMPMAP:
+					if (hasTangents)
+						matfxBumpRender(header, inst, vsBits, flags, &matfx->fx[0].bump, customId++, instanceId);
+					else
+						matfxDefaultRender(header, inst, vsBits, flags, customId++, instanceId);
+					break;
 				default:
 					matfxDefaultRender(header, inst, vsBits, flags, customId++, instanceId);
 					break;
@@ -296,6 +376,8 @@ namespace rw
 			ObjPipeline* pipe = ObjPipeline::create();
 			pipe->instanceCB = defaultInstanceCB;
 			pipe->uninstanceCB = defaultUninstanceCB;
+			pipe->packCB = defaultPackCB;
+			pipe->uploadCB = defaultUploadCB;
 			pipe->renderCB = matfxRenderCB;
 			pipe->beginUpdate = matfxUpdateCB;
 			pipe->pluginID = ID_MATFX;
@@ -333,6 +415,20 @@ namespace rw
 					gbuffer_define"#define FRAGMENT_SHADER\n #define NO_ALPHATEST\n",  "MatfxUniform" );
 			assert(envShader_fullLight_noAT);
 
+			bumpShader = Shader::create(defaultTxt, gbuffer_define"#define VERTEX_SHADER\n#define BUMPMAP\n", defaultTxt, gbuffer_define "#define FRAGMENT_SHADER\n#define BUMPMAP\n", "MatfxUniform");
+			assert(bumpShader);
+			bumpShader_noAT = Shader::create(defaultTxt, gbuffer_define"#define VERTEX_SHADER\n#define BUMPMAP\n", defaultTxt, gbuffer_define "#define FRAGMENT_SHADER\n#define BUMPMAP\n #define NO_ALPHATEST\n", "MatfxUniform");
+			assert(bumpShader_noAT);
+
+			bumpShader_fullLight =
+			    Shader::create(defaultTxt, gbuffer_define"#define VERTEX_SHADER\n#define BUMPMAP\n#define DIRECTIONALS\n#define POINTLIGHTS\n#define SPOTLIGHTS\n", defaultTxt,
+					gbuffer_define"#define FRAGMENT_SHADER\n#define BUMPMAP\n", "MatfxUniform");
+			assert(bumpShader_fullLight);
+			bumpShader_fullLight_noAT =
+			    Shader::create(defaultTxt, gbuffer_define"#define VERTEX_SHADER\n#define BUMPMAP\n#define DIRECTIONALS\n#define POINTLIGHTS\n#define SPOTLIGHTS\n", defaultTxt,
+					gbuffer_define"#define FRAGMENT_SHADER\n#define BUMPMAP\n #define NO_ALPHATEST\n", "MatfxUniform");
+			assert(bumpShader_fullLight_noAT);
+
 			alignedSize = maple::GraphicsContext::get()->alignedDynamicUboSize(sizeof(MatfxUniform));
 
 			uniformBuffer = maple::UniformBuffer::create(MATFX_INIT_SIZE * alignedSize, nullptr);
@@ -357,6 +453,15 @@ namespace rw
 			envShader_fullLight_noAT->destroy();
 			envShader_fullLight_noAT = nil;
 
+			bumpShader->destroy();
+			bumpShader = nil;
+			bumpShader_noAT->destroy();
+			bumpShader_noAT = nil;
+			bumpShader_fullLight->destroy();
+			bumpShader_fullLight = nil;
+			bumpShader_fullLight_noAT->destroy();
+			bumpShader_fullLight_noAT = nil;
+
 			return o;
 		}
 
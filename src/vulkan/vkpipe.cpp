@@ -21,6 +21,8 @@
 #include "../rwpipeline.h"
 
 #include "../rwobjects.h"
+#include "../rwanim.h"
+#include "../rwplugins.h"
 
 #include "rwvk.h"
 #include "rwvkimpl.h"
@@ -46,14 +48,8 @@ namespace rw
 
 		static int32_t meshId = 1;
 
-		void freeInstanceData(Geometry* geometry)
+		static void freeHeader(InstanceDataHeader* header)
 		{
-			if (geometry->instData == nil ||
-				geometry->instData->platform != PLATFORM_VULKAN)
-				return;
-			InstanceDataHeader* header = (InstanceDataHeader*)geometry->instData;
-			geometry->instData = nil;
-
 			{
 				auto buffer = (maple::VertexBuffer*)header->vertexBufferGPU;
 				delete buffer;
@@ -67,23 +63,34 @@ namespace rw
 			}
 
 			rwFree(header->indexBuffer);
+			rwFree(header->indexBuffer32);
 			rwFree(header->vertexBuffer);
 			rwFree(header->attribDesc);
 			rwFree(header->inst);
 			rwFree(header);
 		}
 
+		void freeInstanceData(Geometry* geometry)
+		{
+			if (geometry->instData == nil ||
+				geometry->instData->platform != PLATFORM_VULKAN)
+				return;
+			InstanceDataHeader* header = (InstanceDataHeader*)geometry->instData;
+			geometry->instData = nil;
+			freeHeader(header);
+		}
+
 		void* destroyNativeData(void* object, int32, int32)
 		{
 			freeInstanceData((Geometry*)object);
 			return object;
 		}
 
-		static InstanceDataHeader* instanceMesh(rw::ObjPipeline* rwpipe, Geometry* geo)
+		// Everything but the GPU buffers
+		static InstanceDataHeader* packMesh(rw::ObjPipeline* rwpipe, Geometry* geo)
 		{
 			InstanceDataHeader* header = rwNewT(InstanceDataHeader, 1, MEMDUR_EVENT | ID_GEOMETRY);
 			MeshHeader* meshh = geo->meshHeader;
-			geo->instData = header;
 			header->platform = PLATFORM_VULKAN;
 
 			header->serialNumber = meshh->serialNum;
@@ -92,12 +99,23 @@ namespace rw
 			header->totalNumVertex = geo->numVertices;
 			header->totalNumIndex = meshh->totalIndices;
 			header->inst = rwNewT(InstanceData, header->numMeshes, MEMDUR_EVENT | ID_GEOMETRY);
-			header->indexBuffer = rwNewT(uint16, header->totalNumIndex, MEMDUR_EVENT | ID_GEOMETRY);
+			header->indexBuffer = nullptr;
+			header->indexBuffer32 = nullptr;
+			// keep 16 bit indices where they fit, the ray tracing
+			// shaders only take the slower 32 bit path when they must
+			bool index32 = meshh->index32 && geo->numVertices > 0x10000;
+			if (index32)
+				header->indexBuffer32 = rwNewT(uint32, header->totalNumIndex, MEMDUR_EVENT | ID_GEOMETRY);
+			else
+				header->indexBuffer = rwNewT(uint16, header->totalNumIndex, MEMDUR_EVENT | ID_GEOMETRY);
 			InstanceData* inst = header->inst;
 			Mesh* mesh = meshh->getMeshes();
 			uint32 offset = 0;
 			for (uint32 i = 0; i < header->numMeshes; i++) {
-				findMinVertAndNumVertices(mesh->indices, mesh->numIndices, &inst->minVert, &inst->numVertices);
+				if (meshh->index32)
+					findMinVertAndNumVertices(mesh->indices32, mesh->numIndices, &inst->minVert, &inst->numVertices);
+				else
+					findMinVertAndNumVertices(mesh->indices, mesh->numIndices, &inst->minVert, &inst->numVertices);
 				assert(inst->minVert != 0xFFFFFFFF);
 				inst->numIndex = mesh->numIndices;
 				inst->material = mesh->material;
@@ -105,7 +123,13 @@ namespace rw
 				inst->program = 0;
 				inst->offset = offset;
 
-				memcpy(header->indexBuffer + inst->offset, mesh->indices, inst->numIndex * sizeof(uint16_t));
+				if (index32)
+					memcpy(header->indexBuffer32 + inst->offset, mesh->indices32, inst->numIndex * sizeof(uint32_t));
+				else if (meshh->index32)
+					for (uint32 j = 0; j < inst->numIndex; j++)
+						header->indexBuffer[inst->offset + j] = (uint16)mesh->indices32[j];
+				else
+					memcpy(header->indexBuffer + inst->offset, mesh->indices, inst->numIndex * sizeof(uint16_t));
 				offset += inst->numIndex;// *2;
 				mesh++;
 				inst++;
@@ -114,13 +138,55 @@ namespace rw
 			header->vertexBuffer = nullptr;
 			header->numAttribs = 0;
 			header->vertexBufferGPU = nullptr;
+			header->indexBufferGPU = nullptr;
 			header->attribDesc = nullptr;
-			header->indexBufferGPU = maple::IndexBuffer::createRaw(header->indexBuffer, header->totalNumIndex);
+			header->morphSerial = 0;
+			return header;
+		}
+
+		static void createIndexBuffer(InstanceDataHeader* header)
+		{
+			if (header->indexBuffer32)
+				header->indexBufferGPU = maple::IndexBuffer::createRaw(header->indexBuffer32, header->totalNumIndex);
+			else
+				header->indexBufferGPU = maple::IndexBuffer::createRaw(header->indexBuffer, header->totalNumIndex);
 			header->meshId = meshId++;
+		}
 
+		static InstanceDataHeader* instanceMesh(rw::ObjPipeline* rwpipe, Geometry* geo)
+		{
+			InstanceDataHeader* header = packMesh(rwpipe, geo);
+			geo->instData = header;
+			createIndexBuffer(header);
 			return header;
 		}
 
+		// Positions and normals of the atomic's morph blend.
+		// Atomics sharing a geometry overwrite each other's blend,
+		// so this only uploads when the blend is a different one.
+		static void instanceMorph(Atomic* atomic, InstanceDataHeader* header)
+		{
+			MorphAtomic* m = Morph::get(atomic);
+			if (header->morphSerial == m->serial)
+				return;
+			AttribDesc* a;
+			for (a = header->attribDesc; a->index != ATTRIB_POS; a++)
+				;
+			instV3d(VERT_FLOAT3, header->vertexBuffer + a->offset,
+				Morph::getVertices(atomic), header->totalNumVertex, a->stride);
+			// without normals they were calculated for morph target 0
+			V3d* normals = Morph::getNormals(atomic);
+			if (normals)
+			{
+				for (a = header->attribDesc; a->index != ATTRIB_NORMAL; a++)
+					;
+				instV3d(VERT_FLOAT3, header->vertexBuffer + a->offset,
+					normals, header->totalNumVertex, a->stride);
+			}
+			header->vertexBufferGPU->setData(header->totalNumVertex * header->attribDesc[0].stride, header->vertexBuffer);
+			header->morphSerial = m->serial;
+		}
+
 		static void instance(rw::ObjPipeline* rwpipe, Atomic* atomic)
 		{
 			ObjPipeline* pipe = (ObjPipeline*)rwpipe;
@@ -148,9 +214,45 @@ namespace rw
 				pipe->instanceCB(geo, (InstanceDataHeader*)geo->instData, 0);
 			}
 			else if (geo->lockedSinceInst)
+			{
+				if (geo->lockedSinceInst & (Geometry::LOCKVERTICES | Geometry::LOCKNORMALS))
+					((InstanceDataHeader*)geo->instData)->morphSerial = 0;
 				pipe->instanceCB(geo, (InstanceDataHeader*)geo->instData, 1);
+			}
 
 			geo->lockedSinceInst = 0;
+
+			if (morphGlobals.atomicOffset)
+				instanceMorph(atomic, (InstanceDataHeader*)geo->instData);
+		}
+
+		// The CPU half of instance, no Vulkan calls
+		static rw::InstanceDataHeader* prepareInstance(rw::ObjPipeline* rwpipe, Atomic* atomic)
+		{
+			ObjPipeline* pipe = (ObjPipeline*)rwpipe;
+			Geometry* geo = atomic->geometry;
+			if (pipe->packCB == nil || geo->instData ||
+				(geo->flags & Geometry::NATIVE))
+				return nil;
+			InstanceDataHeader* header = packMesh(rwpipe, geo);
+			pipe->packCB(geo, header, 0);
+			return header;
+		}
+
+		// The GPU half, on the render thread
+		static void uploadInstance(rw::ObjPipeline* rwpipe, Geometry* geo, rw::InstanceDataHeader* rwheader)
+		{
+			ObjPipeline* pipe = (ObjPipeline*)rwpipe;
+			InstanceDataHeader* header = (InstanceDataHeader*)rwheader;
+			if (geo->instData)
+			{
+				// prepared twice or instanced since
+				freeHeader(header);
+				return;
+			}
+			createIndexBuffer(header);
+			geo->instData = header;
+			pipe->uploadCB(geo, header, 0);
 		}
 
 		static void	uninstance(rw::ObjPipeline* rwpipe, Atomic* atomic)
@@ -187,9 +289,13 @@ namespace rw
 			this->impl.uninstance = vulkan::uninstance;
 			this->impl.render = vulkan::render;
 			this->impl.beginUpdate = vulkan::beginUpdate;
+			this->impl.prepareInstance = vulkan::prepareInstance;
+			this->impl.uploadInstance = vulkan::uploadInstance;
 
 			this->instanceCB = nil;
 			this->uninstanceCB = nil;
+			this->packCB = nil;
+			this->uploadCB = nil;
 			this->renderCB = nil;
 			this->beginUpdate = nil;
 		}
@@ -201,7 +307,7 @@ namespace rw
 			return pipe;
 		}
 
-		void defaultInstanceCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance)
+		void defaultPackCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance)
 		{
 			AttribDesc* attribs, * a;
 
@@ -263,6 +369,14 @@ namespace rw
 					a++;
 				}
 
+				// Tangents, the layout is fixed so they are always there
+				a->index = ATTRIB_TANGENT;
+				a->size = 4;
+				a->type = GL_FLOAT;
+				a->offset = stride;
+				stride += 16;
+				a++;
+
 				header->numAttribs = a - tmpAttribs;
 				for (a = tmpAttribs; a != &tmpAttribs[header->numAttribs]; a++)
 					a->stride = stride;
@@ -278,7 +392,7 @@ namespace rw
 
 			attribs = header->attribDesc;
 
-			assert(attribs->stride == 48);
+			assert(attribs->stride == 64);
 
 			uint8* verts = header->vertexBuffer;
 
@@ -288,6 +402,7 @@ namespace rw
 				V3d normal;
 				V4d color;
 				V2d tex0;
+				V4d tangent;
 			};
 
 			// Positions
@@ -311,9 +426,9 @@ namespace rw
 					if (header->totalNumIndex > 0) {
 						auto vertexBuff = reinterpret_cast<Vertex*>(verts);
 						for (uint32_t i = 0; i < header->totalNumIndex; i += 3) {
-							const auto a = header->indexBuffer[i];
-							const auto b = header->indexBuffer[i + 1];
-							const auto c = header->indexBuffer[i + 2];
+							const uint32 a = header->indexBuffer32 ? header->indexBuffer32[i] : header->indexBuffer[i];
+							const uint32 b = header->indexBuffer32 ? header->indexBuffer32[i + 1] : header->indexBuffer[i + 1];
+							const uint32 c = header->indexBuffer32 ? header->indexBuffer32[i + 2] : header->indexBuffer[i + 2];
 							const auto normal = rw::cross(rw::sub(vertexBuff[b].pos, vertexBuff[a].pos),
 								rw::sub(vertexBuff[c].pos, vertexBuff[a].pos));
 							vertexBuff[a].normal = rw::add(vertexBuff[a].normal, normal);
@@ -365,6 +480,23 @@ namespace rw
 				}
 			}
 
+			// Tangents, zero when there are none so bump mapping does nothing
+			if (!reinstance || geo->lockedSinceInst & Geometry::LOCKNORMALS)
+			{
+				for (a = attribs; a->index != ATTRIB_TANGENT; a++)
+					;
+				Tangents* tangents = Tangents::get(geo);
+				if (tangents)
+					instV4d(VERT_FLOAT4, verts + a->offset, tangents->tangents, header->totalNumVertex, a->stride);
+				else
+					for (uint32_t i = 0; i < header->totalNumVertex; ++i)
+						memset(verts + a->offset + i * a->stride, 0, sizeof(V4d));
+			}
+		}
+
+		void defaultUploadCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance)
+		{
+			AttribDesc* attribs = header->attribDesc;
 			if (!reinstance)
 			{
 				header->vertexBufferGPU = maple::VertexBuffer::createRaw(header->vertexBuffer, header->totalNumVertex * attribs[0].stride);
@@ -386,8 +518,6 @@ namespace rw
 					inst++;
 				}
 
-				auto header = (InstanceDataHeader*)geo->instData;
-
 				header->blasId = createBottomLevel(header->vertexBufferGPU, header->indexBufferGPU, attribs[0].stride, subMeshes, rw::tlas::getBatchTask());
 			}
 			else
@@ -397,6 +527,12 @@ namespace rw
 #endif
 		}
 
+		void defaultInstanceCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance)
+		{
+			defaultPackCB(geo, header, reinstance);
+			defaultUploadCB(geo, header, reinstance);
+		}
+
 		void defaultUninstanceCB(Geometry* geo, InstanceDataHeader* header)
 		{
 			assert(0 && "can't uninstance");
@@ -407,6 +543,8 @@ namespace rw
 			ObjPipeline* pipe = ObjPipeline::create();
 			pipe->instanceCB = defaultInstanceCB;
 			pipe->uninstanceCB = defaultUninstanceCB;
+			pipe->packCB = defaultPackCB;
+			pipe->uploadCB = defaultUploadCB;
 			pipe->renderCB = defaultRenderCB;
 			pipe->beginUpdate = defaultUpdateCB;
 			return pipe;
@@ -42,8 +42,6 @@ namespace rw
 {
 	namespace vulkan
 	{
-#define MAX_LIGHTS
-
 		static maple::Pipeline::Ptr currentPipeline = nullptr;
 
 		void setPipeline(std::shared_ptr<maple::Pipeline> pipeline)
@@ -135,7 +133,7 @@ namespace rw
 				inst->material->surfaceProps,
 				inst->material->bindlessId >= getTextures().size() ? -1 : inst->material->bindlessId,
 				instanceId,
-				inst->offset,
+				header->indexBuffer32 ? inst->offset | INDEX32_OFFSET : inst->offset,
 				objectId
 			);
 
@@ -210,10 +208,10 @@ namespace rw
 		{
 			PROFILE_FUNCTION();
 			WorldLights lightData{};
-			std::vector<LightData> lights;
+			LightData lights[MAX_LIGHTS];
 			memset(&lightData, 0, sizeof(lightData));
-			lights = lighting::enumerateLights(atomic, lightData);
-			return setLights(&lightData, lights);
+			int32 numLights = lighting::enumerateLights(atomic, lightData, lights, MAX_LIGHTS);
+			return setLights(&lightData, lights, numLights);
 		}
 
 		int32 lightingCB(void)
@@ -228,7 +226,7 @@ namespace rw
 			lightData.numLocals = 8;
 
 			((World*)engine->currentWorld)->enumerateLights(&lightData);
-			return setLights(&lightData, {});
+			return setLights(&lightData, nullptr, 0);
 		}
 
 		void defaultUpdateCB(Atomic* atomic, InstanceDataHeader* header)
@@ -59,7 +59,7 @@ namespace rw
 			}
 		}
 
-		void skinInstanceCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance)
+		void skinPackCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance)
 		{
 			AttribDesc* attribs, * a;
 
@@ -183,9 +183,9 @@ namespace rw
 					if (header->totalNumIndex > 0) {
 						auto vertexBuff = reinterpret_cast<Vertex*>(verts);
 						for (uint32_t i = 0; i < header->totalNumIndex; i += 3) {
-							const auto a = header->indexBuffer[i];
-							const auto b = header->indexBuffer[i + 1];
-							const auto c = header->indexBuffer[i + 2];
+							const uint32 a = header->indexBuffer32 ? header->indexBuffer32[i] : header->indexBuffer[i];
+							const uint32 b = header->indexBuffer32 ? header->indexBuffer32[i + 1] : header->indexBuffer[i + 1];
+							const uint32 c = header->indexBuffer32 ? header->indexBuffer32[i + 2] : header->indexBuffer[i + 2];
 							const auto normal = rw::cross(rw::sub(vertexBuff[b].pos, vertexBuff[a].pos),
 								rw::sub(vertexBuff[c].pos, vertexBuff[a].pos));
 							vertexBuff[a].normal = rw::add(vertexBuff[a].normal, normal);
@@ -244,10 +244,19 @@ namespace rw
 			}
 
 			MAPLE_ASSERT(attribs[0].stride == sizeof(Vertex), "Issue ...here");
+		}
 
+		void skinUploadCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance)
+		{
 			header->vertexBufferGPU = maple::VertexBuffer::createRaw(
 				header->vertexBuffer,
-				header->totalNumVertex * attribs[0].stride);
+				header->totalNumVertex * header->attribDesc[0].stride);
+		}
+
+		void skinInstanceCB(Geometry* geo, InstanceDataHeader* header, bool32 reinstance)
+		{
+			skinPackCB(geo, header, reinstance);
+			skinUploadCB(geo, header, reinstance);
 		}
 
 		void skinUninstanceCB(Geometry* geo, InstanceDataHeader* header)
@@ -407,6 +416,8 @@ namespace rw
 			ObjPipeline* pipe = ObjPipeline::create();
 			pipe->instanceCB = skinInstanceCB;
 			pipe->uninstanceCB = skinUninstanceCB;
+			pipe->packCB = skinPackCB;
+			pipe->uploadCB = skinUploadCB;
 			pipe->renderCB = skinRenderCB;
 			pipe->beginUpdate = skinUpdateCB;
 			pipe->pluginID = ID_SKIN;
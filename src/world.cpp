@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <math.h>
+#include <float.h>
 
 #include "rwbase.h"
 #include "rwerror.h"
@@ -18,9 +20,17 @@ int32 World::numAllocated = 0;
 
 PluginList World::s_plglist(sizeof(World));
 
+static void
+initSector(WorldSector *sector)
+{
+	sector->atomics.init();
+	sector->lights.init();
+}
+
 World*
-World::create(BBox *bbox)
+World::create(BBox *bbox, float32 sectorSize)
 {
+	int32 i;
 	World *world = (World*)rwMalloc(s_plglist.size, MEMDUR_EVENT | ID_WORLD);
 	if(world == nil){
 		RWERROR((ERR_ALLOC, s_plglist.size));
@@ -31,6 +41,56 @@ World::create(BBox *bbox)
 	world->localLights.init();
 	world->globalLights.init();
 	world->clumps.init();
+
+	// without a box everything ends up in the outside sector
+	world->numSectors[0] = world->numSectors[1] = world->numSectors[2] = 0;
+	world->sectors = nil;
+	world->invSectorSize.set(0.0f, 0.0f, 0.0f);
+	if(bbox){
+		world->boundingBox = *bbox;
+		V3d size = sub(bbox->sup, bbox->inf);
+		if(sectorSize <= 0.0f){
+			sectorSize = size.x > size.y ? size.x : size.y;
+			sectorSize = size.z > sectorSize ? size.z : sectorSize;
+			sectorSize /= 16.0f;
+		}
+		float32 *sz = &size.x;
+		float32 *inv = &world->invSectorSize.x;
+		for(i = 0; i < 3; i++){
+			int32 n = sectorSize > 0.0f ? (int32)ceilf(sz[i]/sectorSize) : 1;
+			n = n < 1 ? 1 : n > MAXSECTORSPERAXIS ? MAXSECTORSPERAXIS : n;
+			world->numSectors[i] = n;
+			inv[i] = sz[i] > 0.0f ? n/sz[i] : 0.0f;
+		}
+		int32 n = world->getNumSectors();
+		world->sectors = rwNewT(WorldSector, n, MEMDUR_EVENT | ID_WORLD);
+		int32 x, y, z;
+		WorldSector *sector = world->sectors;
+		for(z = 0; z < world->numSectors[2]; z++)
+		for(y = 0; y < world->numSectors[1]; y++)
+		for(x = 0; x < world->numSectors[0]; x++){
+			initSector(sector);
+			V3d lo = { (float32)x/world->numSectors[0], (float32)y/world->numSectors[1], (float32)z/world->numSectors[2] };
+			V3d hi = { (float32)(x+1)/world->numSectors[0], (float32)(y+1)/world->numSectors[1], (float32)(z+1)/world->numSectors[2] };
+			sector->box.inf = add(bbox->inf, makeV3d(lo.x*size.x, lo.y*size.y, lo.z*size.z));
+			sector->box.sup = add(bbox->inf, makeV3d(hi.x*size.x, hi.y*size.y, hi.z*size.z));
+			sector++;
+		}
+	}else{
+		world->boundingBox.inf.set(0.0f, 0.0f, 0.0f);
+		world->boundingBox.sup.set(0.0f, 0.0f, 0.0f);
+	}
+	initSector(&world->outsideSector);
+	world->outsideSector.box.inf.set(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	world->outsideSector.box.sup.set(FLT_MAX, FLT_MAX, FLT_MAX);
+	world->atomicSerial = 0;
+	world->lightSerial = 0;
+	world->freeTies = nil;
+	world->bvh.init();
+	world->lightGrid = nil;
+	world->occlusion = nil;
+	world->renderQueue = nil;
+
 	s_plglist.construct(world);
 	return world;
 }
@@ -39,10 +99,133 @@ void
 World::destroy(void)
 {
 	s_plglist.destruct(this);
+	SectorTie *t, *next;
+	for(t = this->freeTies; t; t = next){
+		next = t->next;
+		rwFree(t);
+	}
+	rwFree(this->sectors);
+	this->bvh.deinit();
 	rwFree(this);
 	numAllocated--;
 }
 
+//
+// Sectors
+//
+
+static void
+removeTies(World *world, SectorTie **ties)
+{
+	SectorTie *t, *next;
+	for(t = *ties; t; t = next){
+		next = t->next;
+		t->inSector.remove();
+		t->next = world->freeTies;
+		world->freeTies = t;
+	}
+	*ties = nil;
+}
+
+static void
+addTie(World *world, SectorTie **ties, void *object, WorldSector *sector, LinkList *list)
+{
+	SectorTie *t = world->freeTies;
+	if(t)
+		world->freeTies = t->next;
+	else
+		t = rwNewT(SectorTie, 1, MEMDUR_EVENT | ID_WORLD);
+	t->object = object;
+	t->sector = sector;
+	t->next = *ties;
+	*ties = t;
+	list->add(&t->inSector);
+}
+
+// Range of sectors a box overlaps, clamped to the grid.
+// Returns whether the box lies completely within the grid.
+static bool32
+sectorRange(World *world, BBox *box, int32 *lo, int32 *hi)
+{
+	float32 *inf = &box->inf.x;
+	float32 *sup = &box->sup.x;
+	float32 *winf = &world->boundingBox.inf.x;
+	float32 *wsup = &world->boundingBox.sup.x;
+	float32 *inv = &world->invSectorSize.x;
+	bool32 inside = world->sectors != nil;
+	for(int32 i = 0; i < 3; i++){
+		int32 n = world->numSectors[i];
+		if(inf[i] < winf[i] || sup[i] > wsup[i])
+			inside = 0;
+		int32 l = (int32)floorf((inf[i] - winf[i])*inv[i]);
+		int32 h = (int32)floorf((sup[i] - winf[i])*inv[i]);
+		lo[i] = l < 0 ? 0 : l >= n ? n-1 : l;
+		hi[i] = h < 0 ? 0 : h >= n ? n-1 : h;
+	}
+	return inside;
+}
+
+static WorldSector*
+getSector(World *world, int32 x, int32 y, int32 z)
+{
+	return &world->sectors[(z*world->numSectors[1] + y)*world->numSectors[0] + x];
+}
+
+// Link object into all sectors that box overlaps
+static void
+linkSectors(World *world, SectorTie **ties, void *object, BBox *box, bool32 lights)
+{
+	int32 lo[3], hi[3];
+	int32 x, y, z;
+	bool32 inside = sectorRange(world, box, lo, hi);
+	int32 n = (hi[0]-lo[0]+1)*(hi[1]-lo[1]+1)*(hi[2]-lo[2]+1);
+	if(!inside || n > World::MAXTIES){
+		WorldSector *s = &world->outsideSector;
+		addTie(world, ties, object, s, lights ? &s->lights : &s->atomics);
+		return;
+	}
+	for(z = lo[2]; z <= hi[2]; z++)
+	for(y = lo[1]; y <= hi[1]; y++)
+	for(x = lo[0]; x <= hi[0]; x++){
+		WorldSector *s = getSector(world, x, y, z);
+		addTie(world, ties, object, s, lights ? &s->lights : &s->atomics);
+	}
+}
+
+void
+World::updateAtomic(Atomic *atomic)
+{
+	assert(atomic->world == this);
+	removeTies(this, &atomic->ties);
+	if(atomic->getFrame() == nil){
+		if(atomic->bvhLeaf >= 0)
+			this->bvh.remove(atomic->bvhLeaf);
+		atomic->bvhLeaf = -1;
+		return;
+	}
+	BBox *box = atomic->getWorldBoundingBox();
+	linkSectors(this, &atomic->ties, atomic, box, 0);
+	if(atomic->bvhLeaf < 0)
+		atomic->bvhLeaf = this->bvh.insert(box, atomic);
+	else
+		this->bvh.move(atomic->bvhLeaf, box);
+}
+
+void
+World::updateLight(Light *light)
+{
+	assert(light->world == this);
+	removeTies(this, &light->ties);
+	if(light->getFrame() == nil)
+		return;
+	BBox box;
+	V3d pos = light->getFrame()->getLTM()->pos;
+	V3d r = { light->radius, light->radius, light->radius };
+	box.inf = sub(pos, r);
+	box.sup = add(pos, r);
+	linkSectors(this, &light->ties, light, &box, 1);
+}
+
 void
 World::addLight(Light *light)
 {
@@ -52,6 +235,7 @@ World::addLight(Light *light)
 		this->globalLights.append(&light->inWorld);
 	}else{
 		this->localLights.append(&light->inWorld);
+		this->updateLight(light);
 		if(light->getFrame())
 			light->getFrame()->updateObjects();
 	}
@@ -60,8 +244,12 @@ World::addLight(Light *light)
 void 
 World::removeLights()
 {
+	FORLIST(lnk, this->localLights)
+		removeTies(this, &Light::fromWorld(lnk)->ties);
 	this->globalLights.init();
 	this->localLights.init();
+	if(this->lightGrid)
+		this->lightGrid->camera = nil;
 }
 
 void
@@ -69,7 +257,11 @@ World::removeLight(Light *light)
 {
 	assert(light->world == this);
 	light->inWorld.remove();
+	removeTies(this, &light->ties);
 	light->world = nil;
+	// may reference the light, unused until rebuilt
+	if(this->lightGrid)
+		this->lightGrid->camera = nil;
 }
 
 void
@@ -93,6 +285,7 @@ World::addAtomic(Atomic *atomic)
 {
 	assert(atomic->world == nil);
 	atomic->world = this;
+	this->updateAtomic(atomic);
 	if(atomic->getFrame())
 		atomic->getFrame()->updateObjects();
 }
@@ -101,6 +294,10 @@ void
 World::removeAtomic(Atomic *atomic)
 {
 	assert(atomic->world == this);
+	removeTies(this, &atomic->ties);
+	if(atomic->bvhLeaf >= 0)
+		this->bvh.remove(atomic->bvhLeaf);
+	atomic->bvhLeaf = -1;
 	atomic->world = nil;
 }
 
@@ -137,15 +334,291 @@ World::removeClump(Clump *clump)
 	clump->world = nil;
 }
 
+enum { CULLBATCH = 64 };
+
+struct RenderBatch
+{
+	Camera *cam;
+	OcclusionBuffer *occlusion;	// nil if not used
+	RenderQueue *queue;	// nil to render immediately
+	int32 n;
+	Atomic *atomics[CULLBATCH];
+	Sphere spheres[CULLBATCH];
+};
+
+// Occluders are not tested, they would be hidden by themselves
+static void
+renderAtomic(Atomic *a, RenderBatch *b)
+{
+	if(b->occlusion && !(a->object.object.flags & Atomic::OCCLUDER) &&
+	   b->occlusion->isAtomicOccluded(a)){
+		cullStats.numOccluded++;
+		return;
+	}
+	if(b->queue)
+		b->queue->addAtomic(a);
+	else
+		a->render();
+}
+
+static void
+flushBatch(RenderBatch *b)
+{
+	uint8 visible[CULLBATCH];
+	int32 numVisible = b->cam->frustumTestSpheres(b->spheres, b->n, visible);
+	cullStats.numTested += b->n;
+	cullStats.numCulled += b->n - numVisible;
+	for(int32 i = 0; i < b->n; i++)
+		if(visible[i])
+			renderAtomic(b->atomics[i], b);
+	b->n = 0;
+}
+
+// Render atomics of a sector not rendered yet,
+// only test them against the frustum if the sector is not fully inside
+static void
+renderSector(World *world, WorldSector *sector, RenderBatch *b, bool32 test)
+{
+	FORLIST(lnk, sector->atomics){
+		Atomic *a = (Atomic*)SectorTie::fromSector(lnk)->object;
+		if(a->worldSerial == world->atomicSerial ||
+		   !(a->object.object.flags & Atomic::RENDER))
+			continue;
+		a->worldSerial = world->atomicSerial;
+		if(!test){
+			renderAtomic(a, b);
+			continue;
+		}
+		b->atomics[b->n] = a;
+		b->spheres[b->n] = *a->getWorldBoundingSphere();
+		if(++b->n == CULLBATCH)
+			flushBatch(b);
+	}
+}
+
+static Atomic*
+renderVisibleCB(Atomic *a, void *data)
+{
+	if(a->object.object.flags & Atomic::RENDER)
+		renderAtomic(a, (RenderBatch*)data);
+	return a;
+}
+
+static Atomic*
+drawOccluderCB(Atomic *a, void *data)
+{
+	if(a->object.object.flags & Atomic::OCCLUDER){
+		((OcclusionBuffer*)data)->drawAtomic(a);
+		cullStats.numOccluders++;
+	}
+	return a;
+}
+
 void
 World::render(void)
 {
-	// this is very wrong, we really want world sectors
-	FORLIST(lnk, this->clumps)
-		Clump::fromWorld(lnk)->render();
+	int32 x, y, z;
+	int32 lo[3], hi[3];
+	RenderBatch b;
+	b.cam = engine->currentCamera;
+	b.occlusion = nil;
+	b.queue = this->renderQueue;
+	b.n = 0;
+	bool32 cull = Clump::getFrustumCulling() && b.cam;
+
+	if(this->occlusion && cull){
+		this->occlusion->begin(b.cam);
+		if(this->occlusion->camera){
+			this->forAllAtomicsInFrustum(b.cam, drawOccluderCB, this->occlusion);
+			this->occlusion->end();
+			b.occlusion = this->occlusion;
+		}
+	}
+
+	if(b.queue)
+		b.queue->begin(b.cam);
+	// everything is in the outside sector, the BVH is better at that
+	if(this->sectors == nil && cull){
+		this->forAllAtomicsInFrustum(b.cam, renderVisibleCB, &b);
+		if(b.queue)
+			b.queue->end();
+		return;
+	}
+
+	this->atomicSerial++;
+	if(this->sectors){
+		if(cull)
+			sectorRange(this, &b.cam->frustumBoundBox, lo, hi);
+		else{
+			lo[0] = lo[1] = lo[2] = 0;
+			hi[0] = this->numSectors[0]-1;
+			hi[1] = this->numSectors[1]-1;
+			hi[2] = this->numSectors[2]-1;
+		}
+		for(z = lo[2]; z <= hi[2]; z++)
+		for(y = lo[1]; y <= hi[1]; y++)
+		for(x = lo[0]; x <= hi[0]; x++){
+			WorldSector *s = getSector(this, x, y, z);
+			if(s->atomics.isEmpty())
+				continue;
+			int32 res = Camera::BOXINSIDE;
+			if(cull){
+				res = b.cam->frustumTestBox(&s->box);
+				cullStats.numSectorsTested++;
+				if(res == Camera::BOXOUTSIDE){
+					cullStats.numSectorsCulled++;
+					continue;
+				}
+			}
+			renderSector(this, s, &b, res != Camera::BOXINSIDE);
+		}
+	}
+	renderSector(this, &this->outsideSector, &b, cull);
+	if(b.n)
+		flushBatch(&b);
+	if(b.queue)
+		b.queue->end();
+}
+
+MultiView*
+MultiView::create(World *world)
+{
+	MultiView *mv = rwNewT(MultiView, 1, MEMDUR_EVENT | ID_WORLD);
+	mv->world = world;
+	mv->numViews = 0;
+	for(int32 i = 0; i < MAXVIEWS; i++){
+		mv->views[i].camera = nil;
+		mv->views[i].numAtomics = 0;
+		mv->views[i].maxAtomics = 0;
+		mv->views[i].atomics = nil;
+	}
+	return mv;
+}
+
+void
+MultiView::destroy(void)
+{
+	for(int32 i = 0; i < MAXVIEWS; i++)
+		rwFree(this->views[i].atomics);
+	rwFree(this);
+}
+
+int32
+MultiView::addCamera(Camera *cam)
+{
+	if(this->numViews == MAXVIEWS)
+		return -1;
+	View *v = &this->views[this->numViews];
+	v->camera = cam;
+	v->numAtomics = 0;
+	return this->numViews++;
+}
+
+void
+MultiView::removeCameras(void)
+{
+	this->numViews = 0;
+}
+
+static Atomic*
+addToViewsCB(Atomic *a, uint32 views, void *data)
+{
+	MultiView *mv = (MultiView*)data;
+	if(!(a->object.object.flags & (Atomic::RENDER | Atomic::OCCLUDER)))
+		return a;
+	for(int32 i = 0; i < mv->numViews; i++){
+		if(!(views & (1u<<i)))
+			continue;
+		MultiView::View *v = &mv->views[i];
+		if(v->numAtomics == v->maxAtomics){
+			v->maxAtomics = v->maxAtomics ? v->maxAtomics*2 : 64;
+			v->atomics = rwResizeT(Atomic*, v->atomics, v->maxAtomics, MEMDUR_EVENT | ID_WORLD);
+		}
+		v->atomics[v->numAtomics++] = a;
+	}
+	return a;
+}
+
+// Cameras sync their frustums in the frame sync,
+// after this beginUpdate has nothing left to sync.
+void
+MultiView::update(void)
+{
+	int32 i;
+	Camera *cams[MAXVIEWS];
+	Frame::syncDirty();
+	for(i = 0; i < this->numViews; i++){
+		this->views[i].numAtomics = 0;
+		cams[i] = this->views[i].camera;
+	}
+	this->world->forAllAtomicsInFrustums(cams, this->numViews, addToViewsCB, this);
+}
+
+void
+MultiView::render(int32 view)
+{
+	int32 i;
+	View *v = &this->views[view];
+	RenderBatch b;
+	b.cam = v->camera;
+	b.occlusion = nil;
+	b.queue = this->world->renderQueue;
+	b.n = 0;
+
+	OcclusionBuffer *occ = this->world->occlusion;
+	if(occ){
+		occ->begin(b.cam);
+		if(occ->camera){
+			for(i = 0; i < v->numAtomics; i++)
+				drawOccluderCB(v->atomics[i], occ);
+			occ->end();
+			b.occlusion = occ;
+		}
+	}
+
+	if(b.queue)
+		b.queue->begin(b.cam);
+	for(i = 0; i < v->numAtomics; i++)
+		renderVisibleCB(v->atomics[i], &b);
+	if(b.queue)
+		b.queue->end();
 }
 
 // Find lights that illuminate an atomic
+static float32
+boxDistanceSquared(BBox *box, V3d *p)
+{
+	float32 d, dist = 0.0f;
+	if(p->x < box->inf.x){ d = box->inf.x - p->x; dist += d*d; }
+	else if(p->x > box->sup.x){ d = p->x - box->sup.x; dist += d*d; }
+	if(p->y < box->inf.y){ d = box->inf.y - p->y; dist += d*d; }
+	else if(p->y > box->sup.y){ d = p->y - box->sup.y; dist += d*d; }
+	if(p->z < box->inf.z){ d = box->inf.z - p->z; dist += d*d; }
+	else if(p->z > box->sup.z){ d = p->z - box->sup.z; dist += d*d; }
+	return dist;
+}
+
+// Returns 0 when there is no more room
+static bool32
+addLocalLight(Atomic *atomic, Light *l, WorldLights *lightData, int32 maxLocals)
+{
+	if(lightData->numLocals >= maxLocals)
+		return 0;
+	if((l->getFlags() & Light::LIGHTATOMICS) == 0)
+		return 1;
+
+	// check if spheres are intersecting
+	Sphere *atomsphere = atomic->getWorldBoundingSphere();
+	V3d lightpos = l->getFrame()->getLTM()->pos;
+	V3d dist = sub(lightpos, atomsphere->center);
+	if(length(dist) >= atomsphere->radius + l->radius)
+		return 1;
+	// then the light sphere against the box
+	if(boxDistanceSquared(atomic->getWorldBoundingBox(), &lightpos) < l->radius*l->radius)
+		lightData->locals[lightData->numLocals++] = l;
+	return 1;
+}
+
 void
 World::enumerateLights(Atomic *atomic, WorldLights *lightData)
 {
@@ -185,20 +658,49 @@ World::enumerateLights(Atomic *atomic, WorldLights *lightData)
 	if(!normals)
 		return;
 
-	// TODO: for this we would use an atomic's world sectors, but we don't have those yet
-	FORLIST(lnk, this->localLights){
-		if(lightData->numLocals >= maxLocals)
-			return;
-
-		Light *l = Light::fromWorld(lnk);
-		if((l->getFlags() & Light::LIGHTATOMICS) == 0)
-			continue;
+	// the grid has all lights that touch the view, enough when the atomic is in view
+	LightGrid *grid = this->lightGrid;
+	int32 lo[3], hi[3];
+	if(grid && grid->camera == engine->currentCamera &&
+	   grid->getClusterRange(atomic->getWorldBoundingSphere(), lo, hi)){
+		this->lightSerial++;
+		for(int32 z = lo[2]; z <= hi[2]; z++)
+		for(int32 y = lo[1]; y <= hi[1]; y++){
+			int32 c = grid->getCluster(lo[0], y, z);
+			int32 end = grid->clusterOffsets[grid->getCluster(hi[0], y, z)+1];
+			for(int32 i = grid->clusterOffsets[c]; i < end; i++){
+				Light *l = grid->lights[grid->lightIndices[i]];
+				if(l->worldSerial == this->lightSerial)
+					continue;
+				l->worldSerial = this->lightSerial;
+				if(!addLocalLight(atomic, l, lightData, maxLocals))
+					return;
+			}
+		}
+		return;
+	}
 
-		// check if spheres are intersecting
-		Sphere *atomsphere = atomic->getWorldBoundingSphere();
-		V3d dist = sub(l->getFrame()->getLTM()->pos, atomsphere->center);
-		if(length(dist) < atomsphere->radius + l->radius)
-			lightData->locals[lightData->numLocals++] = l;
+	// only lights in the atomic's sectors and the outside sector can touch it,
+	// an atomic in the outside sector has to check all of them
+	if(atomic->ties == nil || atomic->ties->sector == &this->outsideSector){
+		FORLIST(lnk, this->localLights)
+			if(!addLocalLight(atomic, Light::fromWorld(lnk), lightData, maxLocals))
+				return;
+		return;
+	}
+	this->lightSerial++;
+	SectorTie outside;
+	outside.sector = &this->outsideSector;
+	outside.next = atomic->ties;
+	for(SectorTie *t = &outside; t; t = t->next){
+		FORLIST(lnk, t->sector->lights){
+			Light *l = (Light*)SectorTie::fromSector(lnk)->object;
+			if(l->worldSerial == this->lightSerial)
+				continue;
+			l->worldSerial = this->lightSerial;
+			if(!addLocalLight(atomic, l, lightData, maxLocals))
+				return;
+		}
 	}
 }
 
@@ -234,11 +234,12 @@ Render(float timeDelta)
 {
 	Camera->clear(&BorderColor, rw::Camera::CLEARIMAGE|rw::Camera::CLEARZ);
 
+	SubViews->update();
 	for(int i = 0; i < 4; i++){
 		SubCameras[i]->clear(&BackgroundColor, rw::Camera::CLEARIMAGE|rw::Camera::CLEARZ);
 //		SubCameras[i]->clear(&BackgroundColors[i], rw::Camera::CLEARIMAGE|rw::Camera::CLEARZ);
 		SubCameras[i]->beginUpdate();
-		World->render();
+		SubViews->render(i);
 		SubCameras[i]->endUpdate();
 	}
 
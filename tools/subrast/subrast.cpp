@@ -5,6 +5,7 @@
 
 rw::Camera *Camera;
 rw::Camera *SubCameras[4];
+rw::MultiView *SubViews;
 
 void
 CameraSetViewWindow(rw::Camera *camera, float width, float height, float vw)
@@ -121,12 +122,22 @@ CreateCameras(rw::World *world)
 			SubCameras[i]->setProjection(rw::Camera::PARALLEL);
 	}
 
+	// all sub cameras share one visibility pass
+	SubViews = rw::MultiView::create(world);
+	for(int i = 0; i < 4; i++)
+		SubViews->addCamera(SubCameras[i]);
+
 	PositionSubCameras();
 }
 
 void
 DestroyCameras(rw::World *world)
 {
+	if(SubViews){
+		SubViews->destroy();
+		SubViews = nil;
+	}
+
 	if(Camera){
 		sk::CameraDestroy(Camera);
 		Camera = nil;
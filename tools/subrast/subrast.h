@@ -1,5 +1,6 @@
 extern rw::Camera *Camera;
 extern rw::Camera *SubCameras[4];
+extern rw::MultiView *SubViews;
 
 void CreateCameras(rw::World *world);
 void DestroyCameras(rw::World *world);